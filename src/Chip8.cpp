@@ -1,51 +1,755 @@
 #include "Chip8.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include "constants/Constants.h"
 #include "exceptions/IOException.h"
-#include "io/FileByteReader.h"
+#include "exceptions/IndexOutOfBoundsException.h"
+#include "exceptions/InitializationException.h"
+#include "io/MappedFile.h"
+#include "io/RomFile.h"
+#include "utils/HashUtil.h"
+#include "utils/RandomUtil.h"
+#include "utils/FutexUtil.h"
+#include "utils/PhaseTracer.h"
 #include "utils/SleepUtil.h"
 
 namespace Chip8 {
 // needed for static class definition of this array to compile
 constexpr unsigned char Chip8Emulator::DEFAULT_FONT_SET[FONTSET_BUFFER_SIZE];
+constexpr unsigned char Chip8Emulator::BIG_FONT_SET[BIG_FONTSET_BUFFER_SIZE];
 
 void Chip8Emulator::beginEmulation() {
-    // TODO: consider starting this in a separate thread so that the emulator can be stopped if desired
-    isEmulating = true;
-    while (isEmulating) {
-        subsystemManager.getInputController().checkForKeyPresses();
-        // TODO: change delay to actual processor clock rate
-        SleepUtil::sleepMillis(1);
+    startEmulationThread();
+    IInputController &inputController = subsystemManager.getInputController();
+    IDisplay &display = subsystemManager.getDisplay();
+    uint16_t pressedKeys = 0;
+    uint32_t numRunAheadFramesWhenOn = DEFAULT_RUN_AHEAD_FRAMES;
+    uint32_t turboMultiplierWhenOn = DEFAULT_TURBO_MULTIPLIER;
+    bool isShowingMetricsOverlay = false;
+    // the time of the first key change that no presented frame has come after yet, or 0 if there is none
+    uint64_t firstUnpresentedKeyChangeNanos = 0;
+    uint64_t lastMetricsUpdateNanos = toHostTimeNanos(std::chrono::steady_clock::now());
+    uint64_t numCyclesAtLastMetricsUpdate = getNumCyclesExecuted();
+    // this thread is the UI thread: it handles input, and shows the frames the emulation thread hands over
+    PhaseTracer::setThreadName("ui");
+    while (getEmulationStatus() != EmulationStatus::STOPPED) {
+        {
+            ScopedPhase phase("input poll");
+            inputController.checkForKeyPresses();
+            if (inputController.isExitButtonPressed()) {
+                stopEmulation();
+            }
+            if (inputController.wasHotkeyPressed(Hotkey::TOGGLE_RUN_AHEAD)) {
+                uint32_t currentRunAheadFrames = getRunAheadFrames();
+                if (currentRunAheadFrames > 0) {
+                    numRunAheadFramesWhenOn = currentRunAheadFrames;
+                }
+                setRunAheadFrames(currentRunAheadFrames > 0 ? 0 : numRunAheadFramesWhenOn);
+            }
+            if (inputController.wasHotkeyPressed(Hotkey::TOGGLE_INSTRUCTION_TRACE)) {
+                setInstructionTracing(!isInstructionTracing());
+            }
+            if (inputController.wasHotkeyPressed(Hotkey::TOGGLE_TURBO)) {
+                uint32_t currentTurboMultiplier = getTurboMultiplier();
+                if (currentTurboMultiplier != TURBO_OFF) {
+                    turboMultiplierWhenOn = currentTurboMultiplier;
+                }
+                setTurbo(currentTurboMultiplier != TURBO_OFF ? TURBO_OFF : turboMultiplierWhenOn);
+            }
+            if (inputController.wasHotkeyPressed(Hotkey::TOGGLE_METRICS_OVERLAY)) {
+                isShowingMetricsOverlay = !isShowingMetricsOverlay;
+                display.setOverlayText(isShowingMetricsOverlay ? getMetricsOverlayLines() : std::vector<std::string>());
+            }
+            // key changes are stamped as soon as they are seen, so the emulation thread can apply them at the matching cycle
+            uint16_t newPressedKeys = inputController.getPressedKeys();
+            uint16_t changedKeys = pressedKeys ^ newPressedKeys;
+            uint64_t now = toHostTimeNanos(std::chrono::steady_clock::now());
+            for (uint8_t keyNumber = 0; keyNumber < IInputController::NUM_KEYS; keyNumber++) {
+                if (((changedKeys >> keyNumber) & 1) && queueKeyEvent({now, keyNumber, (bool)((newPressedKeys >> keyNumber) & 1)})) {
+                    pressedKeys ^= (uint16_t)(1 << keyNumber);
+                    firstUnpresentedKeyChangeNanos = firstUnpresentedKeyChangeNanos == 0 ? now : firstUnpresentedKeyChangeNanos;
+                }
+            }
+        }
+        {
+            ScopedPhase phase("present");
+            uint64_t presentStartNanos = toHostTimeNanos(std::chrono::steady_clock::now());
+            if (display.presentFrame()) {
+                uint64_t presentEndNanos = toHostTimeNanos(std::chrono::steady_clock::now());
+                presentDurationMetric.record(presentEndNanos - presentStartNanos);
+                if (firstUnpresentedKeyChangeNanos != 0) {
+                    inputToPresentLatencyMetric.record(presentEndNanos - firstUnpresentedKeyChangeNanos);
+                    firstUnpresentedKeyChangeNanos = 0;
+                }
+            }
+        }
+        uint64_t now = toHostTimeNanos(std::chrono::steady_clock::now());
+        if (now - lastMetricsUpdateNanos >= METRICS_UPDATE_MILLIS * 1000000ull) {
+            uint64_t numCycles = getNumCyclesExecuted();
+            instructionsPerSecondMetric.set((numCycles - numCyclesAtLastMetricsUpdate) * 1e9 / (now - lastMetricsUpdateNanos));
+            numCyclesAtLastMetricsUpdate = numCycles;
+            lastMetricsUpdateNanos = now;
+            if (isShowingMetricsOverlay) {
+                display.setOverlayText(getMetricsOverlayLines());
+            }
+            if (!metricsFilePath.empty()) {
+                metrics.writePrometheusFile(metricsFilePath);
+            }
+        }
+        sleepMillis(1);
+    }
+    waitForEmulationThread();
+    if (!metricsFilePath.empty()) {
+        metrics.writePrometheusFile(metricsFilePath);
+    }
+}
+
+void Chip8Emulator::startEmulationThread() {
+    if (emulationThread.joinable()) {
+        throw InitializationException("The emulation thread is already running");
+    }
+    status.store(EmulationStatus::RUNNING, std::memory_order_release);
+    emulationThread = std::thread(&Chip8Emulator::emulationLoop, this);
+}
+
+void Chip8Emulator::waitForEmulationThread() {
+    if (emulationThread.joinable()) {
+        emulationThread.join();
+    }
+    if (emulationThreadException != nullptr) {
+        std::exception_ptr exception = emulationThreadException;
+        emulationThreadException = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void Chip8Emulator::emulationLoop() {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point lastUpdateTime = Clock::now();
+    double numCyclesOwed = 0;
+    PhaseTracer::setThreadName("emulation");
+    try {
+        while (true) {
+            // read the count before popping, so a command that is queued after the queue is found empty ends the wait below
+            uint32_t numCommandsSeen = numCommandsSent.load(std::memory_order_acquire);
+            EmulationCommand command;
+            while (commands.tryPop(command)) {
+                handleCommand(command);
+            }
+
+            EmulationStatus currentStatus = status.load(std::memory_order_relaxed);
+            if (currentStatus == EmulationStatus::STOPPED) {
+                break;
+            }
+            uint32_t speed = currentStatus == EmulationStatus::PAUSED ? UNTHROTTLED : cyclesPerSecond.load(std::memory_order_relaxed);
+            uint32_t turboMultiplierNow = turboMultiplier.load(std::memory_order_relaxed);
+            bool isTurboOn = currentStatus == EmulationStatus::RUNNING && turboMultiplierNow != TURBO_OFF;
+            if (isTurboOn && speed != UNTHROTTLED) {
+                uint64_t turboSpeed = std::min((uint64_t)speed * turboMultiplierNow, (uint64_t)UINT32_MAX);
+                speed = turboMultiplierNow == UNTHROTTLED ? UNTHROTTLED : (uint32_t)turboSpeed;
+            }
+            // the screen updates skipped in turbo are never handed over, so the screen they ended with is handed over once turbo ends
+            if (wasTurboOn && !isTurboOn) {
+                subsystemManager.getDisplay().updateScreen();
+            }
+            wasTurboOn = isTurboOn;
+            scheduleQueuedKeyEvents(toHostTimeNanos(lastUpdateTime), speed);
+            if (currentStatus == EmulationStatus::PAUSED) {
+                if (numStepCyclesRemaining > 0) {
+                    uint32_t numCycles = emulateCycles(numStepCyclesRemaining, false);
+                    numStepCyclesRemaining -= numCycles;
+                    if (numCycles == 0) {
+                        // waiting for a key press
+                        sleepMillis(1);
+                    }
+                } else {
+                    ScopedPhase phase("wait for command");
+                    FutexUtil::waitWhileEqual(numCommandsSent, numCommandsSeen);
+                }
+                lastUpdateTime = Clock::now();
+                numCyclesOwed = 0;
+                lastTimedFrameNanos = 0;
+                continue;
+            }
+
+            if (speed == UNTHROTTLED) {
+                cpu.setPresentingScreenUpdates(!isTurboOn);
+                uint32_t numCycles = emulateCycles(NUM_UNTHROTTLED_CYCLES_PER_BATCH, true);
+                cpu.setPresentingScreenUpdates(true);
+                emulatedFrameTimeMetric.set(0);
+                timeFrames();
+                if (isTurboOn) {
+                    // turbo is muted rather than played in bits that are mostly dropped
+                    updateTurboScreen();
+                } else {
+                    // there's no way to play audio faster than real time, so most of this will be dropped
+                    queueAudio(numCycles, DEFAULT_CYCLES_PER_SECOND);
+                }
+                if (numCycles == 0) {
+                    sleepMillis(1);
+                }
+                continue;
+            }
+            Clock::time_point now = Clock::now();
+            numCyclesOwed += std::chrono::duration<double>(now - lastUpdateTime).count() * speed;
+            lastUpdateTime = now;
+            // never try to catch up on more than a frame's worth of time (ex: after the process was suspended)
+            numCyclesOwed = std::min(numCyclesOwed, speed / 60.0 + 1);
+            uint32_t numCycles = (uint32_t)numCyclesOwed;
+            // cycles that can't run because of a key wait are dropped rather than owed, like on the real hardware
+            numCyclesOwed -= numCycles;
+            uint32_t numRunAheadFramesNow = isTurboOn ? 0 : numRunAheadFrames.load(std::memory_order_relaxed);
+            // with run-ahead on, only the frames it runs ahead to are presented, and in turbo, only the ones updateTurboScreen() hands over
+            cpu.setPresentingScreenUpdates(numRunAheadFramesNow == 0 && !isTurboOn);
+            emulateCycles(numCycles, true);
+            emulatedFrameTimeMetric.set((double)CYCLES_PER_FRAME / speed);
+            timeFrames();
+            // the time passes whether or not the cycles could run, so the audio for it is queued either way
+            queueAudio(numCycles, speed);
+            uint64_t frameNumber = numCyclesExecuted.load(std::memory_order_relaxed) / CYCLES_PER_FRAME;
+            if (numRunAheadFramesNow > 0 && frameNumber != lastRunAheadFrameNumber) {
+                lastRunAheadFrameNumber = frameNumber;
+                runAhead(numRunAheadFramesNow);
+            }
+            if (isTurboOn) {
+                updateTurboScreen();
+            }
+            cpu.setPresentingScreenUpdates(true);
+            sleepMillis(1);
+        }
+    } catch (...) {
+        emulationThreadException = std::current_exception();
+    }
+    status.store(EmulationStatus::STOPPED, std::memory_order_release);
+}
+
+void Chip8Emulator::handleCommand(const EmulationCommand &command) {
+    switch (command.type) {
+        case EmulationCommand::Type::PAUSE:
+            status.store(EmulationStatus::PAUSED, std::memory_order_release);
+            break;
+        case EmulationCommand::Type::RESUME:
+            numStepCyclesRemaining = 0;
+            status.store(EmulationStatus::RUNNING, std::memory_order_release);
+            break;
+        case EmulationCommand::Type::STEP:
+            numStepCyclesRemaining += command.value;
+            status.store(EmulationStatus::PAUSED, std::memory_order_release);
+            break;
+        case EmulationCommand::Type::SET_SPEED:
+            cyclesPerSecond.store(command.value, std::memory_order_relaxed);
+            break;
+        case EmulationCommand::Type::SAVE_STATE:
+            saveStateSlots[command.value] = saveState();
+            isSaveStateSlotUsed[command.value] = true;
+            numStatesSaved.fetch_add(1, std::memory_order_release);
+            break;
+        case EmulationCommand::Type::LOAD_STATE:
+            if (isSaveStateSlotUsed[command.value]) {
+                loadState(saveStateSlots[command.value]);
+            }
+            break;
+        case EmulationCommand::Type::SET_RUN_AHEAD:
+            numRunAheadFrames.store(command.value, std::memory_order_relaxed);
+            break;
+        case EmulationCommand::Type::SET_TURBO:
+            turboMultiplier.store(command.value, std::memory_order_relaxed);
+            break;
+        case EmulationCommand::Type::STOP:
+            status.store(EmulationStatus::STOPPED, std::memory_order_release);
+            break;
+    }
+}
+
+uint64_t Chip8Emulator::toHostTimeNanos(std::chrono::steady_clock::time_point time) {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+void Chip8Emulator::scheduleQueuedKeyEvents(uint64_t batchStartNanos, uint32_t speed) {
+    uint64_t nextCycle = numCyclesExecuted.load(std::memory_order_relaxed);
+    TimedKeyEvent event;
+    while (keyEvents.tryPop(event)) {
+        uint64_t cycleNumber = nextCycle;
+        if (speed != UNTHROTTLED && event.hostTimeNanos > batchStartNanos) {
+            cycleNumber += (uint64_t)((event.hostTimeNanos - batchStartNanos) / 1e9 * speed);
+        }
+        cycleInputController.scheduleEvent({cycleNumber, event.keyNumber, event.isPressed});
+    }
+}
+
+void Chip8Emulator::scheduleKeyChanges(uint16_t oldPressedKeys, uint16_t newPressedKeys) {
+    uint64_t nextCycle = numCyclesExecuted.load(std::memory_order_relaxed);
+    uint16_t changedKeys = oldPressedKeys ^ newPressedKeys;
+    for (uint8_t keyNumber = 0; keyNumber < IInputController::NUM_KEYS; keyNumber++) {
+        if ((changedKeys >> keyNumber) & 1) {
+            cycleInputController.scheduleEvent({nextCycle, keyNumber, (bool)((newPressedKeys >> keyNumber) & 1)});
+        }
+    }
+}
+
+uint32_t Chip8Emulator::emulateCycles(uint32_t maxCycles, bool useRecompiledProgram) {
+    ScopedPhase phase("emulate batch");
+    uint64_t firstCycle = numCyclesExecuted.load(std::memory_order_relaxed);
+    bool isTracing = isTracingInstructions.load(std::memory_order_relaxed);
+    uint32_t numCycles = 0;
+    while (numCycles < maxCycles) {
+        cycleInputController.applyEventsUpTo(firstCycle + numCycles);
+        if (cpu.isNextInstructionWaitForKeyPress() && !isAnyKeyPressed()) {
+            if (cycleInputController.applyNextEvent()) {
+                continue;
+            }
+            break;
+        }
+        // recompiled blocks run most instructions without going through the cpu, so they would be missing from its coverage and the trace
+        bool isNoEventDue = cycleInputController.getNextEventCycle() >= firstCycle + maxCycles;
+        uint32_t numCyclesBefore = numCycles;
+        if (useRecompiledProgram && !Cpu::CoveragePolicy::IS_ENABLED && !isTracing && isNoEventDue) {
+            numCycles += emulateNextCycles();
+        } else if (isTracing) {
+            emulateTracedCycle(firstCycle + numCycles);
+            numCycles++;
+        } else {
+            cpu.emulateCycle();
+            numCycles++;
+        }
+        if (frameRecorder != nullptr) {
+            recordFrames(firstCycle + numCyclesBefore, firstCycle + numCycles);
+        }
+    }
+    numCyclesExecuted.fetch_add(numCycles, std::memory_order_relaxed);
+    cyclesMetric.increment(numCycles);
+    return numCycles;
+}
+
+void Chip8Emulator::emulateTracedCycle(uint64_t cycleNumber) {
+    CpuState stateBefore = cpu.getState();
+    uint16_t opcode = (uint16_t)(memory.getDataAtAddress(stateBefore.programCounter) << Constants::BITS_IN_BYTE |
+                                 memory.getDataAtAddress(stateBefore.programCounter + 1));
+    TraceRecord record = {cycleNumber, stateBefore.programCounter, opcode, stateBefore.indexRegister, 0, 0};
+    try {
         cpu.emulateCycle();
-        isEmulating = !subsystemManager.getInputController().isExitButtonPressed();
+    } catch (...) {
+        // the instruction that faulted is the one most worth finding in the trace, so it is recorded as it was about to run
+        instructionTrace.record(record);
+        throw;
     }
+    record.indexRegister = cpu.getIndexRegisterValue();
+    // highest first, so the value kept is the lowest numbered register's
+    for (int registerNumber = Cpu::NUM_GENERAL_PURPOSE_REGISTERS - 1; registerNumber >= 0; registerNumber--) {
+        uint8_t value = cpu.getRegisterValue(registerNumber);
+        if (value != stateBefore.registers[registerNumber]) {
+            record.changedRegisters |= (uint16_t)(1 << registerNumber);
+            record.changedRegisterValue = value;
+        }
+    }
+    instructionTrace.record(record);
+}
+
+unsigned int Chip8Emulator::emulateNextCycles() {
+    // a recompiled block runs several cycles at once. Anything the recompiled program doesn't cover is interpreted one cycle at a time
+    unsigned int numCycles = recompiledProgram == nullptr ? 0 : recompiledProgram->executeBlock(recompilerContext);
+    if (numCycles == 0) {
+        cpu.emulateCycle();
+        numCycles = 1;
+    }
+    return numCycles;
 }
 
-void Chip8Emulator::stopEmulation() { isEmulating = false; }
+void Chip8Emulator::queueAudio(uint32_t numCycles, uint32_t speed) {
+    IAudio *audio = subsystemManager.getAudio();
+    if (audio == nullptr) {
+        return;
+    }
+    ScopedPhase phase("queue audio");
+    numAudioSamplesOwed += (double)numCycles * audio->getSampleRate() / speed;
+    uint32_t numSamples = (uint32_t)numAudioSamplesOwed;
+    numAudioSamplesOwed -= numSamples;
+    audio->queueSamples(cpu.getSoundTimerValue() > 0, numSamples);
+    // the device counts its own underruns, so the counter catches up to it
+    audioUnderrunsMetric.increment(audio->getNumUnderruns() - audioUnderrunsMetric.getValue());
+    audioLatencyMetric.set(audio->getLatencyMillis() / 1000);
+}
 
-void Chip8Emulator::loadFontToMemory() {
-    for (unsigned int i = 0; i < FONTSET_BUFFER_SIZE; i++) {
-        memory.setDataAtAddress(i + Constants::MEMORY_FONT_START_LOCATION, DEFAULT_FONT_SET[i]);
+bool Chip8Emulator::isAnyKeyPressed() { return cycleInputController.getPressedKeys() != 0; }
+
+void Chip8Emulator::sleepMillis(int millis) {
+    uint64_t startNanos = toHostTimeNanos(std::chrono::steady_clock::now());
+    SleepUtil::sleepMillis(millis);
+    uint64_t sleptNanos = toHostTimeNanos(std::chrono::steady_clock::now()) - startNanos;
+    uint64_t askedNanos = (uint64_t)millis * 1000000;
+    sleepOvershootMetric.record(sleptNanos > askedNanos ? sleptNanos - askedNanos : 0);
+}
+
+void Chip8Emulator::recordFrames(uint64_t firstCycle, uint64_t lastCycle) {
+    uint64_t numFramesEnded = lastCycle / CYCLES_PER_FRAME - firstCycle / CYCLES_PER_FRAME;
+    if (numFramesEnded == 0) {
+        return;
+    }
+    subsystemManager.getDisplay().copyFrameBufferTo(recordedFrame);
+    // a recompiled block can run past the end of a frame, in which case the screen it ended with stands in for every frame it ended
+    for (uint64_t i = 0; i < numFramesEnded; i++) {
+        frameRecorder->recordFrame(recordedFrame);
+    }
+}
+
+void Chip8Emulator::timeFrames() {
+    uint64_t frameNumber = numCyclesExecuted.load(std::memory_order_relaxed) / CYCLES_PER_FRAME;
+    if (frameNumber == lastTimedFrameNumber && lastTimedFrameNanos != 0) {
+        return;
+    }
+    uint64_t now = toHostTimeNanos(std::chrono::steady_clock::now());
+    // a batch can finish several frames at once (ex: while unthrottled), in which case each of them took an equal share of the time
+    if (lastTimedFrameNanos != 0 && frameNumber > lastTimedFrameNumber) {
+        uint64_t numFrames = frameNumber - lastTimedFrameNumber;
+        uint64_t frameNanos = (now - lastTimedFrameNanos) / numFrames;
+        for (uint64_t i = 0; i < numFrames; i++) {
+            frameWallTimeMetric.record(frameNanos);
+        }
     }
+    lastTimedFrameNumber = frameNumber;
+    lastTimedFrameNanos = now;
+}
+
+std::vector<std::string> Chip8Emulator::getMetricsOverlayLines() const {
+    const double nanosPerMilli = 1e6;
+    char line[128];
+    std::vector<std::string> lines;
+    snprintf(line, sizeof(line), "IPS %.0f", instructionsPerSecondMetric.getValue());
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "FRAME EMULATED %.1fMS WALL P50 %.1fMS P99 %.1fMS", emulatedFrameTimeMetric.getValue() * 1000,
+             frameWallTimeMetric.getValueAtPercentile(50) / nanosPerMilli, frameWallTimeMetric.getValueAtPercentile(99) / nanosPerMilli);
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "PRESENT P50 %.2fMS P99 %.2fMS", presentDurationMetric.getValueAtPercentile(50) / nanosPerMilli,
+             presentDurationMetric.getValueAtPercentile(99) / nanosPerMilli);
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "INPUT TO PRESENT P50 %.1fMS P99 %.1fMS",
+             inputToPresentLatencyMetric.getValueAtPercentile(50) / nanosPerMilli,
+             inputToPresentLatencyMetric.getValueAtPercentile(99) / nanosPerMilli);
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "SLEEP OVERSHOOT P50 %.2fMS P99 %.2fMS", sleepOvershootMetric.getValueAtPercentile(50) / nanosPerMilli,
+             sleepOvershootMetric.getValueAtPercentile(99) / nanosPerMilli);
+    lines.push_back(line);
+    snprintf(line, sizeof(line), "AUDIO LATENCY %.1fMS UNDERRUNS %llu", audioLatencyMetric.getValue() * 1000,
+             (unsigned long long)audioUnderrunsMetric.getValue());
+    lines.push_back(line);
+    return lines;
+}
+
+void Chip8Emulator::runAhead(uint32_t numFrames) {
+    ScopedPhase phase("run ahead");
+    runAheadSnapshot = saveState();
+    uint32_t numCycles = 0;
+    try {
+        while (numCycles < numFrames * CYCLES_PER_FRAME && !(cpu.isNextInstructionWaitForKeyPress() && !isAnyKeyPressed())) {
+            numCycles += emulateNextCycles();
+        }
+    } catch (const BaseException &) {
+        // the future can't be shown past a fault, and the fault is thrown again once emulation really gets there
+    }
+    subsystemManager.getDisplay().updateScreen();
+    restoreState(runAheadSnapshot);
+}
+
+bool Chip8Emulator::sendCommand(const EmulationCommand &command) {
+    if (!commands.tryPush(command)) {
+        return false;
+    }
+    numCommandsSent.fetch_add(1, std::memory_order_release);
+    FutexUtil::wakeAll(numCommandsSent);
+    return true;
+}
+
+bool Chip8Emulator::pauseEmulation() { return sendCommand({EmulationCommand::Type::PAUSE, 0}); }
+
+bool Chip8Emulator::resumeEmulation() { return sendCommand({EmulationCommand::Type::RESUME, 0}); }
+
+bool Chip8Emulator::stepEmulation(uint32_t numCycles) { return sendCommand({EmulationCommand::Type::STEP, numCycles}); }
+
+bool Chip8Emulator::setEmulationSpeed(uint32_t cyclesPerSecond) { return sendCommand({EmulationCommand::Type::SET_SPEED, cyclesPerSecond}); }
+
+bool Chip8Emulator::saveStateToSlot(uint32_t slot) {
+    if (slot >= NUM_SAVE_STATE_SLOTS) {
+        throw IndexOutOfBoundsException("There is no save state slot " + std::to_string(slot));
+    }
+    return sendCommand({EmulationCommand::Type::SAVE_STATE, slot});
+}
+
+bool Chip8Emulator::loadStateFromSlot(uint32_t slot) {
+    if (slot >= NUM_SAVE_STATE_SLOTS) {
+        throw IndexOutOfBoundsException("There is no save state slot " + std::to_string(slot));
+    }
+    return sendCommand({EmulationCommand::Type::LOAD_STATE, slot});
+}
+
+bool Chip8Emulator::stopEmulation() { return sendCommand({EmulationCommand::Type::STOP, 0}); }
+
+bool Chip8Emulator::setRunAheadFrames(uint32_t numFrames) {
+    if (numFrames > MAX_RUN_AHEAD_FRAMES) {
+        throw IndexOutOfBoundsException("Can't run more than " + std::to_string(MAX_RUN_AHEAD_FRAMES) + " frames ahead");
+    }
+    return sendCommand({EmulationCommand::Type::SET_RUN_AHEAD, numFrames});
+}
+
+bool Chip8Emulator::setTurbo(uint32_t multiplier) { return sendCommand({EmulationCommand::Type::SET_TURBO, multiplier}); }
+
+bool Chip8Emulator::queueKeyEvent(const TimedKeyEvent &event) { return keyEvents.tryPush(event); }
+
+void Chip8Emulator::scheduleKeyEvent(const CycleKeyEvent &event) { cycleInputController.scheduleEvent(event); }
+
+void Chip8Emulator::startRecording(InputMovie &movie) {
+    checkNoCyclesRun("start recording");
+    movie.romHash = gameHash;
+    movie.randomSeed = RandomUtil::getTimeSeed();
+    movie.events.clear();
+    cpu.setRandomSeed(movie.randomSeed);
+    recordingMovie = &movie;
+    cycleInputController.setRecording(&movie.events);
+}
+
+void Chip8Emulator::stopRecording() {
+    if (recordingMovie == nullptr) {
+        return;
+    }
+    cycleInputController.setRecording(nullptr);
+    recordingMovie->numCycles = numCyclesExecuted.load(std::memory_order_relaxed);
+    recordingMovie->finalStateHash = saveState().getHash();
+    recordingMovie = nullptr;
+}
+
+void Chip8Emulator::startReplay(const InputMovie &movie) {
+    checkNoCyclesRun("start a replay");
+    if (movie.romHash != gameHash) {
+        throw InitializationException("The movie was recorded with a different game");
+    }
+    cpu.setRandomSeed(movie.randomSeed);
+    for (const CycleKeyEvent &event : movie.events) {
+        cycleInputController.scheduleEvent(event);
+    }
+}
+
+void Chip8Emulator::checkNoCyclesRun(const std::string &action) {
+    if (numCyclesExecuted.load(std::memory_order_relaxed) != 0) {
+        throw InitializationException("Can't " + action + " after the game has started running");
+    }
+}
+
+EmulationStatus Chip8Emulator::getEmulationStatus() const { return status.load(std::memory_order_acquire); }
+
+uint64_t Chip8Emulator::getNumCyclesExecuted() const { return numCyclesExecuted.load(std::memory_order_relaxed); }
+
+uint32_t Chip8Emulator::getEmulationSpeed() const { return cyclesPerSecond.load(std::memory_order_relaxed); }
+
+uint32_t Chip8Emulator::getRunAheadFrames() const { return numRunAheadFrames.load(std::memory_order_relaxed); }
+
+uint32_t Chip8Emulator::getTurboMultiplier() const { return turboMultiplier.load(std::memory_order_relaxed); }
+
+uint32_t Chip8Emulator::getNumStatesSaved() const { return numStatesSaved.load(std::memory_order_acquire); }
+
+void Chip8Emulator::setRandomSeed(uint32_t seed) { cpu.setRandomSeed(seed); }
+
+EmulatorState Chip8Emulator::saveState() {
+    EmulatorState state;
+    state.cpu = cpu.getState();
+    memory.copyTo(state.memory);
+    subsystemManager.getDisplay().copyFrameBufferTo(state.frameBuffer);
+    return state;
+}
+
+void Chip8Emulator::loadState(const EmulatorState &state) {
+    restoreState(state);
+    subsystemManager.getDisplay().updateScreen();
+}
+
+void Chip8Emulator::updateTurboScreen() {
+    uint64_t now = toHostTimeNanos(std::chrono::steady_clock::now());
+    if (now - lastTurboFrameNanos >= 1000000000ull / TURBO_FRAMES_PER_SECOND) {
+        subsystemManager.getDisplay().updateScreen();
+        lastTurboFrameNanos = now;
+    }
+}
+
+void Chip8Emulator::restoreState(const EmulatorState &state) {
+    cpu.setState(state.cpu);
+    memory.copyFrom(state.memory);
+    subsystemManager.getDisplay().copyFrameBufferFrom(state.frameBuffer);
+}
+
+RunResult Chip8Emulator::runCycles(uint32_t numCycles, unsigned int stopEvents) {
+    return run(numCycles, stopEvents, cpu.getProgramCounter(), nullptr);
+}
+
+RunResult Chip8Emulator::runFrames(uint32_t numFrames, unsigned int stopEvents) {
+    return run(numFrames * CYCLES_PER_FRAME, stopEvents, cpu.getProgramCounter(), nullptr);
+}
+
+RunResult Chip8Emulator::runUntil(unsigned int stopEvents, uint16_t targetProgramCounter, uint32_t maxCycles) {
+    return run(maxCycles, stopEvents, targetProgramCounter, nullptr);
+}
+
+RunResult Chip8Emulator::runUntil(const std::function<bool(const Cpu &)> &predicate, uint32_t maxCycles, unsigned int stopEvents) {
+    return run(maxCycles, stopEvents, cpu.getProgramCounter(), &predicate);
+}
+
+RunResult Chip8Emulator::run(uint32_t maxCycles, unsigned int stopEvents, uint16_t targetProgramCounter,
+                             const std::function<bool(const Cpu &)> *predicate) {
+    RunResult result = {StopReason::CYCLE_LIMIT_REACHED, cpu.getProgramCounter(), 0};
+    // whoever drives the runs changes keys on the host controller between them, so its changes take effect at the start of this run
+    uint16_t hostPressedKeys = subsystemManager.getInputController().getPressedKeys();
+    scheduleKeyChanges(hostPressedKeysAtLastRun, hostPressedKeys);
+    hostPressedKeysAtLastRun = hostPressedKeys;
+    uint64_t firstCycle = numCyclesExecuted.load(std::memory_order_relaxed);
+    bool isTracing = isTracingInstructions.load(std::memory_order_relaxed);
+    while (result.numCyclesExecuted < maxCycles) {
+        cycleInputController.applyEventsUpTo(firstCycle + result.numCyclesExecuted);
+        // events at the instruction the run started at are ignored, so a stopped run can be resumed
+        if (result.numCyclesExecuted > 0) {
+            if ((stopEvents & EmulationEvent::PROGRAM_COUNTER_REACHED) && cpu.getProgramCounter() == targetProgramCounter) {
+                result.stopReason = StopReason::PROGRAM_COUNTER_REACHED;
+                break;
+            }
+            if ((stopEvents & EmulationEvent::WAITING_FOR_KEY) && cpu.isNextInstructionWaitForKeyPress()) {
+                result.stopReason = StopReason::WAITING_FOR_KEY;
+                break;
+            }
+        }
+
+        unsigned long numScreenUpdates = cpu.getNumScreenUpdates();
+        try {
+            if (isTracing) {
+                emulateTracedCycle(firstCycle + result.numCyclesExecuted);
+            } else {
+                cpu.emulateCycle();
+            }
+        } catch (const BaseException &e) {
+            if (!(stopEvents & EmulationEvent::FAULT)) {
+                throw;
+            }
+            lastFaultMessage = e.what();
+            result.stopReason = StopReason::FAULT;
+            break;
+        }
+        result.numCyclesExecuted++;
+        if (frameRecorder != nullptr) {
+            recordFrames(firstCycle + result.numCyclesExecuted - 1, firstCycle + result.numCyclesExecuted);
+        }
+
+        if ((stopEvents & EmulationEvent::FRAME_PRESENTED) && cpu.getNumScreenUpdates() != numScreenUpdates) {
+            result.stopReason = StopReason::FRAME_PRESENTED;
+            break;
+        }
+        if (predicate != nullptr && (*predicate)(cpu)) {
+            result.stopReason = StopReason::PREDICATE_MATCHED;
+            break;
+        }
+    }
+    result.programCounter = cpu.getProgramCounter();
+    numCyclesExecuted.fetch_add(result.numCyclesExecuted, std::memory_order_relaxed);
+    cyclesMetric.increment(result.numCyclesExecuted);
+    return result;
+}
+
+const Cpu &Chip8Emulator::getCpu() const { return cpu; }
+
+void Chip8Emulator::resetCoverage() { cpu.resetCoverage(); }
+
+const Memory &Chip8Emulator::getMemory() const { return memory; }
+
+void Chip8Emulator::setInstructionTracing(bool isEnabled) { isTracingInstructions.store(isEnabled, std::memory_order_relaxed); }
+
+bool Chip8Emulator::isInstructionTracing() const { return isTracingInstructions.load(std::memory_order_relaxed); }
+
+const InstructionTrace &Chip8Emulator::getInstructionTrace() const { return instructionTrace; }
+
+const std::string &Chip8Emulator::getLastFaultMessage() const { return lastFaultMessage; }
+
+void Chip8Emulator::setFrameRecorder(FrameRecorder *recorder) { frameRecorder = recorder; }
+
+const MetricsRegistry &Chip8Emulator::getMetrics() const { return metrics; }
+
+void Chip8Emulator::setMetricsFile(const std::string &path) { metricsFilePath = path; }
+
+void Chip8Emulator::loadFontToMemory() {
+    std::memcpy(powerOnMemory + Constants::MEMORY_FONT_START_LOCATION, DEFAULT_FONT_SET, FONTSET_BUFFER_SIZE);
+    memory.copyFrom(Constants::MEMORY_FONT_START_LOCATION, powerOnMemory + Constants::MEMORY_FONT_START_LOCATION, FONTSET_BUFFER_SIZE);
+    std::memcpy(powerOnMemory + Constants::MEMORY_BIG_FONT_START_LOCATION, BIG_FONT_SET, BIG_FONTSET_BUFFER_SIZE);
+    memory.copyFrom(Constants::MEMORY_BIG_FONT_START_LOCATION, powerOnMemory + Constants::MEMORY_BIG_FONT_START_LOCATION,
+                    BIG_FONTSET_BUFFER_SIZE);
 }
 
 void Chip8Emulator::loadGameFile(std::string game) {
-    FileByteReader fileByteReader(game);
-    const int bufferSize = Memory::NUM_BYTES_OF_MEMORY - Constants::MEMORY_PROGRAM_START_LOCATION;
-    uint8_t buffer[bufferSize];
-    long bytesRead = fileByteReader.readToBuffer(buffer, 0, bufferSize);
-    if (bytesRead > 0) {
-        for (unsigned int address = Constants::MEMORY_PROGRAM_START_LOCATION; address < Memory::NUM_BYTES_OF_MEMORY; address++) {
-            memory.setDataAtAddress(address, buffer[address - Constants::MEMORY_PROGRAM_START_LOCATION]);
-        }
-    } else {
+    MappedFile gameFile(game);
+    if (gameFile.getSize() == 0) {
         throw IOException("Could not read any bytes in the file");
     }
+    if (gameFile.getSize() > RomFile::MAX_ROM_SIZE) {
+        throw IOException("Game is " + std::to_string(gameFile.getSize()) + " bytes, which is too large to fit in memory (at most " +
+                          std::to_string(RomFile::MAX_ROM_SIZE) + " bytes)");
+    }
+    loadGameData(gameFile.getData(), gameFile.getSize());
+}
+
+void Chip8Emulator::loadGameData(const uint8_t *data, size_t size) {
+    if (size > RomFile::MAX_ROM_SIZE) {
+        throw IndexOutOfBoundsException("Game is too large to fit in memory");
+    }
+    gameHash = HashUtil::fnv1a(data, size);
+    uint8_t *program = powerOnMemory + Constants::MEMORY_PROGRAM_START_LOCATION;
+    std::memcpy(program, data, size);
+    std::memset(program + size, 0, RomFile::MAX_ROM_SIZE - size);
+    memory.copyFrom(Constants::MEMORY_PROGRAM_START_LOCATION, program, RomFile::MAX_ROM_SIZE);
 }
 
+void Chip8Emulator::reset() {
+    memory.copyFrom(powerOnMemory);
+    cpu.reset();
+    subsystemManager.getDisplay().setHighResolution(false);
+    subsystemManager.getDisplay().updateScreen();
+
+    TimedKeyEvent keyEvent;
+    while (keyEvents.tryPop(keyEvent)) {
+    }
+    cycleInputController.reset();
+    recordingMovie = nullptr;
+    hostPressedKeysAtLastRun = 0;
+    numCyclesExecuted.store(0, std::memory_order_relaxed);
+    numStepCyclesRemaining = 0;
+    numAudioSamplesOwed = 0;
+    lastRunAheadFrameNumber = 0;
+    lastTurboFrameNanos = 0;
+    lastTimedFrameNumber = 0;
+    lastTimedFrameNanos = 0;
+}
+
+void Chip8Emulator::loadRecompiledProgram(std::string libraryPath) { recompiledProgram.reset(new RecompiledProgram(libraryPath)); }
+
 Chip8Emulator::Chip8Emulator(ISubsystemManager &subsystemManager)
     : memory(Memory()),
       subsystemManager(subsystemManager),
-      cpu(Cpu(memory, subsystemManager.getDisplay(), subsystemManager.getInputController())) {
+      cycleInputController(subsystemManager.getInputController()),
+      cpu(Cpu(memory, subsystemManager.getDisplay(), cycleInputController)),
+      recompilerContext(cpu),
+      cyclesMetric(metrics.addCounter("chip8_cycles_total", "Instructions executed")),
+      instructionsPerSecondMetric(metrics.addGauge("chip8_instructions_per_second", "Instructions executed per second of wall time")),
+      emulatedFrameTimeMetric(metrics.addGauge("chip8_emulated_frame_seconds",
+                                               "Emulated time a frame stands for at the current speed, or 0 while unthrottled")),
+      frameWallTimeMetric(metrics.addHistogram("chip8_frame_wall_seconds", "Wall time the emulation thread took per emulated frame")),
+      presentDurationMetric(metrics.addHistogram("chip8_present_duration_seconds", "Time taken to present a new frame")),
+      inputToPresentLatencyMetric(metrics.addHistogram("chip8_input_to_present_seconds",
+                                                       "Time from a key change being polled to the next frame being presented")),
+      sleepOvershootMetric(metrics.addHistogram("chip8_sleep_overshoot_seconds", "Time sleeps took beyond the time asked for")),
+      audioUnderrunsMetric(metrics.addCounter("chip8_audio_underruns_total", "Times the audio device ran out of samples to play")),
+      audioLatencyMetric(metrics.addGauge("chip8_audio_latency_seconds", "Time from audio being queued to it being heard")) {
     loadFontToMemory();
 }
+
+Chip8Emulator::~Chip8Emulator() {
+    if (emulationThread.joinable()) {
+        while (!stopEmulation()) {
+            std::this_thread::yield();
+        }
+        emulationThread.join();
+    }
+}
 }
\ No newline at end of file
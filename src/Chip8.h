@@ -1,9 +1,28 @@
 #ifndef CHIP_8_CHIP8_H
 #define CHIP_8_CHIP8_H
 
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
+#include "EmulationCommand.h"
+#include "EmulatorState.h"
+#include "RunResult.h"
 #include "cpu/Cpu.h"
+#include "cpu/InstructionTrace.h"
+#include "io/FrameRecorder.h"
+#include "io/InputMovie.h"
+#include "recompiler/RecompiledProgram.h"
+#include "recompiler/RecompilerContext.h"
 #include "subsystems/ISubsystemManager.h"
+#include "subsystems/input/CycleInputController.h"
+#include "utils/MetricsRegistry.h"
+#include "utils/MpscQueue.h"
+#include "utils/SpscRingBuffer.h"
 
 /**
  * The "composer" of the chip-8 emulator that takes all the different components of the emulator and orchestrates them together.
@@ -19,9 +38,257 @@ class Chip8Emulator {
    public:
     Chip8Emulator(ISubsystemManager& subsystemManager);
 
+    /**
+     * Stops the emulation thread, if it is running
+     */
+    ~Chip8Emulator();
+
+    // the number of cycles that make up one frame (1/60th of a second) of emulated time
+    static const uint32_t CYCLES_PER_FRAME = 16;
+    static const uint32_t DEFAULT_CYCLES_PER_SECOND = 1000;
+    // a speed of UNTHROTTLED runs the emulation thread as fast as it can
+    static const uint32_t UNTHROTTLED = 0;
+    static const uint32_t NUM_SAVE_STATE_SLOTS = 4;
+    // every frame of run-ahead costs another frame of emulation each frame, and games rarely take more than a few frames to react
+    static const uint32_t MAX_RUN_AHEAD_FRAMES = 8;
+    static const uint32_t DEFAULT_RUN_AHEAD_FRAMES = 1;
+    // a turbo multiplier of 1 runs at the normal speed, which turns turbo off
+    static const uint32_t TURBO_OFF = 1;
+    static const uint32_t DEFAULT_TURBO_MULTIPLIER = 4;
+
+    /**
+     * Maps the game file into memory and copies it into the emulator's memory, without reading it through a buffer first
+     * @throws IOException if the file can't be read, is empty, or is too large to fit in memory
+     */
     void loadGameFile(std::string game);
+
+    /**
+     * Copies a game that is already in memory into the emulator's memory. Any memory the game doesn't fill is zeroed.
+     */
+    void loadGameData(const uint8_t* data, size_t size);
+
+    /**
+     * Loads a library built by chip_8_recompile for the loaded game. Once loaded, the recompiled code is run instead of the interpreter
+     * wherever possible.
+     */
+    void loadRecompiledProgram(std::string libraryPath);
+
+    /**
+     * Runs the game on the emulation thread, while the calling thread polls for input and presents frames, until the exit button is
+     * pressed or stopEmulation() is called. Any exception that stopped the emulation thread is rethrown here.
+     */
     void beginEmulation();
-    void stopEmulation();
+
+    /**
+     * Starts running the game on a dedicated emulation thread, and returns immediately. The thread is controlled by sending it commands,
+     * and its progress can be checked at any time through the getters below, so the controlling thread never blocks on emulation.
+     * Input isn't polled and frames aren't presented by the emulation thread. Whoever starts it must do both (see beginEmulation()).
+     */
+    void startEmulationThread();
+
+    /**
+     * Waits for the emulation thread to stop, and rethrows any exception that stopped it
+     */
+    void waitForEmulationThread();
+
+    bool pauseEmulation();
+    bool resumeEmulation();
+
+    /**
+     * Pauses emulation after running numCycles more cycles
+     */
+    bool stepEmulation(uint32_t numCycles = 1);
+
+    /**
+     * @param cyclesPerSecond the number of cycles to run every second, or UNTHROTTLED
+     */
+    bool setEmulationSpeed(uint32_t cyclesPerSecond);
+
+    /**
+     * Saves the state of the emulator to one of NUM_SAVE_STATE_SLOTS slots, which loadStateFromSlot() can later restore
+     */
+    bool saveStateToSlot(uint32_t slot);
+
+    /**
+     * Restores a state saved by saveStateToSlot(). Loading a slot that was never saved to does nothing
+     */
+    bool loadStateFromSlot(uint32_t slot);
+
+    /**
+     * Restarts the loaded game as if the emulator had just been created and the game loaded, without recreating anything: memory is
+     * restored from the power-on image kept by loadGameData() in a single copy, the cpu's registers are zeroed and the screen is cleared
+     * and put back in low resolution. The cycle count goes back to 0, so a recording or replay can start again, and every key is released
+     * with every queued and scheduled key change dropped. A movie still being recorded is abandoned without being finished, so call
+     * stopRecording() first to keep it.
+     * Settings (the speed, run-ahead, turbo, save state slots and recompiled program) are kept. The random number state carries on too,
+     * so call setRandomSeed() afterwards for repeatable runs.
+     * Must not be called while the emulation thread is running
+     */
+    void reset();
+
+    bool stopEmulation();
+
+    /**
+     * Turns on run-ahead, which hides up to numFrames frames of the time a game takes to react to input, or turns it off if numFrames is 0.
+     * Every emulated frame, the emulation thread takes a snapshot of the emulator, runs numFrames frames ahead with the keys that are
+     * pressed now, presents the frame it got to, and goes back to the snapshot. Only those frames are presented while run-ahead is on.
+     * This only applies while the emulation thread runs at a throttled speed.
+     * @throws IndexOutOfBoundsException if numFrames is more than MAX_RUN_AHEAD_FRAMES
+     */
+    bool setRunAheadFrames(uint32_t numFrames);
+
+    /**
+     * Turns on turbo, which runs the emulation thread at multiplier times its speed, or as fast as it can if multiplier is UNTHROTTLED.
+     * A multiplier of TURBO_OFF turns it off. Drawing a frame for every screen update would take longer than emulating it, so while
+     * turbo is on, the cpu's screen updates aren't handed to the display: the screen is handed over at most TURBO_FRAMES_PER_SECOND
+     * times a second instead. Audio keeps its pitch, since it is queued for the time that passes rather than the cycles run, and is muted
+     * while unthrottled. Run-ahead is off while turbo is on.
+     */
+    bool setTurbo(uint32_t multiplier);
+
+    uint32_t getTurboMultiplier() const;
+
+    /**
+     * Queues a key change for the emulation thread, which applies it at the cycle that matches the time it happened at the current speed
+     * (or at the next cycle, if that cycle has already run). beginEmulation() queues every key change it polls. Only one thread may
+     * queue key changes, and it never blocks.
+     * @return false if the queue is full, in which case the event is dropped
+     */
+    bool queueKeyEvent(const TimedKeyEvent& event);
+
+    /**
+     * Schedules a key change for an exact cycle, as counted by getNumCyclesExecuted(). Must not be called while the emulation thread is
+     * running
+     */
+    void scheduleKeyEvent(const CycleKeyEvent& event);
+
+    /**
+     * Starts recording every key change the cpu sees into movie, along with the hash of the loaded game and a new seed for the cpu's
+     * random numbers. Recording starts at the first cycle, so it must start before any cycle has run.
+     * Must not be called while the emulation thread is running.
+     * @throws InitializationException if a cycle has already run
+     */
+    void startRecording(InputMovie& movie);
+
+    /**
+     * Stops recording, and stores the number of cycles that were run and the hash of the state they ended in in the movie.
+     * Must not be called while the emulation thread is running
+     */
+    void stopRecording();
+
+    /**
+     * Seeds the cpu and schedules every key change in movie, so running movie.numCycles cycles from here (from any mix of runs and
+     * the emulation thread, at any speed) ends in exactly the recorded state. Like startRecording(), must be called before any cycle has
+     * run, and not while the emulation thread is running.
+     * @throws InitializationException if a cycle has already run, or the movie was recorded with a different game
+     */
+    void startReplay(const InputMovie& movie);
+
+    EmulationStatus getEmulationStatus() const;
+
+    /**
+     * @return the number of cycles run since the emulator was created or last reset, by the emulation thread and by runs
+     */
+    uint64_t getNumCyclesExecuted() const;
+
+    uint32_t getEmulationSpeed() const;
+
+    uint32_t getRunAheadFrames() const;
+
+    /**
+     * @return the number of SAVE_STATE commands the emulation thread has completed
+     */
+    uint32_t getNumStatesSaved() const;
+
+    /**
+     * Seeds the random numbers of 0xCXNN, so that runs from the same state with the same input end in the same state.
+     * Must not be called while the emulation thread is running
+     */
+    void setRandomSeed(uint32_t seed);
+
+    /**
+     * Must not be called while the emulation thread is running
+     */
+    EmulatorState saveState();
+
+    /**
+     * Must not be called while the emulation thread is running
+     */
+    void loadState(const EmulatorState& state);
+
+    /**
+     * Runs up to numCycles cycles, without polling input or sleeping, and returns early if one of stopEvents (see EmulationEvent) occurs.
+     * This lets programs that embed the emulator drive it themselves, in batches as large as they like.
+     * Events that occur at the instruction a run starts at (ex: the program counter already being at the target) don't stop the run,
+     * so that a run that stopped at an event can be resumed past it.
+     */
+    RunResult runCycles(uint32_t numCycles, unsigned int stopEvents = EmulationEvent::NONE);
+
+    /**
+     * Same as runCycles(), but runs up to numFrames * CYCLES_PER_FRAME cycles
+     */
+    RunResult runFrames(uint32_t numFrames, unsigned int stopEvents = EmulationEvent::NONE);
+
+    /**
+     * Same as runCycles(), but can also stop when the program counter reaches targetProgramCounter
+     * (if stopEvents includes EmulationEvent::PROGRAM_COUNTER_REACHED)
+     */
+    RunResult runUntil(unsigned int stopEvents, uint16_t targetProgramCounter, uint32_t maxCycles);
+
+    /**
+     * Runs up to maxCycles cycles, stopping after the first cycle for which predicate returns true
+     */
+    RunResult runUntil(const std::function<bool(const Cpu&)>& predicate, uint32_t maxCycles,
+                       unsigned int stopEvents = EmulationEvent::NONE);
+
+    /**
+     * Like runCycles(), the cpu must not be used while the emulation thread is running
+     */
+    const Cpu& getCpu() const;
+
+    /**
+     * Forgets which instructions were executed so far (see Cpu::getCoverage()), ex: to measure the coverage of each input on its own
+     */
+    void resetCoverage();
+
+    const Memory& getMemory() const;
+
+    /**
+     * Turns recording every executed instruction into the instruction trace on or off. Can be called from any thread, and takes effect
+     * at the next batch of cycles the emulation thread runs, or the next run. Recompiled blocks aren't run while tracing, since their
+     * instructions never pass through the cpu, and neither are the frames run ahead (see setRunAheadFrames()), which never really happen
+     */
+    void setInstructionTracing(bool isEnabled);
+
+    bool isInstructionTracing() const;
+
+    /**
+     * Must not be called while the emulation thread is running
+     */
+    const InstructionTrace& getInstructionTrace() const;
+
+    /**
+     * @return the message of the exception that stopped the last run with StopReason::FAULT
+     */
+    const std::string& getLastFaultMessage() const;
+
+    /**
+     * Hands the screen to recorder at the end of every emulated frame (every CYCLES_PER_FRAME cycles) that the emulation thread or a run
+     * finishes, or stops handing it frames if recorder is null. Frames run ahead (see setRunAheadFrames()) aren't recorded.
+     * Must not be called while the emulation thread is running
+     */
+    void setFrameRecorder(FrameRecorder* recorder);
+
+    /**
+     * The emulator's metrics: the cycles it ran, how long its frames take compared to the emulated time they stand for, and, while
+     * beginEmulation() runs, how long presenting frames and reacting to input take and how much longer than asked sleeps take
+     */
+    const MetricsRegistry& getMetrics() const;
+
+    /**
+     * Makes beginEmulation() write the metrics to path, in the Prometheus text format, every METRICS_UPDATE_MILLIS and when it returns
+     */
+    void setMetricsFile(const std::string& path);
 
    private:
     static const int FONTSET_BUFFER_SIZE = 80;
@@ -43,13 +310,186 @@ class Chip8Emulator {
         0xF0, 0x80, 0xF0, 0x80, 0xF0,  // E
         0xF0, 0x80, 0xF0, 0x80, 0x80   // F
     };
+    static const int BIG_FONTSET_BUFFER_SIZE = 160;
+    // the SUPER-CHIP's 8x10 font, which 0xFX30 points to
+    static constexpr unsigned char BIG_FONT_SET[BIG_FONTSET_BUFFER_SIZE] = {
+        0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C,  // 0
+        0x18, 0x38, 0x58, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C,  // 1
+        0x3E, 0x7F, 0xC3, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xFF, 0xFF,  // 2
+        0x3C, 0x7E, 0xC3, 0x03, 0x0E, 0x0E, 0x03, 0xC3, 0x7E, 0x3C,  // 3
+        0x06, 0x0E, 0x1E, 0x36, 0x66, 0xC6, 0xFF, 0xFF, 0x06, 0x06,  // 4
+        0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFE, 0x03, 0xC3, 0x7E, 0x3C,  // 5
+        0x3E, 0x7C, 0xC0, 0xC0, 0xFC, 0xFE, 0xC3, 0xC3, 0x7E, 0x3C,  // 6
+        0xFF, 0xFF, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x60, 0x60,  // 7
+        0x3C, 0x7E, 0xC3, 0xC3, 0x7E, 0x7E, 0xC3, 0xC3, 0x7E, 0x3C,  // 8
+        0x3C, 0x7E, 0xC3, 0xC3, 0x7F, 0x3F, 0x03, 0x03, 0x3E, 0x7C,  // 9
+        0x18, 0x3C, 0x66, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3,  // A
+        0xFC, 0xFE, 0xC3, 0xC3, 0xFE, 0xFE, 0xC3, 0xC3, 0xFE, 0xFC,  // B
+        0x3C, 0x7E, 0xC3, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0x7E, 0x3C,  // C
+        0xFC, 0xFE, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFE, 0xFC,  // D
+        0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFC, 0xC0, 0xC0, 0xFF, 0xFF,  // E
+        0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0   // F
+    };
+
+    static const uint32_t COMMAND_QUEUE_CAPACITY = 64;
+    // the most cycles an unthrottled emulation thread runs before checking for commands again
+    static const uint32_t NUM_UNTHROTTLED_CYCLES_PER_BATCH = 1024;
+    static const uint32_t KEY_EVENT_QUEUE_CAPACITY = 256;
+    // the refresh rate of most displays: handing over frames any faster than this while in turbo would only waste time on frames that
+    // are never seen
+    static const uint32_t TURBO_FRAMES_PER_SECOND = 60;
+    // how often beginEmulation() updates the instructions per second, the metrics overlay and the metrics file
+    static const uint32_t METRICS_UPDATE_MILLIS = 1000;
 
-    bool isEmulating = false;
     Memory memory;
     ISubsystemManager& subsystemManager;
+    CycleInputController cycleInputController;
     Cpu cpu;
+    RecompilerContext recompilerContext;
+    std::unique_ptr<RecompiledProgram> recompiledProgram;
+    std::string lastFaultMessage;
+
+    MpscQueue<EmulationCommand, COMMAND_QUEUE_CAPACITY> commands;
+    // incremented after every command is queued, so a paused emulation thread can sleep until there is a command for it
+    std::atomic<uint32_t> numCommandsSent{0};
+    SpscRingBuffer<TimedKeyEvent, KEY_EVENT_QUEUE_CAPACITY> keyEvents;
+    std::atomic<EmulationStatus> status{EmulationStatus::STOPPED};
+    std::atomic<uint64_t> numCyclesExecuted{0};
+    std::atomic<uint32_t> cyclesPerSecond{DEFAULT_CYCLES_PER_SECOND};
+    std::atomic<uint32_t> numStatesSaved{0};
+    std::atomic<uint32_t> numRunAheadFrames{0};
+    std::atomic<uint32_t> turboMultiplier{TURBO_OFF};
+    std::atomic<bool> isTracingInstructions{false};
+    std::thread emulationThread;
+    std::exception_ptr emulationThreadException;
+    // only used by the emulation thread
+    uint32_t numStepCyclesRemaining = 0;
+    double numAudioSamplesOwed = 0;
+    EmulatorState saveStateSlots[NUM_SAVE_STATE_SLOTS];
+    bool isSaveStateSlotUsed[NUM_SAVE_STATE_SLOTS] = {};
+    EmulatorState runAheadSnapshot;
+    uint64_t lastRunAheadFrameNumber = 0;
+    bool wasTurboOn = false;
+    uint64_t lastTurboFrameNanos = 0;
+    // the keys the host input controller had pressed at the start of the last run
+    uint16_t hostPressedKeysAtLastRun = 0;
+    uint64_t gameHash = 0;
+    // memory as it is right after the font and game are loaded, which reset() restores
+    uint8_t powerOnMemory[Memory::NUM_BYTES_OF_MEMORY] = {};
+    InputMovie* recordingMovie = nullptr;
+    InstructionTrace instructionTrace;
+    MetricsRegistry metrics;
+    Counter& cyclesMetric;
+    Gauge& instructionsPerSecondMetric;
+    Gauge& emulatedFrameTimeMetric;
+    Histogram& frameWallTimeMetric;
+    Histogram& presentDurationMetric;
+    Histogram& inputToPresentLatencyMetric;
+    Histogram& sleepOvershootMetric;
+    Counter& audioUnderrunsMetric;
+    Gauge& audioLatencyMetric;
+    std::string metricsFilePath;
+    FrameRecorder* frameRecorder = nullptr;
+    // the screen is copied here at the end of each frame before it is recorded
+    FrameBuffer recordedFrame = {};
+    // only used by the emulation thread, to time its frames. 0 when the time of the last frame is unknown (ex: while paused)
+    uint64_t lastTimedFrameNumber = 0;
+    uint64_t lastTimedFrameNanos = 0;
 
     void loadFontToMemory();
+
+    void checkNoCyclesRun(const std::string& action);
+
+    void emulationLoop();
+
+    /**
+     * Queues a command for the emulation thread. Can be called from any thread, and never blocks. Commands are only sent through the
+     * public methods that check their values, so handleCommand() doesn't check them again
+     * @return false if the command queue is full, in which case the command is dropped
+     */
+    bool sendCommand(const EmulationCommand& command);
+
+    void handleCommand(const EmulationCommand& command);
+
+    static uint64_t toHostTimeNanos(std::chrono::steady_clock::time_point time);
+
+    /**
+     * Schedules the queued key events. The cycles about to run at the given speed stand for the host time since batchStartNanos,
+     * so an event is scheduled at the cycle of that batch matching its time. Events are scheduled at the next cycle while the speed is
+     * UNTHROTTLED or emulation is paused, since cycles don't follow the host's time then.
+     */
+    void scheduleQueuedKeyEvents(uint64_t batchStartNanos, uint32_t speed);
+
+    /**
+     * Schedules an event at the next cycle for every key that changed between oldPressedKeys and newPressedKeys
+     */
+    void scheduleKeyChanges(uint16_t oldPressedKeys, uint16_t newPressedKeys);
+
+    /**
+     * Runs maxCycles cycles (a few more if a recompiled block runs past it), unless the next instruction waits for a key press while
+     * no key is pressed. Blocking on that instruction would also block this thread's commands, so instead the cycles stop short of it,
+     * unless a key event is already scheduled: nothing else can happen until then, so it is applied early.
+     * Recompiled blocks are only run while no key event is due before maxCycles, so every event lands at its exact cycle.
+     * @return the number of cycles that were run
+     */
+    uint32_t emulateCycles(uint32_t maxCycles, bool useRecompiledProgram);
+
+    /**
+     * @return the number of cycles that were run
+     */
+    unsigned int emulateNextCycles();
+
+    /**
+     * Emulates a cycle like Cpu::emulateCycle(), and records the instruction it ran into the instruction trace, even if it faulted
+     */
+    void emulateTracedCycle(uint64_t cycleNumber);
+
+    /**
+     * Queues the audio for the emulated time that numCycles cycles take at the given speed: the tone if the sound timer is running,
+     * silence otherwise. Also updates the audio metrics
+     */
+    void queueAudio(uint32_t numCycles, uint32_t speed);
+
+    bool isAnyKeyPressed();
+
+    /**
+     * Sleeps like SleepUtil::sleepMillis(), and records how much longer than millis the sleep took
+     */
+    void sleepMillis(int millis);
+
+    /**
+     * Records the screen once for every frame that ended between the cycles firstCycle and lastCycle, if there is a frame recorder
+     */
+    void recordFrames(uint64_t firstCycle, uint64_t lastCycle);
+
+    /**
+     * Records the wall time of every emulated frame the last batch of cycles finished
+     */
+    void timeFrames();
+
+    /**
+     * @return the lines the metrics overlay shows (see IDisplay::setOverlayText())
+     */
+    std::vector<std::string> getMetricsOverlayLines() const;
+
+    /**
+     * Runs numFrames frames ahead from a snapshot, presents the frame it got to, and restores the snapshot. Nothing that isn't part of the
+     * snapshot is touched: no audio is queued, no key events are applied, and no cycles are counted.
+     */
+    void runAhead(uint32_t numFrames);
+
+    /**
+     * Hands the screen over to the display, if it was last handed over at least 1 / TURBO_FRAMES_PER_SECOND seconds ago
+     */
+    void updateTurboScreen();
+
+    /**
+     * Same as loadState(), without presenting the restored screen
+     */
+    void restoreState(const EmulatorState& state);
+
+    RunResult run(uint32_t maxCycles, unsigned int stopEvents, uint16_t targetProgramCounter,
+                  const std::function<bool(const Cpu&)>* predicate);
 };
 }
 
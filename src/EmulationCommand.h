@@ -0,0 +1,23 @@
+#ifndef CHIP_8_EMULATIONCOMMAND_H
+#define CHIP_8_EMULATIONCOMMAND_H
+
+#include <cstdint>
+
+/**
+ * Types used to control Chip8Emulator's emulation thread from other threads
+ */
+namespace Chip8 {
+enum class EmulationStatus : uint8_t { STOPPED, RUNNING, PAUSED };
+
+class EmulationCommand {
+   public:
+    enum class Type : uint8_t { PAUSE, RESUME, STEP, SET_SPEED, SAVE_STATE, LOAD_STATE, SET_RUN_AHEAD, SET_TURBO, STOP };
+
+    Type type;
+    // the number of cycles for STEP, the number of cycles per second for SET_SPEED, the save state slot for SAVE_STATE and LOAD_STATE,
+    // the number of frames to run ahead for SET_RUN_AHEAD, or the speed multiplier for SET_TURBO. Unused by the other commands
+    uint32_t value;
+};
+}
+
+#endif  // CHIP_8_EMULATIONCOMMAND_H
@@ -0,0 +1,46 @@
+#ifndef CHIP_8_EMULATORSTATE_H
+#define CHIP_8_EMULATORSTATE_H
+
+#include <cstdint>
+#include "cpu/Cpu.h"
+#include "storage/Memory.h"
+#include "subsystems/display/FrameBuffer.h"
+#include "utils/HashUtil.h"
+
+/**
+ * Everything needed to put the emulator back exactly where it was (a "save state"): the cpu, all of memory and the screen
+ */
+namespace Chip8 {
+class EmulatorState {
+   public:
+    CpuState cpu;
+    uint8_t memory[Memory::NUM_BYTES_OF_MEMORY];
+    FrameBuffer frameBuffer;
+
+    /**
+     * @return a hash of the whole state, so two states can be checked for being bit-identical without keeping both around
+     */
+    uint64_t getHash() const {
+        // the cpu's fields are hashed one by one, since the padding between them is never written
+        uint64_t hash = HashUtil::fnv1a(cpu.registers, sizeof(cpu.registers));
+        hash = hashValue(cpu.indexRegister, hash);
+        hash = hashValue(cpu.programCounter, hash);
+        hash = hashValue(cpu.delayTimer, hash);
+        hash = hashValue(cpu.soundTimer, hash);
+        hash = HashUtil::fnv1a((const uint8_t*)cpu.stack, sizeof(cpu.stack), hash);
+        hash = hashValue(cpu.stackLevel, hash);
+        hash = hashValue(cpu.randomNumberState, hash);
+        hash = HashUtil::fnv1a(cpu.flagRegisters, sizeof(cpu.flagRegisters), hash);
+        hash = HashUtil::fnv1a(memory, sizeof(memory), hash);
+        return frameBuffer.getHash(hash);
+    }
+
+   private:
+    template <typename T>
+    static uint64_t hashValue(const T& value, uint64_t hash) {
+        return HashUtil::fnv1a((const uint8_t*)&value, sizeof(value), hash);
+    }
+};
+}
+
+#endif  // CHIP_8_EMULATORSTATE_H
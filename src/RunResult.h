@@ -0,0 +1,37 @@
+#ifndef CHIP_8_RUNRESULT_H
+#define CHIP_8_RUNRESULT_H
+
+#include <cstdint>
+
+/**
+ * Types used by Chip8Emulator's batched run API (runCycles(), runFrames() and runUntil()).
+ */
+namespace Chip8 {
+/**
+ * Bit flags for the events that can stop a run early. They can be combined with '|'.
+ */
+class EmulationEvent {
+   public:
+    static const unsigned int NONE = 0;
+    // the screen was updated by the cycle that was just executed
+    static const unsigned int FRAME_PRESENTED = 1 << 0;
+    // the next instruction is 0xFX0A, which blocks until a key is pressed
+    static const unsigned int WAITING_FOR_KEY = 1 << 1;
+    // the program counter reached the target address of the run
+    static const unsigned int PROGRAM_COUNTER_REACHED = 1 << 2;
+    // executing a cycle threw an exception. If this isn't requested, the exception is thrown out of the run instead
+    static const unsigned int FAULT = 1 << 3;
+};
+
+enum class StopReason : uint8_t { CYCLE_LIMIT_REACHED, FRAME_PRESENTED, WAITING_FOR_KEY, PROGRAM_COUNTER_REACHED, FAULT, PREDICATE_MATCHED };
+
+class RunResult {
+   public:
+    StopReason stopReason;
+    // the program counter after the run, i.e. the address of the next instruction to execute
+    uint16_t programCounter;
+    uint32_t numCyclesExecuted;
+};
+}
+
+#endif  // CHIP_8_RUNRESULT_H
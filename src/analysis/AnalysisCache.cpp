@@ -0,0 +1,26 @@
+#include "AnalysisCache.h"
+#include <fstream>
+#include "../constants/Constants.h"
+
+namespace Chip8 {
+// needed for static class definition of this string to compile
+constexpr const char *AnalysisCache::SIDECAR_EXTENSION;
+
+std::string AnalysisCache::getSidecarPath(const std::string &romPath) { return romPath + SIDECAR_EXTENSION; }
+
+BlockMap AnalysisCache::loadOrAnalyze(const std::string &romPath, uint64_t romHash, Memory &memory) {
+    BlockMap blockMap;
+    std::ifstream sidecarInput(getSidecarPath(romPath), std::ios::binary);
+    if (sidecarInput.is_open() && blockMap.load(sidecarInput, romHash)) {
+        return blockMap;
+    }
+    sidecarInput.close();
+
+    blockMap = BlockMap(RomAnalysis(memory, Constants::MEMORY_PROGRAM_START_LOCATION));
+    std::ofstream sidecarOutput(getSidecarPath(romPath), std::ios::binary);
+    if (sidecarOutput.is_open()) {
+        blockMap.save(sidecarOutput, romHash);
+    }
+    return blockMap;
+}
+}
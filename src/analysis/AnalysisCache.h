@@ -0,0 +1,28 @@
+#ifndef CHIP_8_ANALYSISCACHE_H
+#define CHIP_8_ANALYSISCACHE_H
+
+#include <string>
+#include "BlockMap.h"
+
+/**
+ * Caches the BlockMap of a ROM in a sidecar file next to the ROM, so the ROM only has to be analyzed the first time it is used.
+ * The sidecar file records the hash of the ROM's contents, so a stale sidecar (ex: the ROM file was replaced) is detected and rebuilt.
+ */
+namespace Chip8 {
+class AnalysisCache {
+   public:
+    static std::string getSidecarPath(const std::string &romPath);
+
+    /**
+     * @param memory must already contain the ROM. It is only read if the ROM has to be analyzed
+     * @return the cached block map for the ROM, or a freshly built one if there was no usable sidecar file.
+     * A fresh block map is written to the sidecar file if possible. Failing to write the sidecar is not an error
+     */
+    static BlockMap loadOrAnalyze(const std::string &romPath, uint64_t romHash, Memory &memory);
+
+   private:
+    static constexpr const char *SIDECAR_EXTENSION = ".c8a";
+};
+}
+
+#endif  // CHIP_8_ANALYSISCACHE_H
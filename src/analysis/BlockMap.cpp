@@ -0,0 +1,102 @@
+#include "BlockMap.h"
+#include "../constants/Constants.h"
+
+namespace Chip8 {
+BlockMap::BlockMap() {}
+
+BlockMap::BlockMap(const RomAnalysis &analysis) : codeBitmap(analysis.getCodeBitmap()) {
+    for (const auto &block : analysis.getControlFlowGraph().getBasicBlocks()) {
+        uint16_t length = block.second.getEndAddress() - block.first;
+        blocks.push_back({block.first, length});
+        blockStarts.set(block.first);
+    }
+}
+
+const std::vector<MemoryRegion> &BlockMap::getBlocks() const { return blocks; }
+
+std::vector<uint16_t> BlockMap::getBlockStartAddresses() const {
+    std::vector<uint16_t> blockStartAddresses;
+    for (const MemoryRegion &block : blocks) {
+        blockStartAddresses.push_back(block.startAddress);
+    }
+    return blockStartAddresses;
+}
+
+bool BlockMap::isBlockStart(uint16_t address) const { return address < Memory::NUM_BYTES_OF_MEMORY && blockStarts.test(address); }
+
+bool BlockMap::isCodeAddress(uint16_t address) const { return address < Memory::NUM_BYTES_OF_MEMORY && codeBitmap.test(address); }
+
+void BlockMap::save(std::ostream &output, uint64_t romHash) const {
+    // all integers are written in little endian so that files can be shared between machines
+    writeInteger(output, FILE_MAGIC, sizeof(uint32_t));
+    writeInteger(output, FILE_VERSION, sizeof(uint16_t));
+    writeInteger(output, romHash, sizeof(uint64_t));
+    writeInteger(output, blocks.size(), sizeof(uint16_t));
+    for (const MemoryRegion &block : blocks) {
+        writeInteger(output, block.startAddress, sizeof(uint16_t));
+        writeInteger(output, block.length, sizeof(uint16_t));
+    }
+    for (unsigned int address = 0; address < Memory::NUM_BYTES_OF_MEMORY; address += Constants::BITS_IN_BYTE) {
+        uint8_t bits = 0;
+        for (int bit = 0; bit < Constants::BITS_IN_BYTE; bit++) {
+            bits |= codeBitmap.test(address + bit) << bit;
+        }
+        writeInteger(output, bits, sizeof(uint8_t));
+    }
+}
+
+bool BlockMap::load(std::istream &input, uint64_t romHash) {
+    uint64_t magic, version, fileRomHash, numBlocks;
+    if (!readInteger(input, magic, sizeof(uint32_t)) || magic != FILE_MAGIC || !readInteger(input, version, sizeof(uint16_t)) ||
+        version != FILE_VERSION || !readInteger(input, fileRomHash, sizeof(uint64_t)) || fileRomHash != romHash ||
+        !readInteger(input, numBlocks, sizeof(uint16_t))) {
+        return false;
+    }
+
+    std::vector<MemoryRegion> loadedBlocks;
+    std::bitset<Memory::NUM_BYTES_OF_MEMORY> loadedBlockStarts;
+    for (uint64_t i = 0; i < numBlocks; i++) {
+        uint64_t startAddress, length;
+        if (!readInteger(input, startAddress, sizeof(uint16_t)) || !readInteger(input, length, sizeof(uint16_t)) ||
+            startAddress >= Memory::NUM_BYTES_OF_MEMORY) {
+            return false;
+        }
+        loadedBlocks.push_back({(uint16_t)startAddress, (uint16_t)length});
+        loadedBlockStarts.set(startAddress);
+    }
+
+    std::bitset<Memory::NUM_BYTES_OF_MEMORY> loadedCodeBitmap;
+    for (unsigned int address = 0; address < Memory::NUM_BYTES_OF_MEMORY; address += Constants::BITS_IN_BYTE) {
+        uint64_t bits;
+        if (!readInteger(input, bits, sizeof(uint8_t))) {
+            return false;
+        }
+        for (int bit = 0; bit < Constants::BITS_IN_BYTE; bit++) {
+            loadedCodeBitmap.set(address + bit, (bits >> bit) & 1);
+        }
+    }
+
+    blocks = loadedBlocks;
+    blockStarts = loadedBlockStarts;
+    codeBitmap = loadedCodeBitmap;
+    return true;
+}
+
+void BlockMap::writeInteger(std::ostream &output, uint64_t value, int numBytes) {
+    for (int i = 0; i < numBytes; i++) {
+        output.put((char)((value >> (i * Constants::BITS_IN_BYTE)) & Constants::MAX_BYTE_SIZE));
+    }
+}
+
+bool BlockMap::readInteger(std::istream &input, uint64_t &value, int numBytes) {
+    value = 0;
+    for (int i = 0; i < numBytes; i++) {
+        int byte = input.get();
+        if (byte == std::istream::traits_type::eof()) {
+            return false;
+        }
+        value |= (uint64_t)byte << (i * Constants::BITS_IN_BYTE);
+    }
+    return true;
+}
+}
@@ -0,0 +1,62 @@
+#ifndef CHIP_8_BLOCKMAP_H
+#define CHIP_8_BLOCKMAP_H
+
+#include <bitset>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "RomAnalysis.h"
+
+/**
+ * The compact result of analyzing a ROM that runtime engines need: where each basic block starts and ends, and which bytes of memory are
+ * reachable code.
+ * Block maps can be saved to and loaded from a small binary format that is tagged with the hash of the ROM it was built from,
+ * so that engines can reuse an earlier analysis instead of analyzing the ROM again.
+ */
+namespace Chip8 {
+class BlockMap {
+   public:
+    BlockMap();
+
+    BlockMap(const RomAnalysis &analysis);
+
+    /**
+     * @return every basic block, sorted by start address
+     */
+    const std::vector<MemoryRegion> &getBlocks() const;
+
+    /**
+     * @return the start address of every basic block, for rebuilding the ControlFlowGraph or RomAnalysis the block map was made from
+     */
+    std::vector<uint16_t> getBlockStartAddresses() const;
+
+    bool isBlockStart(uint16_t address) const;
+
+    bool isCodeAddress(uint16_t address) const;
+
+    void save(std::ostream &output, uint64_t romHash) const;
+
+    /**
+     * Replaces the contents of this block map with one read from input
+     * @return false if input doesn't contain a block map for the ROM with the given hash, in which case this block map is left unchanged
+     */
+    bool load(std::istream &input, uint64_t romHash);
+
+   private:
+    // the characters "C8A1" when written in little endian
+    static const uint32_t FILE_MAGIC = 0x31413843;
+    // version 3 block maps decode the SUPER-CHIP's screen instructions (0x00CN, 0x00FB-0x00FF), which used to end blocks as invalid
+    static const int FILE_VERSION = 3;
+
+    std::vector<MemoryRegion> blocks;
+    std::bitset<Memory::NUM_BYTES_OF_MEMORY> blockStarts;
+    std::bitset<Memory::NUM_BYTES_OF_MEMORY> codeBitmap;
+
+    static void writeInteger(std::ostream &output, uint64_t value, int numBytes);
+
+    static bool readInteger(std::istream &input, uint64_t &value, int numBytes);
+};
+}
+
+#endif  // CHIP_8_BLOCKMAP_H
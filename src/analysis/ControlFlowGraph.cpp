@@ -0,0 +1,128 @@
+#include "ControlFlowGraph.h"
+#include "../constants/Constants.h"
+
+namespace Chip8 {
+uint16_t BasicBlock::getStartAddress() const { return instructions.front().getAddress(); }
+
+uint16_t BasicBlock::getEndAddress() const { return instructions.back().getNextAddress(); }
+
+const std::vector<Instruction> &BasicBlock::getInstructions() const { return instructions; }
+
+const Instruction &BasicBlock::getLastInstruction() const { return instructions.back(); }
+
+const std::vector<uint16_t> &BasicBlock::getSuccessors() const { return successors; }
+
+ControlFlowGraph::ControlFlowGraph(Memory &memory, uint16_t entryAddress) : memory(memory) {
+    buildBasicBlocks(discoverLeaders(entryAddress));
+}
+
+ControlFlowGraph::ControlFlowGraph(Memory &memory, const std::vector<uint16_t> &blockStartAddresses) : memory(memory) {
+    std::vector<bool> leaders(Memory::NUM_BYTES_OF_MEMORY, false);
+    for (uint16_t address : blockStartAddresses) {
+        if (isAddressInBounds(address)) {
+            leaders[address] = true;
+        }
+    }
+    buildBasicBlocks(leaders);
+}
+
+const std::map<uint16_t, BasicBlock> &ControlFlowGraph::getBasicBlocks() const { return basicBlocks; }
+
+const BasicBlock *ControlFlowGraph::findBasicBlock(uint16_t startAddress) const {
+    auto block = basicBlocks.find(startAddress);
+    return block == basicBlocks.end() ? nullptr : &block->second;
+}
+
+std::vector<uint16_t> ControlFlowGraph::getSuccessorAddresses(const Instruction &instruction) {
+    uint16_t nextAddress = instruction.getNextAddress();
+    switch (instruction.getControlFlow()) {
+        case ControlFlow::NEXT:
+            return {nextAddress};
+        case ControlFlow::JUMP:
+            return {instruction.getTargetAddress()};
+        case ControlFlow::CALL:
+            // assume the subroutine returns, so the instruction after the call is reachable as well
+            return {instruction.getTargetAddress(), nextAddress};
+        case ControlFlow::SKIP:
+            return {nextAddress, (uint16_t)(nextAddress + Instruction::SIZE_IN_BYTES)};
+        default:
+            return {};
+    }
+}
+
+bool ControlFlowGraph::isAddressInBounds(uint16_t address) const {
+    // both bytes of the opcode have to be in memory for the Cpu to fetch it
+    return address + 1 < Memory::NUM_BYTES_OF_MEMORY;
+}
+
+Instruction ControlFlowGraph::decodeInstructionAt(uint16_t address) {
+    uint16_t opcode = memory.getDataAtAddress(address) << Constants::BITS_IN_BYTE | memory.getDataAtAddress(address + 1);
+    return Instruction::decode(address, opcode);
+}
+
+std::vector<bool> ControlFlowGraph::discoverLeaders(uint16_t entryAddress) {
+    std::vector<bool> leaders(Memory::NUM_BYTES_OF_MEMORY, false);
+    std::vector<bool> visited(Memory::NUM_BYTES_OF_MEMORY, false);
+    std::vector<uint16_t> worklist;
+    if (isAddressInBounds(entryAddress)) {
+        leaders[entryAddress] = true;
+        worklist.push_back(entryAddress);
+    }
+
+    while (!worklist.empty()) {
+        uint16_t address = worklist.back();
+        worklist.pop_back();
+        // decode straight-line code until reaching an instruction that ends the block, or code that has already been decoded
+        while (isAddressInBounds(address) && !visited[address]) {
+            visited[address] = true;
+            Instruction instruction = decodeInstructionAt(address);
+            if (instruction.isKeyWait()) {
+                // key waits always start a block, so an engine running whole blocks can check for a key press before blocking on one
+                leaders[address] = true;
+            }
+            if (instruction.endsBasicBlock()) {
+                for (uint16_t successor : getSuccessorAddresses(instruction)) {
+                    if (isAddressInBounds(successor)) {
+                        leaders[successor] = true;
+                        worklist.push_back(successor);
+                    }
+                }
+                break;
+            }
+            address = instruction.getNextAddress();
+        }
+    }
+    return leaders;
+}
+
+void ControlFlowGraph::buildBasicBlocks(const std::vector<bool> &leaders) {
+    for (uint16_t leader = 0; leader < Memory::NUM_BYTES_OF_MEMORY; leader++) {
+        if (!leaders[leader]) {
+            continue;
+        }
+        BasicBlock &block = basicBlocks[leader];
+        uint16_t address = leader;
+        while (true) {
+            Instruction instruction = decodeInstructionAt(address);
+            block.instructions.push_back(instruction);
+            if (instruction.endsBasicBlock()) {
+                for (uint16_t successor : getSuccessorAddresses(instruction)) {
+                    if (isAddressInBounds(successor)) {
+                        block.successors.push_back(successor);
+                    }
+                }
+                break;
+            }
+            address = instruction.getNextAddress();
+            if (!isAddressInBounds(address)) {
+                break;
+            }
+            if (leaders[address]) {
+                // falling through into another block
+                block.successors.push_back(address);
+                break;
+            }
+        }
+    }
+}
+}
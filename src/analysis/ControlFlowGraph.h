@@ -0,0 +1,82 @@
+#ifndef CHIP_8_CONTROLFLOWGRAPH_H
+#define CHIP_8_CONTROLFLOWGRAPH_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "../storage/Memory.h"
+#include "Instruction.h"
+
+/**
+ * Recovers the basic blocks of a chip-8 program loaded into memory by following every statically known path of execution,
+ * starting from an entry point (by default, where the Cpu starts executing programs).
+ * A basic block is a run of instructions that always execute one after the other. Only the last instruction of a block can change
+ * the flow of execution, and only the first instruction of a block can be the target of a jump, call, skip or return.
+ * Targets that can only be known at runtime (ex: 0xBNNN) are not followed; blocks ending in them have no successors.
+ */
+namespace Chip8 {
+class BasicBlock {
+   public:
+    uint16_t getStartAddress() const;
+
+    /**
+     * @return the address just past the last instruction of the block
+     */
+    uint16_t getEndAddress() const;
+
+    const std::vector<Instruction> &getInstructions() const;
+
+    const Instruction &getLastInstruction() const;
+
+    /**
+     * @return the start addresses of every block that execution can statically continue to after this block
+     */
+    const std::vector<uint16_t> &getSuccessors() const;
+
+   private:
+    friend class ControlFlowGraph;
+
+    std::vector<Instruction> instructions;
+    std::vector<uint16_t> successors;
+};
+
+class ControlFlowGraph {
+   public:
+    ControlFlowGraph(Memory &memory, uint16_t entryAddress);
+
+    /**
+     * Rebuilds the graph of a program whose block start addresses are already known (ex: from a BlockMap), without following every path
+     * of execution again
+     */
+    ControlFlowGraph(Memory &memory, const std::vector<uint16_t> &blockStartAddresses);
+
+    /**
+     * @return every basic block that was found, ordered by start address
+     */
+    const std::map<uint16_t, BasicBlock> &getBasicBlocks() const;
+
+    /**
+     * @return the block starting at startAddress, or nullptr if no block starts there
+     */
+    const BasicBlock *findBasicBlock(uint16_t startAddress) const;
+
+    /**
+     * @return the addresses execution can statically continue to after the specified instruction, in increasing order of preference
+     */
+    static std::vector<uint16_t> getSuccessorAddresses(const Instruction &instruction);
+
+   private:
+    Memory &memory;
+    std::map<uint16_t, BasicBlock> basicBlocks;
+
+    bool isAddressInBounds(uint16_t address) const;
+
+    Instruction decodeInstructionAt(uint16_t address);
+
+    std::vector<bool> discoverLeaders(uint16_t entryAddress);
+
+    void buildBasicBlocks(const std::vector<bool> &leaders);
+};
+}
+
+#endif  // CHIP_8_CONTROLFLOWGRAPH_H
@@ -0,0 +1,179 @@
+#include "Disassembler.h"
+#include <iomanip>
+#include <sstream>
+#include "../constants/Constants.h"
+#include "../constants/OpcodeBitshifts.h"
+#include "../constants/Opcodes.h"
+#include "../subsystems/display/IDisplay.h"
+
+namespace Chip8 {
+Disassembler::Disassembler(Memory &memory, const RomAnalysis &analysis) : memory(memory), analysis(analysis) {}
+
+std::string Disassembler::toHex(unsigned int value, int numDigits) {
+    std::ostringstream hex;
+    hex << "0x" << std::uppercase << std::hex << std::setw(numDigits) << std::setfill('0') << value;
+    return hex.str();
+}
+
+std::string Disassembler::getMnemonic(const Instruction &instruction) {
+    std::string x = "V" + toHex(instruction.getRegisterX(), 1).substr(2);
+    std::string y = "V" + toHex(instruction.getRegisterY(), 1).substr(2);
+    std::string address = toHex(instruction.getTargetAddress(), 3);
+    std::string value = toHex(instruction.getValue(), 2);
+    if (instruction.getControlFlow() == ControlFlow::INVALID) {
+        return "DW " + toHex(instruction.getOpcode(), 4);
+    }
+
+    switch (instruction.getOpcode() >> OpcodeBitshifts::NIBBLE_THREE) {
+        case 0x0:
+            switch (instruction.getOpcode()) {
+                case Opcodes::CLEAR_DISPLAY:
+                    return "CLS";
+                case Opcodes::RETURN_FROM_SUBROUTINE:
+                    return "RET";
+                case Opcodes::SCROLL_RIGHT:
+                    return "SCR";
+                case Opcodes::SCROLL_LEFT:
+                    return "SCL";
+                case Opcodes::LOW_RESOLUTION:
+                    return "LOW";
+                case Opcodes::HIGH_RESOLUTION:
+                    return "HIGH";
+                default:
+                    return "SCD " + std::to_string(instruction.getLastNibble());
+            }
+        case 0x1:
+            return "JP " + address;
+        case 0x2:
+            return "CALL " + address;
+        case 0x3:
+            return "SE " + x + ", " + value;
+        case 0x4:
+            return "SNE " + x + ", " + value;
+        case 0x5:
+            return "SE " + x + ", " + y;
+        case 0x6:
+            return "LD " + x + ", " + value;
+        case 0x7:
+            return "ADD " + x + ", " + value;
+        case 0x8: {
+            static const char *const ARITHMETIC_MNEMONICS[] = {"LD", "OR", "AND", "XOR", "ADD", "SUB", "SHR", "SUBN",
+                                                               "",   "",   "",    "",    "",    "",    "SHL"};
+            return std::string(ARITHMETIC_MNEMONICS[instruction.getLastNibble()]) + " " + x + ", " + y;
+        }
+        case 0x9:
+            return "SNE " + x + ", " + y;
+        case 0xA:
+            return "LD I, " + address;
+        case 0xB:
+            return "JP V0, " + address;
+        case 0xC:
+            return "RND " + x + ", " + value;
+        case 0xD:
+            return "DRW " + x + ", " + y + ", " + std::to_string(instruction.getLastNibble());
+        case 0xE:
+            return (instruction.getValue() == Opcodes::KEYPRESS_SKIP_IF_PRESSED ? "SKP " : "SKNP ") + x;
+        default:
+            switch (instruction.getValue()) {
+                case Opcodes::SET_REGISTER_TO_DELAY_TIMER:
+                    return "LD " + x + ", DT";
+                case Opcodes::BLOCK_KEY_PRESSES:
+                    return "LD " + x + ", K";
+                case Opcodes::SET_DELAY_TIMER_TO_REGISTER:
+                    return "LD DT, " + x;
+                case Opcodes::SET_SOUND_TIMER_TO_REGISTER:
+                    return "LD ST, " + x;
+                case Opcodes::ADD_REGISTER_TO_INDEX_REGISTER:
+                    return "ADD I, " + x;
+                case Opcodes::SET_SPRITE_LOCATION:
+                    return "LD F, " + x;
+                case Opcodes::SET_BIG_SPRITE_LOCATION:
+                    return "LD HF, " + x;
+                case Opcodes::CONVERT_TO_BCD:
+                    return "LD B, " + x;
+                case Opcodes::REGISTER_DUMP:
+                    return "LD [I], " + x;
+                case Opcodes::FLAG_REGISTER_DUMP:
+                    return "LD R, " + x;
+                case Opcodes::FLAG_REGISTER_LOAD:
+                    return "LD " + x + ", R";
+                default:
+                    return "LD " + x + ", [I]";
+            }
+    }
+}
+
+void Disassembler::writeListing(std::ostream &output, uint16_t startAddress, uint16_t endAddress, const CoverageMap *coverage) const {
+    const ControlFlowGraph &controlFlowGraph = analysis.getControlFlowGraph();
+    unsigned int address = startAddress;
+    while (address < endAddress) {
+        if (controlFlowGraph.findBasicBlock(address) != nullptr) {
+            bool isSubroutine = analysis.getCallGraph().count(address) > 0;
+            output << "\n" << (isSubroutine ? "sub_" : "block_") << toHex(address, 3) << ":\n";
+        }
+        address += writeLine(output, address, coverage);
+        output << "\n";
+    }
+}
+
+unsigned int Disassembler::writeLine(std::ostream &output, uint16_t address, const CoverageMap *coverage) const {
+    uint8_t firstByte = memory.getDataAtAddress(address);
+    bool isInstruction = analysis.isCodeAddress(address) && analysis.isCodeAddress(address + 1);
+    bool isCovered = coverage != nullptr && coverage->isAddressCovered(address);
+    if (coverage == nullptr) {
+        output << "    ";
+    } else if (isInstruction) {
+        output << (isCovered ? "  + " : "  - ");
+    } else {
+        output << (isCovered ? "  ! " : "    ");
+    }
+
+    if (isInstruction) {
+        Instruction instruction = Instruction::decode(address, firstByte << Constants::BITS_IN_BYTE | memory.getDataAtAddress(address + 1));
+        output << toHex(address, 3) << "  " << toHex(instruction.getOpcode(), 4).substr(2) << "  " << getMnemonic(instruction);
+        return Instruction::SIZE_IN_BYTES;
+    }
+
+    output << toHex(address, 3) << "  " << toHex(firstByte, 2).substr(2) << "    DB " << toHex(firstByte, 2);
+    if (isSpriteAddress(address)) {
+        output << "  ; ";
+        for (int bit = IDisplay::SPRITE_WIDTH - 1; bit >= 0; bit--) {
+            output << (((firstByte >> bit) & 1) ? '#' : '.');
+        }
+    }
+    return 1;
+}
+
+bool Disassembler::isSpriteAddress(uint16_t address) const {
+    for (const MemoryRegion &region : analysis.getSpriteRegions()) {
+        if (address >= region.startAddress && address < region.startAddress + region.length) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Disassembler::writeSummary(std::ostream &output) const {
+    output << "Basic blocks: " << analysis.getControlFlowGraph().getBasicBlocks().size() << "\n";
+
+    output << "Call graph:\n";
+    for (const auto &subroutine : analysis.getCallGraph()) {
+        output << "    " << toHex(subroutine.first, 3) << " ->";
+        for (uint16_t calledSubroutine : subroutine.second) {
+            output << " " << toHex(calledSubroutine, 3);
+        }
+        output << "\n";
+    }
+
+    output << "Sprite data regions:\n";
+    for (const MemoryRegion &region : analysis.getSpriteRegions()) {
+        output << "    " << toHex(region.startAddress, 3) << " - " << toHex(region.startAddress + region.length - 1, 3) << "\n";
+    }
+
+    output << "Self-modifying stores:\n";
+    for (const MemoryStore &store : analysis.getSelfModifyingStores()) {
+        output << "    " << toHex(store.instructionAddress, 3) << " writes " << toHex(store.target.startAddress, 3) << " - "
+               << toHex(store.target.startAddress + store.target.length - 1, 3) << "\n";
+    }
+}
+}
@@ -0,0 +1,50 @@
+#ifndef CHIP_8_DISASSEMBLER_H
+#define CHIP_8_DISASSEMBLER_H
+
+#include <ostream>
+#include <string>
+#include "../cpu/CoverageMap.h"
+#include "RomAnalysis.h"
+
+/**
+ * Turns a program in memory back into human readable assembly, using the results of a RomAnalysis to tell code apart from data.
+ * Mnemonics follow the commonly used syntax from Cowgod's Chip-8 technical reference.
+ */
+namespace Chip8 {
+class Disassembler {
+   public:
+    Disassembler(Memory &memory, const RomAnalysis &analysis);
+
+    static std::string getMnemonic(const Instruction &instruction);
+
+    /**
+     * Writes an annotated listing of memory from startAddress up to (but not including) endAddress.
+     * Reachable code is written as instructions, grouped into basic blocks. Everything else is written as data bytes, and bytes that are
+     * drawn as sprites are drawn next to their value.
+     * If coverage is given, every instruction is marked with '+' if it was executed and '-' if it wasn't, and bytes written as data that
+     * were executed anyway (ex: code the analysis couldn't reach) are marked with '!'.
+     */
+    void writeListing(std::ostream &output, uint16_t startAddress, uint16_t endAddress, const CoverageMap *coverage = nullptr) const;
+
+    /**
+     * Writes the call graph, sprite regions and self-modifying stores found by the analysis
+     */
+    void writeSummary(std::ostream &output) const;
+
+   private:
+    Memory &memory;
+    const RomAnalysis &analysis;
+
+    static std::string toHex(unsigned int value, int numDigits);
+
+    /**
+     * Writes the line for a single code or data address, without a trailing newline.
+     * @return the number of bytes the line covers
+     */
+    unsigned int writeLine(std::ostream &output, uint16_t address, const CoverageMap *coverage) const;
+
+    bool isSpriteAddress(uint16_t address) const;
+};
+}
+
+#endif  // CHIP_8_DISASSEMBLER_H
@@ -0,0 +1,105 @@
+#include "Instruction.h"
+#include "../constants/OpcodeBitmasks.h"
+#include "../constants/OpcodeBitshifts.h"
+#include "../constants/Opcodes.h"
+
+namespace Chip8 {
+Instruction::Instruction(uint16_t address, uint16_t opcode, ControlFlow controlFlow, bool memoryStore)
+    : address(address), opcode(opcode), controlFlow(controlFlow), memoryStore(memoryStore) {}
+
+Instruction Instruction::decode(uint16_t address, uint16_t opcode) {
+    bool isFOpcode = (opcode & OpcodeBitmasks::FIRST_NIBBLE) == 0xF000;
+    int lastByte = opcode & OpcodeBitmasks::LAST_BYTE;
+    bool memoryStore = isFOpcode && (lastByte == Opcodes::CONVERT_TO_BCD || lastByte == Opcodes::REGISTER_DUMP);
+    return Instruction(address, opcode, decodeControlFlow(opcode), memoryStore);
+}
+
+ControlFlow Instruction::decodeControlFlow(uint16_t opcode) {
+    // this mirrors the opcode implementation tables in the Cpu. Any opcode the Cpu would throw on is reported as INVALID
+    switch ((opcode & OpcodeBitmasks::FIRST_NIBBLE) >> OpcodeBitshifts::NIBBLE_THREE) {
+        case 0x0:
+            switch (opcode) {
+                case Opcodes::CLEAR_DISPLAY:
+                case Opcodes::SCROLL_RIGHT:
+                case Opcodes::SCROLL_LEFT:
+                case Opcodes::LOW_RESOLUTION:
+                case Opcodes::HIGH_RESOLUTION:
+                    return ControlFlow::NEXT;
+                case Opcodes::RETURN_FROM_SUBROUTINE:
+                    return ControlFlow::RETURN;
+                default:
+                    bool isScrollDown = (opcode & OpcodeBitmasks::FIRST_THREE_NIBBLES) == Opcodes::SCROLL_DOWN;
+                    return isScrollDown ? ControlFlow::NEXT : ControlFlow::INVALID;
+            }
+        case 0x1:
+            return ControlFlow::JUMP;
+        case 0x2:
+            return ControlFlow::CALL;
+        case 0x3:
+        case 0x4:
+        case 0x5:
+        case 0x9:
+            return ControlFlow::SKIP;
+        case 0x8: {
+            int operation = opcode & OpcodeBitmasks::LAST_NIBBLE;
+            return (operation <= 0x7 || operation == 0xE) ? ControlFlow::NEXT : ControlFlow::INVALID;
+        }
+        case 0xB:
+            return ControlFlow::INDIRECT_JUMP;
+        case 0xE: {
+            int lastByte = opcode & OpcodeBitmasks::LAST_BYTE;
+            bool isKeypressSkip = lastByte == Opcodes::KEYPRESS_SKIP_IF_PRESSED || lastByte == Opcodes::KEYPRESS_SKIP_IF_NOT_PRESSED;
+            return isKeypressSkip ? ControlFlow::SKIP : ControlFlow::INVALID;
+        }
+        case 0xF:
+            switch (opcode & OpcodeBitmasks::LAST_BYTE) {
+                case Opcodes::SET_REGISTER_TO_DELAY_TIMER:
+                case Opcodes::BLOCK_KEY_PRESSES:
+                case Opcodes::SET_DELAY_TIMER_TO_REGISTER:
+                case Opcodes::SET_SOUND_TIMER_TO_REGISTER:
+                case Opcodes::ADD_REGISTER_TO_INDEX_REGISTER:
+                case Opcodes::SET_SPRITE_LOCATION:
+                case Opcodes::SET_BIG_SPRITE_LOCATION:
+                case Opcodes::CONVERT_TO_BCD:
+                case Opcodes::REGISTER_DUMP:
+                case Opcodes::REGISTER_LOAD:
+                case Opcodes::FLAG_REGISTER_DUMP:
+                case Opcodes::FLAG_REGISTER_LOAD:
+                    return ControlFlow::NEXT;
+                default:
+                    return ControlFlow::INVALID;
+            }
+        default:
+            return ControlFlow::NEXT;
+    }
+}
+
+bool Instruction::endsBasicBlock() const {
+    // memory stores end a block too, since they may overwrite the instructions that follow them
+    return controlFlow != ControlFlow::NEXT || memoryStore;
+}
+
+uint16_t Instruction::getAddress() const { return address; }
+
+uint16_t Instruction::getOpcode() const { return opcode; }
+
+ControlFlow Instruction::getControlFlow() const { return controlFlow; }
+
+bool Instruction::isMemoryStore() const { return memoryStore; }
+
+bool Instruction::isKeyWait() const {
+    return (opcode & OpcodeBitmasks::FIRST_NIBBLE) == 0xF000 && (opcode & OpcodeBitmasks::LAST_BYTE) == Opcodes::BLOCK_KEY_PRESSES;
+}
+
+uint16_t Instruction::getTargetAddress() const { return opcode & OpcodeBitmasks::LAST_THREE_NIBBLES; }
+
+unsigned int Instruction::getRegisterX() const { return (opcode & OpcodeBitmasks::SECOND_NIBBLE) >> OpcodeBitshifts::NIBBLE_TWO; }
+
+unsigned int Instruction::getRegisterY() const { return (opcode & OpcodeBitmasks::THIRD_NIBBLE) >> OpcodeBitshifts::NIBBLE; }
+
+uint8_t Instruction::getValue() const { return (uint8_t)(opcode & OpcodeBitmasks::LAST_BYTE); }
+
+uint8_t Instruction::getLastNibble() const { return (uint8_t)(opcode & OpcodeBitmasks::LAST_NIBBLE); }
+
+uint16_t Instruction::getNextAddress() const { return address + SIZE_IN_BYTES; }
+}
@@ -0,0 +1,83 @@
+#ifndef CHIP_8_INSTRUCTION_H
+#define CHIP_8_INSTRUCTION_H
+
+#include <cstdint>
+
+/**
+ * A decoded chip-8 instruction, as seen by offline tools (ex: the recompiler) rather than by the Cpu.
+ * Decoding uses the same opcode knowledge as the Cpu (see Opcodes.h and OpcodeBitmasks.h), but instead of executing an opcode,
+ * it describes how the opcode affects control flow, so that programs can be analyzed without running them.
+ */
+namespace Chip8 {
+enum class ControlFlow {
+    // execution continues at the next instruction
+    NEXT,
+    // 0x1NNN
+    JUMP,
+    // 0x2NNN
+    CALL,
+    // 0x00EE
+    RETURN,
+    // 0x3XNN, 0x4XNN, 0x5XY0, 0x9XY0, 0xEX9E and 0xEXA1. Execution continues at either the next instruction or the one after it.
+    SKIP,
+    // 0xBNNN. The target depends on the value of V0, so it can't be known ahead of time
+    INDIRECT_JUMP,
+    // an opcode the Cpu doesn't implement. Executing it throws an exception
+    INVALID
+};
+
+class Instruction {
+   public:
+    static const int SIZE_IN_BYTES = 2;
+
+    static Instruction decode(uint16_t address, uint16_t opcode);
+
+    uint16_t getAddress() const;
+
+    uint16_t getOpcode() const;
+
+    ControlFlow getControlFlow() const;
+
+    /**
+     * @return true if the instruction stores to memory (0xFX33 and 0xFX55), which can be used by a program to modify itself
+     */
+    bool isMemoryStore() const;
+
+    /**
+     * @return true if the instruction blocks until a key is pressed (0xFX0A)
+     */
+    bool isKeyWait() const;
+
+    /**
+     * @return true if execution can't continue past this instruction to the next one in the same basic block
+     */
+    bool endsBasicBlock() const;
+
+    /**
+     * @return the NNN part of the opcode. For jumps and calls, this is the target address
+     */
+    uint16_t getTargetAddress() const;
+
+    unsigned int getRegisterX() const;
+
+    unsigned int getRegisterY() const;
+
+    uint8_t getValue() const;
+
+    uint8_t getLastNibble() const;
+
+    uint16_t getNextAddress() const;
+
+   private:
+    Instruction(uint16_t address, uint16_t opcode, ControlFlow controlFlow, bool memoryStore);
+
+    uint16_t address;
+    uint16_t opcode;
+    ControlFlow controlFlow;
+    bool memoryStore;
+
+    static ControlFlow decodeControlFlow(uint16_t opcode);
+};
+}
+
+#endif  // CHIP_8_INSTRUCTION_H
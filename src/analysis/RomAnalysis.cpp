@@ -0,0 +1,135 @@
+#include "RomAnalysis.h"
+#include <algorithm>
+#include "../constants/OpcodeBitshifts.h"
+#include "../constants/Opcodes.h"
+
+namespace Chip8 {
+RomAnalysis::RomAnalysis(Memory &memory, uint16_t entryAddress) : controlFlowGraph(memory, entryAddress) {
+    markCode();
+    buildCallGraph(entryAddress);
+    findMemoryAccesses();
+    mergeSpriteRegions();
+}
+
+RomAnalysis::RomAnalysis(Memory &memory, uint16_t entryAddress, const std::vector<uint16_t> &blockStartAddresses)
+    : controlFlowGraph(memory, blockStartAddresses) {
+    markCode();
+    buildCallGraph(entryAddress);
+    findMemoryAccesses();
+    mergeSpriteRegions();
+}
+
+void RomAnalysis::markCode() {
+    for (const auto &block : controlFlowGraph.getBasicBlocks()) {
+        for (const Instruction &instruction : block.second.getInstructions()) {
+            codeBitmap.set(instruction.getAddress());
+            codeBitmap.set(instruction.getAddress() + 1);
+        }
+    }
+}
+
+void RomAnalysis::buildCallGraph(uint16_t entryAddress) {
+    std::vector<uint16_t> worklist = {entryAddress};
+    while (!worklist.empty()) {
+        uint16_t subroutineAddress = worklist.back();
+        worklist.pop_back();
+        if (callGraph.count(subroutineAddress) > 0) {
+            continue;
+        }
+        callGraph[subroutineAddress] = findSubroutineCalls(subroutineAddress);
+        for (uint16_t calledSubroutine : callGraph[subroutineAddress]) {
+            worklist.push_back(calledSubroutine);
+        }
+    }
+}
+
+std::set<uint16_t> RomAnalysis::findSubroutineCalls(uint16_t subroutineAddress) const {
+    std::set<uint16_t> calledSubroutines;
+    std::set<uint16_t> visitedBlocks;
+    std::vector<uint16_t> worklist = {subroutineAddress};
+    while (!worklist.empty()) {
+        const BasicBlock *block = controlFlowGraph.findBasicBlock(worklist.back());
+        worklist.pop_back();
+        if (block == nullptr || !visitedBlocks.insert(block->getStartAddress()).second) {
+            continue;
+        }
+        const Instruction &lastInstruction = block->getLastInstruction();
+        if (lastInstruction.getControlFlow() == ControlFlow::CALL) {
+            // the called subroutine's blocks belong to that subroutine, so only continue on from the return site
+            calledSubroutines.insert(lastInstruction.getTargetAddress());
+            worklist.push_back(lastInstruction.getNextAddress());
+        } else {
+            worklist.insert(worklist.end(), block->getSuccessors().begin(), block->getSuccessors().end());
+        }
+    }
+    return calledSubroutines;
+}
+
+void RomAnalysis::findMemoryAccesses() {
+    const int INDEX_UNKNOWN = -1;
+    for (const auto &block : controlFlowGraph.getBasicBlocks()) {
+        // the index register can only be tracked from an 0xANNN until the end of the block it's in
+        int indexRegister = INDEX_UNKNOWN;
+        for (const Instruction &instruction : block.second.getInstructions()) {
+            switch (instruction.getOpcode() >> OpcodeBitshifts::NIBBLE_THREE) {
+                case 0xA:
+                    indexRegister = instruction.getTargetAddress();
+                    break;
+                case 0xD:
+                    if (indexRegister != INDEX_UNKNOWN) {
+                        // a sprite with no height is a 16x16 sprite, 2 bytes a row
+                        uint16_t length = instruction.getLastNibble() == 0 ? 32 : instruction.getLastNibble();
+                        spriteRegions.push_back({(uint16_t)indexRegister, length});
+                    }
+                    break;
+                case 0xF:
+                    if (instruction.isMemoryStore() && indexRegister != INDEX_UNKNOWN) {
+                        // the BCD representation of a byte is always 3 digits long, and a register dump stores V0 to VX
+                        uint16_t length = instruction.getValue() == Opcodes::CONVERT_TO_BCD ? 3 : instruction.getRegisterX() + 1;
+                        MemoryStore store = {instruction.getAddress(), {(uint16_t)indexRegister, length}};
+                        for (uint16_t address = store.target.startAddress; address < store.target.startAddress + length; address++) {
+                            if (address < Memory::NUM_BYTES_OF_MEMORY && codeBitmap.test(address)) {
+                                selfModifyingStores.push_back(store);
+                                break;
+                            }
+                        }
+                    } else if (instruction.getValue() == Opcodes::ADD_REGISTER_TO_INDEX_REGISTER ||
+                               instruction.getValue() == Opcodes::SET_SPRITE_LOCATION) {
+                        indexRegister = INDEX_UNKNOWN;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+void RomAnalysis::mergeSpriteRegions() {
+    std::sort(spriteRegions.begin(), spriteRegions.end(),
+              [](const MemoryRegion &a, const MemoryRegion &b) { return a.startAddress < b.startAddress; });
+    std::vector<MemoryRegion> mergedRegions;
+    for (const MemoryRegion &region : spriteRegions) {
+        if (!mergedRegions.empty() && region.startAddress <= mergedRegions.back().startAddress + mergedRegions.back().length) {
+            MemoryRegion &previousRegion = mergedRegions.back();
+            uint16_t endAddress = std::max(previousRegion.startAddress + previousRegion.length, region.startAddress + region.length);
+            previousRegion.length = endAddress - previousRegion.startAddress;
+        } else {
+            mergedRegions.push_back(region);
+        }
+    }
+    spriteRegions = mergedRegions;
+}
+
+const ControlFlowGraph &RomAnalysis::getControlFlowGraph() const { return controlFlowGraph; }
+
+const std::bitset<Memory::NUM_BYTES_OF_MEMORY> &RomAnalysis::getCodeBitmap() const { return codeBitmap; }
+
+bool RomAnalysis::isCodeAddress(uint16_t address) const { return address < Memory::NUM_BYTES_OF_MEMORY && codeBitmap.test(address); }
+
+const std::map<uint16_t, std::set<uint16_t>> &RomAnalysis::getCallGraph() const { return callGraph; }
+
+const std::vector<MemoryRegion> &RomAnalysis::getSpriteRegions() const { return spriteRegions; }
+
+const std::vector<MemoryStore> &RomAnalysis::getSelfModifyingStores() const { return selfModifyingStores; }
+}
@@ -0,0 +1,84 @@
+#ifndef CHIP_8_ROMANALYSIS_H
+#define CHIP_8_ROMANALYSIS_H
+
+#include <bitset>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+#include "ControlFlowGraph.h"
+
+/**
+ * A static analysis of a program in memory, built on top of its ControlFlowGraph. In addition to the basic blocks, it recovers:
+ * - which bytes of memory are reachable code
+ * - the call graph between subroutines
+ * - regions of memory that are drawn as sprites
+ * - stores to memory that overwrite reachable code (i.e. self-modifying code)
+ * Sprite regions and store targets can only be found when the index register is set by an 0xANNN earlier in the same basic block,
+ * so they are a best-effort approximation.
+ */
+namespace Chip8 {
+class MemoryRegion {
+   public:
+    uint16_t startAddress;
+    uint16_t length;
+};
+
+class MemoryStore {
+   public:
+    // the address of the 0xFX33 or 0xFX55 instruction
+    uint16_t instructionAddress;
+    MemoryRegion target;
+};
+
+class RomAnalysis {
+   public:
+    RomAnalysis(Memory &memory, uint16_t entryAddress);
+
+    /**
+     * Analyzes a program whose block start addresses are already known (ex: from a BlockMap), so its control flow graph doesn't have to be
+     * discovered again
+     */
+    RomAnalysis(Memory &memory, uint16_t entryAddress, const std::vector<uint16_t> &blockStartAddresses);
+
+    const ControlFlowGraph &getControlFlowGraph() const;
+
+    /**
+     * @return a bitmap with a bit set for both bytes of every reachable instruction
+     */
+    const std::bitset<Memory::NUM_BYTES_OF_MEMORY> &getCodeBitmap() const;
+
+    bool isCodeAddress(uint16_t address) const;
+
+    /**
+     * @return for the entry point and every subroutine, the start addresses of the subroutines it calls
+     */
+    const std::map<uint16_t, std::set<uint16_t>> &getCallGraph() const;
+
+    /**
+     * @return the regions of memory that sprites are drawn from, sorted by start address with overlapping regions merged
+     */
+    const std::vector<MemoryRegion> &getSpriteRegions() const;
+
+    const std::vector<MemoryStore> &getSelfModifyingStores() const;
+
+   private:
+    ControlFlowGraph controlFlowGraph;
+    std::bitset<Memory::NUM_BYTES_OF_MEMORY> codeBitmap;
+    std::map<uint16_t, std::set<uint16_t>> callGraph;
+    std::vector<MemoryRegion> spriteRegions;
+    std::vector<MemoryStore> selfModifyingStores;
+
+    void markCode();
+
+    void buildCallGraph(uint16_t entryAddress);
+
+    std::set<uint16_t> findSubroutineCalls(uint16_t subroutineAddress) const;
+
+    void findMemoryAccesses();
+
+    void mergeSpriteRegions();
+};
+}
+
+#endif  // CHIP_8_ROMANALYSIS_H
@@ -16,6 +16,9 @@ class Constants {
     static const int MAX_BYTE_SIZE = 0xFF;
     static const int MAX_INDEX_REGISTER_VALUE = 0xFFF;
     static const uint8_t FONT_NUM_BYTES_PER_CHARACTER = 5;
+    // the SUPER-CHIP's 8x10 font, stored right after the standard font
+    static const uint16_t MEMORY_BIG_FONT_START_LOCATION = 0x0A0;
+    static const uint8_t BIG_FONT_NUM_BYTES_PER_CHARACTER = 10;
 };
 }
 #endif  // CHIP_8_CONSTANTS_H
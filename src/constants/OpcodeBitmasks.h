@@ -17,6 +17,7 @@ class OpcodeBitmasks {
     static const uint16_t THIRD_NIBBLE = 0x00F0;
     static const uint16_t LAST_NIBBLE = 0x000F;
     static const uint16_t LAST_THREE_NIBBLES = 0x0FFF;
+    static const uint16_t FIRST_THREE_NIBBLES = 0xFFF0;
     static const uint16_t LAST_BYTE = 0x00FF;
     static const uint16_t FIRST_BYTE = 0xFF00;
     static const uint16_t LAST_BIT = 0x0001;
@@ -13,6 +13,12 @@ class Opcodes {
    public:
     static const uint16_t CLEAR_DISPLAY = 0x00E0;
     static const uint16_t RETURN_FROM_SUBROUTINE = 0x00EE;
+    // the SUPER-CHIP's opcodes beginning with zero. SCROLL_DOWN is 0x00CN, where N is the number of rows to scroll
+    static const uint16_t SCROLL_DOWN = 0x00C0;
+    static const uint16_t SCROLL_RIGHT = 0x00FB;
+    static const uint16_t SCROLL_LEFT = 0x00FC;
+    static const uint16_t LOW_RESOLUTION = 0x00FE;
+    static const uint16_t HIGH_RESOLUTION = 0x00FF;
     static const uint16_t KEYPRESS_SKIP_IF_PRESSED = 0x9E;
     static const uint16_t KEYPRESS_SKIP_IF_NOT_PRESSED = 0xA1;
 
@@ -24,9 +30,12 @@ class Opcodes {
     static const int SET_SOUND_TIMER_TO_REGISTER = 0x18;
     static const int ADD_REGISTER_TO_INDEX_REGISTER = 0x1E;
     static const int SET_SPRITE_LOCATION = 0x29;
+    static const int SET_BIG_SPRITE_LOCATION = 0x30;
     static const int CONVERT_TO_BCD = 0x33;
     static const int REGISTER_DUMP = 0x55;
     static const int REGISTER_LOAD = 0x65;
+    static const int FLAG_REGISTER_DUMP = 0x75;
+    static const int FLAG_REGISTER_LOAD = 0x85;
 };
 }
 
@@ -0,0 +1,24 @@
+#include "CoverageMap.h"
+#include <algorithm>
+
+namespace Chip8 {
+CoverageMap::CoverageMap() : edgeHitCounts(NUM_EDGES) { reset(); }
+
+unsigned int CoverageMap::getNumCoveredAddresses() const {
+    unsigned int numCoveredAddresses = 0;
+    for (uint64_t word : addressBits) {
+        numCoveredAddresses += __builtin_popcountll(word);
+    }
+    return numCoveredAddresses;
+}
+
+unsigned int CoverageMap::getNumCoveredEdges() const {
+    return (unsigned int)(NUM_EDGES - std::count(edgeHitCounts.begin(), edgeHitCounts.end(), 0));
+}
+
+void CoverageMap::reset() {
+    std::fill(addressBits, addressBits + NUM_ADDRESSES / BITS_PER_WORD, 0);
+    std::fill(edgeHitCounts.begin(), edgeHitCounts.end(), 0);
+    previousLocation = 0;
+}
+}
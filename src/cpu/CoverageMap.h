@@ -0,0 +1,79 @@
+#ifndef CHIP_8_COVERAGEMAP_H
+#define CHIP_8_COVERAGEMAP_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Records which guest instructions a cpu executed, for fuzzing ROM inputs and for measuring how much of a game a test script exercises.
+ * Two maps are kept:
+ * - one bit per address of memory, set when an instruction at that address is executed
+ * - an AFL-style edge map: a byte per hashed (previous address, address) pair, counting how often execution went from one to the other.
+ *   Hashing the pair into 64K buckets keeps recording to a few instructions; collisions are rare with the 4K addresses a chip-8 has
+ * The cpu only records into a CoverageMap when built with CHIP8_COVERAGE (see Cpu::CoveragePolicy). Otherwise it holds a NoCoverage,
+ * whose recording compiles to nothing.
+ */
+namespace Chip8 {
+class CoverageMap {
+   public:
+    static const bool IS_ENABLED = true;
+    static const int NUM_ADDRESSES = 4096;
+    static const int NUM_EDGES = 1 << 16;
+
+    CoverageMap();
+
+    void recordExecution(uint16_t address) {
+        if (address < NUM_ADDRESSES) {
+            addressBits[address / BITS_PER_WORD] |= (uint64_t)1 << (address % BITS_PER_WORD);
+        }
+        // like AFL, the previous location is shifted so that A -> B and B -> A (and A -> A and B -> B) land in different buckets
+        uint16_t location = hashAddress(address);
+        edgeHitCounts[location ^ previousLocation]++;
+        previousLocation = location >> 1;
+    }
+
+    bool isAddressCovered(uint16_t address) const {
+        return address < NUM_ADDRESSES && ((addressBits[address / BITS_PER_WORD] >> (address % BITS_PER_WORD)) & 1) != 0;
+    }
+
+    unsigned int getNumCoveredAddresses() const;
+
+    /**
+     * @return how many times each hashed edge was taken, wrapping around at 256 like AFL's counters
+     */
+    const uint8_t *getEdgeHitCounts() const { return edgeHitCounts.data(); }
+
+    unsigned int getNumCoveredEdges() const;
+
+    /**
+     * Clears both maps, and forgets the previous address so the next execution doesn't record an edge into it
+     */
+    void reset();
+
+   private:
+    static const int BITS_PER_WORD = 64;
+
+    uint64_t addressBits[NUM_ADDRESSES / BITS_PER_WORD];
+    std::vector<uint8_t> edgeHitCounts;
+    uint16_t previousLocation = 0;
+
+    // spreads the 12 bits of an address over all 16 bits of an edge index (Knuth's multiplicative hash)
+    static uint16_t hashAddress(uint16_t address) { return (uint16_t)(address * 40503u); }
+};
+
+/**
+ * The coverage a cpu keeps when coverage isn't compiled in: recording does nothing, and nothing is ever covered
+ */
+class NoCoverage {
+   public:
+    static const bool IS_ENABLED = false;
+
+    void recordExecution(uint16_t) {}
+
+    bool isAddressCovered(uint16_t) const { return false; }
+
+    void reset() {}
+};
+}
+
+#endif  // CHIP_8_COVERAGEMAP_H
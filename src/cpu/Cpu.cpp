@@ -1,4 +1,5 @@
 #include "Cpu.h"
+#include <algorithm>
 #include <sstream>
 #include "../constants/Constants.h"
 #include "../constants/OpcodeBitshifts.h"
@@ -8,21 +9,15 @@
 namespace Chip8 {
 Cpu::Cpu(Memory &memory, IDisplay &display, IInputController &inputController)
     : memory(memory), display(display), inputController(inputController) {
-    programCounter = Constants::MEMORY_PROGRAM_START_LOCATION;
-    indexRegister = 0;
-    currStackLevel = 0;
-
-    for (int i = 0; i < NUM_GENERAL_PURPOSE_REGISTERS; i++) {
-        generalPurposeRegisters[i] = 0;
-    }
-
-    delayTimerRegister = 0;
-    soundTimerRegister = 0;
+    reset();
+    setRandomSeed(RandomUtil::getTimeSeed());
 }
 
-void Cpu::emulateCycle() {
+void Cpu::emulateCycle() { executeOpcodeAt(programCounter, fetchOpCode()); }
+
+void Cpu::executeOpcodeAt(uint16_t address, uint16_t opcode) {
+    coverage.recordExecution(address);
     updateTimers();
-    uint16_t opcode = fetchOpCode();
 
     // note that not every instruction increments the program counter by 2
     // for example, a jump instruction avoids this, but since instructions are executed after this increment
@@ -31,12 +26,12 @@ void Cpu::emulateCycle() {
     // implementations, we have to "reverse" this increment by subtracting 2 from the program counter.
     // This happens on very few instructions, so it is better to increment here to avoid the excessive code duplication
     // of updating the program counter in every instruction implementation
-    programCounter += DEFAULT_NUM_INSTRUCTIONS_PER_CYCLE;
+    programCounter = address + DEFAULT_NUM_INSTRUCTIONS_PER_CYCLE;
 
     decodeAndExecuteOpcode(opcode);
 }
 
-uint16_t Cpu::fetchOpCode() {
+uint16_t Cpu::fetchOpCode() const {
     // use bit shifting to concatenate the contents of two 8-bit memory addresses to combine them into one 16-bit op-code
     // note that one opcode is two program instructions from memory
     return memory.getDataAtAddress(programCounter) << Constants::BITS_IN_BYTE | memory.getDataAtAddress(programCounter + 1);
@@ -66,15 +61,36 @@ void Cpu::executeOpcodeBeginningWithZero(uint16_t opcode) {
     switch (opcode) {
         case Opcodes::CLEAR_DISPLAY:
             display.clearScreen();
-            display.updateScreen();
+            updateScreen();
             return;
         case Opcodes::RETURN_FROM_SUBROUTINE:
             executeReturnFromSubroutineOpcode();
             return;
-        default:
-            throw InstructionUnimplementedException(
-                "Opcode unimplemented. If you were trying to call the RCA 1802 program, this is intentionally unimplemented");
+        case Opcodes::SCROLL_RIGHT:
+            display.scrollRight(HORIZONTAL_SCROLL_NUM_PIXELS);
+            updateScreen();
+            return;
+        case Opcodes::SCROLL_LEFT:
+            display.scrollLeft(HORIZONTAL_SCROLL_NUM_PIXELS);
+            updateScreen();
+            return;
+        case Opcodes::LOW_RESOLUTION:
+            display.setHighResolution(false);
+            updateScreen();
+            return;
+        case Opcodes::HIGH_RESOLUTION:
+            display.setHighResolution(true);
+            updateScreen();
+            return;
     }
+    // 0x00CN is the only one with an operand
+    if ((opcode & OpcodeBitmasks::FIRST_THREE_NIBBLES) == Opcodes::SCROLL_DOWN) {
+        display.scrollDown(opcode & OpcodeBitmasks::LAST_NIBBLE);
+        updateScreen();
+        return;
+    }
+    throw InstructionUnimplementedException(
+        "Opcode unimplemented. If you were trying to call the RCA 1802 program, this is intentionally unimplemented");
 }
 
 void Cpu::executeReturnFromSubroutineOpcode() {
@@ -253,7 +269,7 @@ void Cpu::executeJumpToAddressPlusRegisterOpcode(uint16_t opcode) {
 
 void Cpu::executeRandomNumberOpcode(uint16_t opcode) {
     int registerNumberX = getSecondNibbleFromOpcode(opcode);
-    generalPurposeRegisters[registerNumberX] = (uint8_t)(opcode & OpcodeBitmasks::LAST_BYTE) & RandomUtil::getRandomNumber();
+    generalPurposeRegisters[registerNumberX] = (uint8_t)(opcode & OpcodeBitmasks::LAST_BYTE) & RandomUtil::getRandomNumber(randomNumberState);
 }
 
 void Cpu::executeDrawSpriteOpcode(uint16_t opcode) {
@@ -263,16 +279,27 @@ void Cpu::executeDrawSpriteOpcode(uint16_t opcode) {
     int coordinateX = generalPurposeRegisters[registerNumberX];
     int coordinateY = generalPurposeRegisters[registerNumberY];
     unsigned int spriteHeight = opcode & OpcodeBitmasks::LAST_NIBBLE;
+    int spriteWidth = IDisplay::SPRITE_WIDTH;
+    // a sprite with no height is the SUPER-CHIP's 16x16 sprite, which takes 2 bytes a row
+    if (spriteHeight == 0) {
+        spriteHeight = BIG_SPRITE_SIZE;
+        spriteWidth = BIG_SPRITE_SIZE;
+    }
+    int numBytesPerRow = spriteWidth / Constants::BITS_IN_BYTE;
 
     // default value for the carry register if no pixels are toggled off
     generalPurposeRegisters[INDEX_CARRY_REGISTER] = 0;
 
     for (unsigned int height = 0; height < spriteHeight; height++) {
-        uint8_t pixelRow = memory.getDataAtAddress(indexRegister + height);
-        // a bitmask that in binary looks like 10000000
+        uint16_t pixelRow = 0;
+        for (int byteNumber = 0; byteNumber < numBytesPerRow; byteNumber++) {
+            pixelRow = (uint16_t)(pixelRow << Constants::BITS_IN_BYTE |
+                                  memory.getDataAtAddress(indexRegister + height * numBytesPerRow + byteNumber));
+        }
+        // a bitmask with only the leftmost pixel's bit set, which in binary looks like 10000000 for a standard sprite
         // we use this to read the values of the bits in the pixelRow from left to right
-        uint8_t bitmask = 0x80;
-        for (int width = 0; width < IDisplay::SPRITE_WIDTH; width++) {
+        uint16_t bitmask = (uint16_t)(1 << (spriteWidth - 1));
+        for (int width = 0; width < spriteWidth; width++) {
             // shift the bitmask over by one each iteration to evaluate the next bit of the pixelRow on the next loop iteration
             // ex: on the second iteration, (bitmask >> width) will be 01000000 and can be used to observe the value of the 2nd bit of the
             // pixelRow
@@ -289,9 +316,18 @@ void Cpu::executeDrawSpriteOpcode(uint16_t opcode) {
             }
         }
     }
-    display.updateScreen();
+    updateScreen();
 }
 
+void Cpu::updateScreen() {
+    numScreenUpdates++;
+    if (isPresentingScreenUpdates) {
+        display.updateScreen();
+    }
+}
+
+void Cpu::setPresentingScreenUpdates(bool isPresentingScreenUpdates) { this->isPresentingScreenUpdates = isPresentingScreenUpdates; }
+
 void Cpu::executeKeyPressedSkipOpcodes(uint16_t opcode) {
     // Note this method implements two similar but different opcodes
     int registerNumberX = getSecondNibbleFromOpcode(opcode);
@@ -333,6 +369,9 @@ void Cpu::delegateToFOpcodeImplementations(uint16_t opcode) {
         case Opcodes::SET_SPRITE_LOCATION:
             executeSetSpriteLocationOpcode(opcode);
             break;
+        case Opcodes::SET_BIG_SPRITE_LOCATION:
+            executeSetBigSpriteLocationOpcode(opcode);
+            break;
         case Opcodes::CONVERT_TO_BCD:
             executeConvertToBCDOpcode(opcode);
             break;
@@ -342,6 +381,12 @@ void Cpu::delegateToFOpcodeImplementations(uint16_t opcode) {
         case Opcodes::REGISTER_LOAD:
             executeRegisterLoadOpcode(opcode);
             break;
+        case Opcodes::FLAG_REGISTER_DUMP:
+            executeFlagRegisterDumpOpcode(opcode);
+            break;
+        case Opcodes::FLAG_REGISTER_LOAD:
+            executeFlagRegisterLoadOpcode(opcode);
+            break;
         default:
             throw InstructionUnimplementedException("Specified opcode beginning with F doesn't exist");
     }
@@ -390,6 +435,12 @@ void Cpu::executeSetSpriteLocationOpcode(uint16_t opcode) {
     indexRegister = Constants::MEMORY_FONT_START_LOCATION + (characterNumber * Constants::FONT_NUM_BYTES_PER_CHARACTER);
 }
 
+void Cpu::executeSetBigSpriteLocationOpcode(uint16_t opcode) {
+    int registerNumber = getSecondNibbleFromOpcode(opcode);
+    uint8_t characterNumber = generalPurposeRegisters[registerNumber];
+    indexRegister = Constants::MEMORY_BIG_FONT_START_LOCATION + (characterNumber * Constants::BIG_FONT_NUM_BYTES_PER_CHARACTER);
+}
+
 void Cpu::executeConvertToBCDOpcode(uint16_t opcode) {
     int registerNumber = getSecondNibbleFromOpcode(opcode);
     uint8_t numberToConvert = generalPurposeRegisters[registerNumber];
@@ -424,6 +475,24 @@ void Cpu::executeRegisterLoadOpcode(uint16_t opcode) {
     }
 }
 
+void Cpu::executeFlagRegisterDumpOpcode(uint16_t opcode) {
+    unsigned int registerNumber = getSecondNibbleFromOpcode(opcode);
+    checkFlagRegisterNumber(registerNumber);
+    std::copy(generalPurposeRegisters, generalPurposeRegisters + registerNumber + 1, flagRegisters);
+}
+
+void Cpu::executeFlagRegisterLoadOpcode(uint16_t opcode) {
+    unsigned int registerNumber = getSecondNibbleFromOpcode(opcode);
+    checkFlagRegisterNumber(registerNumber);
+    std::copy(flagRegisters, flagRegisters + registerNumber + 1, generalPurposeRegisters);
+}
+
+void Cpu::checkFlagRegisterNumber(unsigned int registerNumber) const {
+    if (registerNumber >= NUM_FLAG_REGISTERS) {
+        throw IndexOutOfBoundsException("There are only 8 flag registers, so only V0 through V7 can be saved to them or loaded from them");
+    }
+}
+
 void Cpu::updateTimers() {
     if (delayTimerRegister > 0) {
         delayTimerRegister--;
@@ -447,4 +516,54 @@ uint16_t Cpu::getIndexRegisterValue() const { return indexRegister; }
 uint8_t Cpu::getDelayTimerValue() const { return delayTimerRegister; }
 
 uint8_t Cpu::getSoundTimerValue() const { return soundTimerRegister; }
+
+unsigned long Cpu::getNumScreenUpdates() const { return numScreenUpdates; }
+
+CpuState Cpu::getState() const {
+    CpuState state;
+    std::copy(generalPurposeRegisters, generalPurposeRegisters + NUM_GENERAL_PURPOSE_REGISTERS, state.registers);
+    state.indexRegister = indexRegister;
+    state.programCounter = programCounter;
+    state.delayTimer = delayTimerRegister;
+    state.soundTimer = soundTimerRegister;
+    std::copy(stack, stack + NUM_STACK_LEVELS, state.stack);
+    state.stackLevel = currStackLevel;
+    state.randomNumberState = randomNumberState;
+    std::copy(flagRegisters, flagRegisters + NUM_FLAG_REGISTERS, state.flagRegisters);
+    return state;
+}
+
+void Cpu::setState(const CpuState &state) {
+    std::copy(state.registers, state.registers + NUM_GENERAL_PURPOSE_REGISTERS, generalPurposeRegisters);
+    indexRegister = state.indexRegister;
+    programCounter = state.programCounter;
+    delayTimerRegister = state.delayTimer;
+    soundTimerRegister = state.soundTimer;
+    std::copy(state.stack, state.stack + NUM_STACK_LEVELS, stack);
+    currStackLevel = state.stackLevel;
+    randomNumberState = state.randomNumberState;
+    std::copy(state.flagRegisters, state.flagRegisters + NUM_FLAG_REGISTERS, flagRegisters);
+}
+
+void Cpu::reset() {
+    std::fill(generalPurposeRegisters, generalPurposeRegisters + NUM_GENERAL_PURPOSE_REGISTERS, 0);
+    indexRegister = 0;
+    programCounter = Constants::MEMORY_PROGRAM_START_LOCATION;
+    delayTimerRegister = 0;
+    soundTimerRegister = 0;
+    std::fill(stack, stack + NUM_STACK_LEVELS, 0);
+    currStackLevel = 0;
+    std::fill(flagRegisters, flagRegisters + NUM_FLAG_REGISTERS, 0);
+}
+
+void Cpu::setRandomSeed(uint32_t seed) { randomNumberState = RandomUtil::getInitialState(seed); }
+
+const Cpu::CoveragePolicy &Cpu::getCoverage() const { return coverage; }
+
+void Cpu::resetCoverage() { coverage.reset(); }
+
+bool Cpu::isNextInstructionWaitForKeyPress() const {
+    uint16_t opcode = fetchOpCode();
+    return getFirstNibbleFromOpcode(opcode) == 0xF && (opcode & OpcodeBitmasks::LAST_BYTE) == Opcodes::BLOCK_KEY_PRESSES;
+}
 }
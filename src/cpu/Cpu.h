@@ -8,24 +8,43 @@
 #include "../storage/Memory.h"
 #include "../subsystems/display/IDisplay.h"
 #include "../subsystems/input/IInputController.h"
+#include "CoverageMap.h"
 
 /**
- * The cpu is the heart of the emulator, and implements every opcode in the chip-8 specification
+ * The cpu is the heart of the emulator, and implements every opcode in the chip-8 specification, along with the SUPER-CHIP's extensions
+ * (its high resolution screen, scrolling, 16x16 sprites, big font and flag registers)
  * It executes opcodes, keeps track of and updates the chip-8 system state accordingly, and calls functionality where necessary of other
  * components
  * (ex: IDisplay) that are passed in as dependencies.
  */
 namespace Chip8 {
+class CpuState;
+
 class Cpu {
    public:
     static const int INDEX_CARRY_REGISTER = 15;
     static const uint16_t DEFAULT_NUM_INSTRUCTIONS_PER_CYCLE = 2;
     static const int NUM_GENERAL_PURPOSE_REGISTERS = 16;
+    static const int NUM_STACK_LEVELS = 16;
+    // the SUPER-CHIP's "RPL user flags", which 0xFX75 and 0xFX85 save registers to and load them from
+    static const int NUM_FLAG_REGISTERS = 8;
+
+#ifdef CHIP8_COVERAGE
+    typedef CoverageMap CoveragePolicy;
+#else
+    typedef NoCoverage CoveragePolicy;
+#endif
 
     Cpu(Memory &memory, IDisplay &display, IInputController &inputController);
 
     void emulateCycle();
 
+    /**
+     * Executes an opcode that was already fetched from address, exactly as emulateCycle() would have if the program counter was at address.
+     * This lets engines that don't fetch and decode every opcode themselves (ex: recompiled code) fall back to the interpreter.
+     */
+    void executeOpcodeAt(uint16_t address, uint16_t opcode);
+
     uint16_t getProgramCounter() const;
 
     uint8_t getRegisterValue(unsigned int registerNumber) const;
@@ -36,19 +55,66 @@ class Cpu {
 
     uint8_t getSoundTimerValue() const;
 
+    /**
+     * @return the number of times the cpu has asked the display to update the screen, so callers can tell when a new frame was presented
+     */
+    unsigned long getNumScreenUpdates() const;
+
+    /**
+     * @return true if the instruction at the program counter is 0xFX0A, which blocks until a key is pressed
+     */
+    bool isNextInstructionWaitForKeyPress() const;
+
+    CpuState getState() const;
+
+    void setState(const CpuState &state);
+
+    /**
+     * Puts every register back the way it was when the cpu was created: all zero, with an empty stack and the program counter at the
+     * start of the program. The random number state is left alone, so call setRandomSeed() afterwards for a repeatable run
+     */
+    void reset();
+
+    /**
+     * While this is off, the cpu still counts screen updates, but doesn't pass them on to the display. This lets the emulator decide which
+     * frames are presented (ex: only the ones it ran ahead to)
+     */
+    void setPresentingScreenUpdates(bool isPresentingScreenUpdates);
+
+    /**
+     * Restarts the random numbers returned by 0xCXNN from seed. A cpu starts out seeded with the current time
+     */
+    void setRandomSeed(uint32_t seed);
+
+    /**
+     * @return the instructions executed since the cpu was created or the coverage was last reset. Coverage is only recorded in builds
+     * with CHIP8_COVERAGE defined (see CoverageMap)
+     */
+    const CoveragePolicy &getCoverage() const;
+
+    void resetCoverage();
+
    private:
+    // recompiled code operates on the cpu's registers directly
+    friend class RecompilerContext;
+
     // this includes the "carry-flag" register VF
-    static const int NUM_STACK_LEVELS = 16;
     static const int NUM_OP_CODE_IMPLEMENTATIONS = 16;
     static const int NUM_ARITHMETIC_OPCODE_IMPLEMENTATIONS = 16;
     static const uint8_t BITMASK_REGISTER_FIRST_BIT = 0x80;
     static const uint8_t BITSHIFT_REGISTER_FIRST_TO_LAST = 7;
+    // the width and height of the sprites 0xDXY0 draws
+    static const int BIG_SPRITE_SIZE = 16;
+    // how far 0x00FB and 0x00FC scroll the screen
+    static const int HORIZONTAL_SCROLL_NUM_PIXELS = 4;
 
     uint8_t generalPurposeRegisters[NUM_GENERAL_PURPOSE_REGISTERS];
     uint16_t indexRegister;
     uint16_t programCounter;
     uint8_t delayTimerRegister;
     uint8_t soundTimerRegister;
+    uint32_t randomNumberState;
+    uint8_t flagRegisters[NUM_FLAG_REGISTERS];
 
     Memory &memory;
     IDisplay &display;
@@ -61,7 +127,14 @@ class Cpu {
     uint16_t stack[NUM_STACK_LEVELS];
     int currStackLevel = 0;
 
-    uint16_t fetchOpCode();
+    unsigned long numScreenUpdates = 0;
+    bool isPresentingScreenUpdates = true;
+
+    CoveragePolicy coverage;
+
+    uint16_t fetchOpCode() const;
+
+    void updateScreen();
 
     void decodeAndExecuteOpcode(uint16_t opcode);
 
@@ -136,7 +209,7 @@ class Cpu {
     // 0xCNXX
     void executeRandomNumberOpcode(uint16_t opcode);
 
-    // 0xDXYN
+    // 0xDXYN, and 0xDXY0, which draws a 16x16 sprite
     void executeDrawSpriteOpcode(uint16_t opcode);
 
     // 0xEX9E and 0xEXA1
@@ -162,6 +235,9 @@ class Cpu {
     // 0xFX29
     void executeSetSpriteLocationOpcode(uint16_t opcode);
 
+    // 0xFX30
+    void executeSetBigSpriteLocationOpcode(uint16_t opcode);
+
     // 0xFX33
     void executeConvertToBCDOpcode(uint16_t opcode);
 
@@ -171,6 +247,17 @@ class Cpu {
     // 0xFX65
     void executeRegisterLoadOpcode(uint16_t opcode);
 
+    // 0xFX75
+    void executeFlagRegisterDumpOpcode(uint16_t opcode);
+
+    // 0xFX85
+    void executeFlagRegisterLoadOpcode(uint16_t opcode);
+
+    /**
+     * @throws IndexOutOfBoundsException if registers 0 through registerNumber can't all be saved to flag registers
+     */
+    void checkFlagRegisterNumber(unsigned int registerNumber) const;
+
     typedef void (Cpu::*OpcodeMemberFunction)(uint16_t opcode);
 
     // an array of function pointers that point to functions that implement an opcode or opcodes where the first nibble
@@ -218,6 +305,22 @@ class Cpu {
 
     void updateTimers();
 };
+
+/**
+ * A copy of every register of a Cpu, including its stack
+ */
+class CpuState {
+   public:
+    uint8_t registers[Cpu::NUM_GENERAL_PURPOSE_REGISTERS];
+    uint16_t indexRegister;
+    uint16_t programCounter;
+    uint8_t delayTimer;
+    uint8_t soundTimer;
+    uint16_t stack[Cpu::NUM_STACK_LEVELS];
+    int stackLevel;
+    uint32_t randomNumberState;
+    uint8_t flagRegisters[Cpu::NUM_FLAG_REGISTERS];
+};
 }
 
 #endif  // CHIP_8_CPU_H
@@ -0,0 +1,90 @@
+#include "InstructionTrace.h"
+#include <algorithm>
+#include "../exceptions/IOException.h"
+#include "../io/BinaryStream.h"
+
+namespace Chip8 {
+uint8_t TraceRecord::getChangedRegisterNumber() const {
+    for (uint8_t registerNumber = 0; registerNumber < NUM_REGISTERS; registerNumber++) {
+        if (changedRegisters & (1 << registerNumber)) {
+            return registerNumber;
+        }
+    }
+    return NO_REGISTER_CHANGED;
+}
+
+bool TraceRecord::operator==(const TraceRecord &other) const {
+    return cycleNumber == other.cycleNumber && programCounter == other.programCounter && opcode == other.opcode &&
+           indexRegister == other.indexRegister && changedRegisters == other.changedRegisters &&
+           changedRegisterValue == other.changedRegisterValue;
+}
+
+bool TraceRecord::operator!=(const TraceRecord &other) const { return !(*this == other); }
+
+InstructionTrace::InstructionTrace(size_t capacity) {
+    size_t roundedCapacity = 1;
+    while (roundedCapacity < capacity) {
+        roundedCapacity <<= 1;
+    }
+    capacityMask = roundedCapacity - 1;
+}
+
+std::vector<TraceRecord> InstructionTrace::getRecords() const {
+    uint64_t numKept = std::min(numRecorded, (uint64_t)capacityMask + 1);
+    std::vector<TraceRecord> oldestFirst;
+    oldestFirst.reserve(numKept);
+    for (uint64_t i = numRecorded - numKept; i < numRecorded; i++) {
+        oldestFirst.push_back(records[i & capacityMask]);
+    }
+    return oldestFirst;
+}
+
+uint64_t InstructionTrace::getNumRecorded() const { return numRecorded; }
+
+void InstructionTrace::clear() { numRecorded = 0; }
+
+void InstructionTrace::save(std::ostream &output) const {
+    std::vector<TraceRecord> oldestFirst = getRecords();
+    BinaryStream::writeInteger(output, FILE_MAGIC, sizeof(uint32_t));
+    BinaryStream::writeInteger(output, FILE_VERSION, sizeof(uint16_t));
+    BinaryStream::writeVariableLengthInteger(output, oldestFirst.size());
+    // cycles are nearly always consecutive, so each is written as the distance from the previous one
+    uint64_t previousCycle = 0;
+    for (const TraceRecord &record : oldestFirst) {
+        BinaryStream::writeVariableLengthInteger(output, record.cycleNumber - previousCycle);
+        BinaryStream::writeInteger(output, record.programCounter, sizeof(uint16_t));
+        BinaryStream::writeInteger(output, record.opcode, sizeof(uint16_t));
+        BinaryStream::writeInteger(output, record.indexRegister, sizeof(uint16_t));
+        BinaryStream::writeInteger(output, record.changedRegisters, sizeof(uint16_t));
+        if (record.changedRegisters != 0) {
+            BinaryStream::writeInteger(output, record.changedRegisterValue, sizeof(uint8_t));
+        }
+        previousCycle = record.cycleNumber;
+    }
+    if (!output) {
+        throw IOException("Could not write the instruction trace");
+    }
+}
+
+std::vector<TraceRecord> InstructionTrace::load(std::istream &input) {
+    if (BinaryStream::readInteger(input, sizeof(uint32_t)) != FILE_MAGIC ||
+        BinaryStream::readInteger(input, sizeof(uint16_t)) != FILE_VERSION) {
+        throw IOException("Not an instruction trace, or a trace from another version of the emulator");
+    }
+    uint64_t numRecords = BinaryStream::readVariableLengthInteger(input);
+    std::vector<TraceRecord> records;
+    uint64_t cycleNumber = 0;
+    for (uint64_t i = 0; i < numRecords; i++) {
+        TraceRecord record;
+        cycleNumber += BinaryStream::readVariableLengthInteger(input);
+        record.cycleNumber = cycleNumber;
+        record.programCounter = (uint16_t)BinaryStream::readInteger(input, sizeof(uint16_t));
+        record.opcode = (uint16_t)BinaryStream::readInteger(input, sizeof(uint16_t));
+        record.indexRegister = (uint16_t)BinaryStream::readInteger(input, sizeof(uint16_t));
+        record.changedRegisters = (uint16_t)BinaryStream::readInteger(input, sizeof(uint16_t));
+        record.changedRegisterValue = record.changedRegisters == 0 ? 0 : (uint8_t)BinaryStream::readInteger(input, sizeof(uint8_t));
+        records.push_back(record);
+    }
+    return records;
+}
+}
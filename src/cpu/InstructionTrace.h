@@ -0,0 +1,93 @@
+#ifndef CHIP_8_INSTRUCTIONTRACE_H
+#define CHIP_8_INSTRUCTIONTRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+/**
+ * The most recent instructions the emulator executed, kept in a fixed-size ring so tracing can stay on for a whole session.
+ * Traces are saved in a compact binary format (about 10 bytes per instruction), which chip_8_trace decodes, and diffs against the trace
+ * of another build or engine to find the first instruction where the two desync.
+ */
+namespace Chip8 {
+class TraceRecord {
+   public:
+    static const uint8_t NO_REGISTER_CHANGED = 0xFF;
+    static const uint8_t NUM_REGISTERS = 16;
+
+    // as counted by Chip8Emulator::getNumCyclesExecuted()
+    uint64_t cycleNumber;
+    uint16_t programCounter;
+    uint16_t opcode;
+    // the index register after the instruction, or before it if it faulted
+    uint16_t indexRegister;
+    // a bit per general purpose register the instruction changed
+    uint16_t changedRegisters;
+    // the new value of the lowest numbered register that changed, if any did
+    uint8_t changedRegisterValue;
+
+    /**
+     * @return the lowest numbered register the instruction changed, or NO_REGISTER_CHANGED
+     */
+    uint8_t getChangedRegisterNumber() const;
+
+    bool operator==(const TraceRecord &other) const;
+
+    bool operator!=(const TraceRecord &other) const;
+};
+
+class InstructionTrace {
+   public:
+    static const size_t DEFAULT_CAPACITY = 1 << 16;
+
+    /**
+     * @param capacity the number of instructions kept, rounded up to a power of 2. The ring is only allocated once the first instruction
+     * is recorded, so an emulator that never traces doesn't pay for it
+     */
+    explicit InstructionTrace(size_t capacity = DEFAULT_CAPACITY);
+
+    void record(const TraceRecord &record) {
+        if (records.empty()) {
+            records.resize(capacityMask + 1);
+        }
+        records[numRecorded & capacityMask] = record;
+        numRecorded++;
+    }
+
+    /**
+     * @return the instructions still in the ring, oldest first
+     */
+    std::vector<TraceRecord> getRecords() const;
+
+    /**
+     * @return the number of instructions recorded since the trace was created or cleared, including those no longer in the ring
+     */
+    uint64_t getNumRecorded() const;
+
+    void clear();
+
+    /**
+     * Writes the instructions still in the ring
+     */
+    void save(std::ostream &output) const;
+
+    /**
+     * @throws IOException if input doesn't contain a trace
+     */
+    static std::vector<TraceRecord> load(std::istream &input);
+
+   private:
+    // the characters "C8T1" when written in little endian
+    static const uint32_t FILE_MAGIC = 0x31543843;
+    static const int FILE_VERSION = 1;
+
+    std::vector<TraceRecord> records;
+    size_t capacityMask;
+    uint64_t numRecorded = 0;
+};
+}
+
+#endif  // CHIP_8_INSTRUCTIONTRACE_H
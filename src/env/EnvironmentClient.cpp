@@ -0,0 +1,49 @@
+#include "EnvironmentClient.h"
+#include <thread>
+#include "../exceptions/InitializationException.h"
+#include "../utils/FutexUtil.h"
+
+namespace Chip8 {
+EnvironmentClient::EnvironmentClient(const std::string &segmentName)
+    : segment(segmentName, sizeof(SharedEnvironmentState), SharedMemorySegment::Mode::OPEN) {
+    state = static_cast<SharedEnvironmentState *>(segment.getData());
+    if (state->magic.load(std::memory_order_acquire) != SharedEnvironmentState::MAGIC ||
+        state->version != SharedEnvironmentState::VERSION) {
+        throw InitializationException("Shared memory segment " + segmentName + " was not created by a compatible chip-8 server");
+    }
+    numStepsSent = state->numStepsCompleted.load(std::memory_order_acquire);
+}
+
+const EnvironmentObservation &EnvironmentClient::step(uint16_t pressedKeys, uint16_t numFrames) {
+    return runStep({pressedKeys, numFrames, 0});
+}
+
+const EnvironmentObservation &EnvironmentClient::reset(uint16_t pressedKeys, uint16_t numFrames) {
+    return runStep({pressedKeys, numFrames, EnvironmentAction::FLAG_RESET});
+}
+
+const EnvironmentObservation &EnvironmentClient::runStep(const EnvironmentAction &action) {
+    sendAction(action);
+    numStepsSent++;
+    while (true) {
+        uint32_t numStepsCompleted = state->numStepsCompleted.load(std::memory_order_acquire);
+        if (numStepsCompleted == numStepsSent) {
+            break;
+        }
+        FutexUtil::waitWhileEqual(state->numStepsCompleted, numStepsCompleted);
+    }
+    return state->observation;
+}
+
+const EnvironmentObservation &EnvironmentClient::getObservation() const { return state->observation; }
+
+void EnvironmentClient::stopServer() { sendAction({0, 0, EnvironmentAction::FLAG_STOP}); }
+
+void EnvironmentClient::sendAction(const EnvironmentAction &action) {
+    // the queue can only be full if the server is busy working through it, so there's no need to sleep
+    while (!state->actions.tryPush(action)) {
+        std::this_thread::yield();
+    }
+    FutexUtil::wakeAll(state->actions.getWriteIndex());
+}
+}
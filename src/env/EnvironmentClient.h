@@ -0,0 +1,53 @@
+#ifndef CHIP_8_ENVIRONMENTCLIENT_H
+#define CHIP_8_ENVIRONMENTCLIENT_H
+
+#include <cstdint>
+#include <string>
+#include "SharedEnvironmentState.h"
+#include "SharedMemorySegment.h"
+
+/**
+ * The agent's side of an EnvironmentServer. Observations are read directly from the shared memory segment, so the reference step()
+ * returns is only valid until the next call to step().
+ * Only one client may be connected to a server at a time, since actions are passed through a single producer, single consumer queue.
+ */
+namespace Chip8 {
+class EnvironmentClient {
+   public:
+    /**
+     * Connects to a server that has already created the segment
+     */
+    explicit EnvironmentClient(const std::string &segmentName);
+
+    /**
+     * Holds pressedKeys (bit N for key N) down for numFrames frames, and waits for the server to publish the result
+     */
+    const EnvironmentObservation &step(uint16_t pressedKeys, uint16_t numFrames = 1);
+
+    /**
+     * Restarts the game from power-on, then does the same as step(). With numFrames 0, the observation is the game's initial state
+     */
+    const EnvironmentObservation &reset(uint16_t pressedKeys = 0, uint16_t numFrames = 0);
+
+    /**
+     * @return the most recently published observation (step 0 is the state the server started in)
+     */
+    const EnvironmentObservation &getObservation() const;
+
+    /**
+     * Asks the server to stop serving. This doesn't wait for the server to exit
+     */
+    void stopServer();
+
+   private:
+    SharedMemorySegment segment;
+    SharedEnvironmentState *state;
+    uint32_t numStepsSent;
+
+    void sendAction(const EnvironmentAction &action);
+
+    const EnvironmentObservation &runStep(const EnvironmentAction &action);
+};
+}
+
+#endif  // CHIP_8_ENVIRONMENTCLIENT_H
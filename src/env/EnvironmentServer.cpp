@@ -0,0 +1,100 @@
+#include "EnvironmentServer.h"
+#include <new>
+#include "../exceptions/IndexOutOfBoundsException.h"
+#include "../utils/FutexUtil.h"
+
+namespace Chip8 {
+EnvironmentServer::EnvironmentServer(Chip8Emulator &emulator, HeadlessSubsystemManager &subsystemManager, const std::string &segmentName,
+                                     uint16_t rewardRegionStart, uint16_t rewardRegionLength)
+    : emulator(emulator),
+      subsystemManager(subsystemManager),
+      segment(segmentName, sizeof(SharedEnvironmentState), SharedMemorySegment::Mode::CREATE) {
+    if (rewardRegionLength > EnvironmentObservation::MAX_REWARD_REGION_LENGTH ||
+        rewardRegionStart + rewardRegionLength > Memory::NUM_BYTES_OF_MEMORY) {
+        throw IndexOutOfBoundsException("The reward region must be inside memory, and at most 256 bytes long");
+    }
+    state = new (segment.getData()) SharedEnvironmentState();
+    state->observation.rewardRegionStart = rewardRegionStart;
+    state->observation.rewardRegionLength = rewardRegionLength;
+    publishObservation(0);
+    state->magic.store(SharedEnvironmentState::MAGIC, std::memory_order_release);
+}
+
+void EnvironmentServer::serve() {
+    while (handleNextAction()) {
+    }
+}
+
+bool EnvironmentServer::handleNextAction() {
+    EnvironmentAction action;
+    std::atomic<uint32_t> &writeIndex = state->actions.getWriteIndex();
+    while (true) {
+        // read the index before trying to pop, so an action that is pushed after a failed pop changes it and ends the wait
+        uint32_t expectedWriteIndex = writeIndex.load(std::memory_order_acquire);
+        if (state->actions.tryPop(action)) {
+            break;
+        }
+        FutexUtil::waitWhileEqual(writeIndex, expectedWriteIndex);
+    }
+    if (action.flags & EnvironmentAction::FLAG_STOP) {
+        return false;
+    }
+    publishObservation(runStep(action));
+    return true;
+}
+
+uint8_t EnvironmentServer::runStep(const EnvironmentAction &action) {
+    ScriptedInputController &inputController = subsystemManager.getScriptedInputController();
+    for (unsigned int keyNumber = 0; keyNumber < IInputController::NUM_KEYS; keyNumber++) {
+        inputController.setKeyPressed(keyNumber, (action.pressedKeys >> keyNumber) & 1);
+    }
+    if (action.flags & EnvironmentAction::FLAG_RESET) {
+        emulator.reset();
+        numCyclesExecuted = 0;
+        hasFaulted = false;
+    }
+    if (hasFaulted) {
+        return EnvironmentObservation::FLAG_FAULTED;
+    }
+
+    uint32_t numCyclesRemaining = action.numFrames * Chip8Emulator::CYCLES_PER_FRAME;
+    while (numCyclesRemaining > 0) {
+        // with a key held down, 0xFX0A just reads it. Without one, the agent has to choose a key before the program can continue
+        if (action.pressedKeys == 0 && emulator.getCpu().isNextInstructionWaitForKeyPress()) {
+            return EnvironmentObservation::FLAG_WAITING_FOR_KEY;
+        }
+        RunResult result = emulator.runCycles(numCyclesRemaining, EmulationEvent::WAITING_FOR_KEY | EmulationEvent::FAULT);
+        numCyclesExecuted += result.numCyclesExecuted;
+        numCyclesRemaining -= result.numCyclesExecuted;
+        if (result.stopReason == StopReason::FAULT) {
+            hasFaulted = true;
+            return EnvironmentObservation::FLAG_FAULTED;
+        }
+    }
+    return 0;
+}
+
+void EnvironmentServer::publishObservation(uint8_t flags) {
+    EnvironmentObservation &observation = state->observation;
+    const Cpu &cpu = emulator.getCpu();
+    observation.stepNumber = numStepsCompleted;
+    observation.flags = flags;
+    observation.frameBuffer = subsystemManager.getHeadlessDisplay().getFrameBuffer();
+    for (int i = 0; i < Cpu::NUM_GENERAL_PURPOSE_REGISTERS; i++) {
+        observation.registers[i] = cpu.getRegisterValue(i);
+    }
+    observation.indexRegister = cpu.getIndexRegisterValue();
+    observation.programCounter = cpu.getProgramCounter();
+    observation.delayTimer = cpu.getDelayTimerValue();
+    observation.soundTimer = cpu.getSoundTimerValue();
+    observation.numCyclesExecuted = numCyclesExecuted;
+    for (uint16_t i = 0; i < observation.rewardRegionLength; i++) {
+        observation.rewardRegion[i] = emulator.getMemory().getDataAtAddress(observation.rewardRegionStart + i);
+    }
+
+    // the client only reads the observation after seeing this store, and doesn't queue its next action until it has read it
+    state->numStepsCompleted.store(numStepsCompleted, std::memory_order_release);
+    FutexUtil::wakeAll(state->numStepsCompleted);
+    numStepsCompleted++;
+}
+}
@@ -0,0 +1,54 @@
+#ifndef CHIP_8_ENVIRONMENTSERVER_H
+#define CHIP_8_ENVIRONMENTSERVER_H
+
+#include <cstdint>
+#include <string>
+#include "../Chip8.h"
+#include "../subsystems/HeadlessSubsystemManager.h"
+#include "SharedEnvironmentState.h"
+#include "SharedMemorySegment.h"
+
+/**
+ * Exposes an emulator to an agent in another process (ex: a reinforcement learning trainer) through a shared memory segment.
+ * The agent (see EnvironmentClient) queues actions, and for each one the server holds the action's keys down, runs the action's frames,
+ * and publishes the resulting screen, registers and reward region in place. A step therefore costs a couple of atomic operations and,
+ * only if either side had to sleep, a futex wake, instead of a serialized message over a pipe or socket.
+ */
+namespace Chip8 {
+class EnvironmentServer {
+   public:
+    /**
+     * Creates the shared memory segment and publishes the emulator's initial state as step 0.
+     * @param subsystemManager must be the subsystem manager the emulator was created with
+     * @param rewardRegionStart/rewardRegionLength the part of memory copied into every observation
+     */
+    EnvironmentServer(Chip8Emulator &emulator, HeadlessSubsystemManager &subsystemManager, const std::string &segmentName,
+                      uint16_t rewardRegionStart = 0, uint16_t rewardRegionLength = 0);
+
+    /**
+     * Handles actions until one with EnvironmentAction::FLAG_STOP is received
+     */
+    void serve();
+
+    /**
+     * Waits for the next action and handles it.
+     * @return false if the action asked the server to stop
+     */
+    bool handleNextAction();
+
+   private:
+    Chip8Emulator &emulator;
+    HeadlessSubsystemManager &subsystemManager;
+    SharedMemorySegment segment;
+    SharedEnvironmentState *state;
+    uint32_t numStepsCompleted = 0;
+    uint64_t numCyclesExecuted = 0;
+    bool hasFaulted = false;
+
+    uint8_t runStep(const EnvironmentAction &action);
+
+    void publishObservation(uint8_t flags);
+};
+}
+
+#endif  // CHIP_8_ENVIRONMENTSERVER_H
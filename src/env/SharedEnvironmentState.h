@@ -0,0 +1,73 @@
+#ifndef CHIP_8_SHAREDENVIRONMENTSTATE_H
+#define CHIP_8_SHAREDENVIRONMENTSTATE_H
+
+#include <atomic>
+#include <cstdint>
+#include "../cpu/Cpu.h"
+#include "../subsystems/display/FrameBuffer.h"
+#include "../utils/SpscRingBuffer.h"
+
+/**
+ * The layout of the shared memory segment used by EnvironmentServer and EnvironmentClient.
+ * Both processes map the same segment and read and write these classes in place, so nothing is ever serialized. Everything here must
+ * therefore stay free of pointers and virtual functions, and any change to the layout must bump SharedEnvironmentState::VERSION.
+ */
+namespace Chip8 {
+class EnvironmentAction {
+   public:
+    // ends the session. The server stops serving once it reads an action with this flag
+    static const uint16_t FLAG_STOP = 1 << 0;
+    // restarts the game (see Chip8Emulator::reset()) before the step's frames are run, so a new episode starts without a new server
+    static const uint16_t FLAG_RESET = 1 << 1;
+
+    // one bit per key, where bit N is set if key N is held down for the whole step
+    uint16_t pressedKeys;
+    // the number of frames (see Chip8Emulator::CYCLES_PER_FRAME) to run with the keys held down
+    uint16_t numFrames;
+    uint16_t flags;
+};
+
+class EnvironmentObservation {
+   public:
+    // the step stopped early because the program is waiting for a key, and no key was held down
+    static const uint8_t FLAG_WAITING_FOR_KEY = 1 << 0;
+    // the step stopped early because the emulator faulted (ex: on an invalid opcode). The server won't run any more cycles
+    static const uint8_t FLAG_FAULTED = 1 << 1;
+
+    static const uint16_t MAX_REWARD_REGION_LENGTH = 256;
+
+    uint32_t stepNumber;
+    uint8_t flags;
+    FrameBuffer frameBuffer;
+    uint8_t registers[Cpu::NUM_GENERAL_PURPOSE_REGISTERS];
+    uint16_t indexRegister;
+    uint16_t programCounter;
+    uint8_t delayTimer;
+    uint8_t soundTimer;
+    uint64_t numCyclesExecuted;
+    // a copy of the part of memory the agent computes its reward from (ex: where a game keeps its score)
+    uint16_t rewardRegionStart;
+    uint16_t rewardRegionLength;
+    uint8_t rewardRegion[MAX_REWARD_REGION_LENGTH];
+};
+
+class SharedEnvironmentState {
+   public:
+    static const uint32_t MAGIC = 0x45384843;  // "CH8E"
+    static const uint32_t VERSION = 2;
+    static const uint32_t ACTION_QUEUE_CAPACITY = 64;
+
+    // written last by the server, so a client never sees a partially initialized segment
+    std::atomic<uint32_t> magic{0};
+    uint32_t version = VERSION;
+
+    SpscRingBuffer<EnvironmentAction, ACTION_QUEUE_CAPACITY> actions;
+
+    // the number of steps the server has published an observation for. Clients wait on this changing, and only read the observation
+    // once it has reached the step they are waiting for
+    alignas(64) std::atomic<uint32_t> numStepsCompleted{0};
+    EnvironmentObservation observation;
+};
+}
+
+#endif  // CHIP_8_SHAREDENVIRONMENTSTATE_H
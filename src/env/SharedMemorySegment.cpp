@@ -0,0 +1,61 @@
+#include "SharedMemorySegment.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include "../exceptions/InitializationException.h"
+
+namespace Chip8 {
+SharedMemorySegment::SharedMemorySegment(const std::string &name, size_t size, Mode mode) : name(name), size(size), mode(mode) {
+    int flags = mode == Mode::CREATE ? O_RDWR | O_CREAT | O_EXCL : O_RDWR;
+    int fileDescriptor = shm_open(name.c_str(), flags, S_IRUSR | S_IWUSR);
+    if (fileDescriptor < 0) {
+        throw InitializationException("Could not open shared memory segment " + name + ": " + std::strerror(errno));
+    }
+
+    std::string error;
+    if (mode == Mode::CREATE) {
+        // new segments are zero filled
+        if (ftruncate(fileDescriptor, size) != 0) {
+            error = std::strerror(errno);
+        }
+    } else {
+        struct stat status;
+        if (fstat(fileDescriptor, &status) != 0) {
+            error = std::strerror(errno);
+        } else if ((size_t)status.st_size < size) {
+            error = "the segment is smaller than expected";
+        }
+    }
+
+    data = MAP_FAILED;
+    if (error.empty()) {
+        data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+        if (data == MAP_FAILED) {
+            error = std::strerror(errno);
+        }
+    }
+    // the mapping stays valid after the descriptor is closed
+    close(fileDescriptor);
+
+    if (!error.empty()) {
+        if (mode == Mode::CREATE) {
+            shm_unlink(name.c_str());
+        }
+        throw InitializationException("Could not map shared memory segment " + name + ": " + error);
+    }
+}
+
+SharedMemorySegment::~SharedMemorySegment() {
+    munmap(data, size);
+    if (mode == Mode::CREATE) {
+        shm_unlink(name.c_str());
+    }
+}
+
+void *SharedMemorySegment::getData() const { return data; }
+
+size_t SharedMemorySegment::getSize() const { return size; }
+}
@@ -0,0 +1,39 @@
+#ifndef CHIP_8_SHAREDMEMORYSEGMENT_H
+#define CHIP_8_SHAREDMEMORYSEGMENT_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * A POSIX shared memory segment (see shm_open()) mapped into this process for as long as the object exists.
+ * The process that creates a segment also removes its name when it is destroyed. Processes that already opened it keep their mapping.
+ */
+namespace Chip8 {
+class SharedMemorySegment {
+   public:
+    enum class Mode { CREATE, OPEN };
+
+    /**
+     * @param name must start with a '/' (ex: "/chip8_env")
+     * @param size the size to create the segment with, or the minimum size an opened segment must have
+     */
+    SharedMemorySegment(const std::string &name, size_t size, Mode mode);
+
+    ~SharedMemorySegment();
+
+    SharedMemorySegment(const SharedMemorySegment &) = delete;
+    SharedMemorySegment &operator=(const SharedMemorySegment &) = delete;
+
+    void *getData() const;
+
+    size_t getSize() const;
+
+   private:
+    std::string name;
+    size_t size;
+    Mode mode;
+    void *data;
+};
+}
+
+#endif  // CHIP_8_SHAREDMEMORYSEGMENT_H
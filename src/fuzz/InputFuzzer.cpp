@@ -0,0 +1,375 @@
+#include "InputFuzzer.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include "../analysis/Instruction.h"
+#include "../constants/Opcodes.h"
+#include "../exceptions/BaseException.h"
+#include "../exceptions/InitializationException.h"
+#include "../exceptions/InstructionUnimplementedException.h"
+
+namespace Chip8 {
+static_assert(Cpu::CoveragePolicy::IS_ENABLED, "The input fuzzer needs coverage, so it must be built with CHIP8_COVERAGE defined");
+
+// the most frames a key is held down for by a single mutation
+const uint32_t MAX_PRESS_FRAMES = 30;
+const int MAX_STACKED_MUTATIONS = 4;
+
+InputFuzzer::InputFuzzer(const std::vector<uint8_t> &rom, uint32_t numFrames)
+    : rom(rom), numFrames(numFrames), seenEdgeBuckets(CoverageMap::NUM_EDGES) {
+    if (numFrames == 0) {
+        throw InitializationException("Inputs must play for at least one frame");
+    }
+    Worker worker;
+    worker.emulator.loadGameData(rom.data(), rom.size());
+    worker.emulator.setRandomSeed(RANDOM_SEED);
+    powerOnState = worker.emulator.saveState();
+}
+
+void InputFuzzer::addSeedInput(const std::vector<KeyPress> &input) {
+    Worker worker;
+    worker.emulator.loadGameData(rom.data(), rom.size());
+    evaluate(worker, input, nullptr);
+}
+
+void InputFuzzer::fuzz(unsigned int numWorkers, double numSeconds) {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(numSeconds));
+    if (corpus.empty()) {
+        addSeedInput({});
+    }
+    if (corpus.empty()) {
+        // even pressing no keys faults, which is no reason to stop: inputs are mutated from power-on instead
+        std::shared_ptr<CorpusEntry> powerOnEntry = std::make_shared<CorpusEntry>();
+        powerOnEntry->snapshots.push_back(powerOnState);
+        std::lock_guard<std::mutex> lock(mutex);
+        corpus.push_back(powerOnEntry);
+    }
+    std::vector<std::thread> workers;
+    for (unsigned int workerNumber = 0; workerNumber < numWorkers; workerNumber++) {
+        workers.emplace_back(&InputFuzzer::runWorker, this, workerNumber, deadline);
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+void InputFuzzer::runWorker(unsigned int workerNumber, std::chrono::steady_clock::time_point deadline) {
+    // each worker has a big emulator (snapshots, save state slots), so it is kept off the thread's stack
+    std::unique_ptr<Worker> worker(new Worker());
+    worker->emulator.loadGameData(rom.data(), rom.size());
+    worker->random.seed(std::random_device()() + workerNumber);
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::shared_ptr<const CorpusEntry> parent;
+        std::shared_ptr<const CorpusEntry> other;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (corpus.empty()) {
+                return;
+            }
+            // newer entries found new coverage more recently, so they are picked a little more often
+            size_t index = worker->random() % corpus.size();
+            if (worker->random() % 2 == 0) {
+                index = std::max(index, (size_t)(worker->random() % corpus.size()));
+            }
+            parent = corpus[index];
+            other = corpus[worker->random() % corpus.size()];
+        }
+        evaluate(*worker, mutate(parent->input, other->input, worker->random), parent.get());
+    }
+}
+
+void InputFuzzer::evaluate(Worker &worker, const std::vector<KeyPress> &input, const CorpusEntry *parent) {
+    // the input plays exactly like its parent up to the first frame the held keys differ, so it resumes from the snapshot before that
+    uint32_t startFrame = 0;
+    if (parent != nullptr) {
+        std::vector<uint16_t> pressedKeys = getPressedKeysByFrame(input);
+        std::vector<uint16_t> parentPressedKeys = getPressedKeysByFrame(parent->input);
+        auto firstDifference = std::mismatch(pressedKeys.begin(), pressedKeys.end(), parentPressedKeys.begin());
+        if (firstDifference.first == pressedKeys.end()) {
+            return;
+        }
+        uint32_t firstDifferentFrame = (uint32_t)(firstDifference.first - pressedKeys.begin());
+        startFrame = std::min(firstDifferentFrame / FRAMES_PER_SNAPSHOT, (uint32_t)parent->snapshots.size() - 1) * FRAMES_PER_SNAPSHOT;
+    }
+    const EmulatorState &startState = parent == nullptr ? powerOnState : parent->snapshots[startFrame / FRAMES_PER_SNAPSHOT];
+
+    std::shared_ptr<CorpusEntry> entry = std::make_shared<CorpusEntry>();
+    entry->input = input;
+    if (parent != nullptr) {
+        entry->snapshots.assign(parent->snapshots.begin(), parent->snapshots.begin() + startFrame / FRAMES_PER_SNAPSHOT);
+    }
+    FuzzerFault fault;
+    bool isFaulted = run(worker, input, startFrame, startState, entry->snapshots, fault);
+    numExecutions++;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (isFaulted) {
+        bool isNewFault = std::none_of(faults.begin(), faults.end(), [&](const FuzzerFault &knownFault) {
+            return knownFault.kind == fault.kind && knownFault.programCounter == fault.programCounter;
+        });
+        if (isNewFault) {
+            faults.push_back(fault);
+        }
+    } else if (mergeCoverage(worker) || corpus.empty()) {
+        corpus.push_back(entry);
+    }
+}
+
+bool InputFuzzer::run(Worker &worker, const std::vector<KeyPress> &input, uint32_t startFrame, const EmulatorState &startState,
+                      std::vector<EmulatorState> &snapshots, FuzzerFault &fault) {
+    Chip8Emulator &emulator = worker.emulator;
+    ScriptedInputController &inputController = worker.subsystemManager.getScriptedInputController();
+    std::vector<uint16_t> pressedKeys = getPressedKeysByFrame(input);
+    emulator.loadState(startState);
+    emulator.resetCoverage();
+    std::fill(worker.edgeBuckets.begin(), worker.edgeBuckets.end(), 0);
+    worker.coveredAddresses.reset();
+    for (uint32_t frameNumber = startFrame; frameNumber < numFrames; frameNumber++) {
+        if (frameNumber % FRAMES_PER_SNAPSHOT == 0 && frameNumber != startFrame) {
+            collectCoverage(worker);
+            snapshots.push_back(emulator.saveState());
+        } else if (frameNumber == startFrame) {
+            snapshots.push_back(startState);
+        }
+        // the keys held for a frame take effect at the start of its run (see Chip8Emulator::run())
+        for (unsigned int keyNumber = 0; keyNumber < IInputController::NUM_KEYS; keyNumber++) {
+            inputController.setKeyPressed(keyNumber, (pressedKeys[frameNumber] >> keyNumber) & 1);
+        }
+        try {
+            // a key wait with no key held idles for the frame, like it would with a person playing
+            if (emulator.getCpu().isNextInstructionWaitForKeyPress() && pressedKeys[frameNumber] == 0) {
+                continue;
+            }
+            emulator.runFrames(1, EmulationEvent::WAITING_FOR_KEY);
+        } catch (const BaseException &e) {
+            // the program counter is past the faulting instruction, unless fetching the instruction was what faulted
+            uint16_t programCounter = emulator.getCpu().getProgramCounter();
+            const Memory &memory = emulator.getMemory();
+            uint16_t opcode = 0;
+            if (programCounter >= Instruction::SIZE_IN_BYTES && programCounter < Memory::NUM_BYTES_OF_MEMORY) {
+                opcode = (uint16_t)(memory.getDataAtAddress(programCounter - 2) << 8 | memory.getDataAtAddress(programCounter - 1));
+            }
+            if (dynamic_cast<const InstructionUnimplementedException *>(&e) != nullptr) {
+                fault.kind = FaultKind::UNIMPLEMENTED_OPCODE;
+            } else if (opcode == Opcodes::RETURN_FROM_SUBROUTINE) {
+                fault.kind = FaultKind::STACK_UNDERFLOW;
+            } else if ((opcode >> 12) == 0x2 && programCounter + 1 < Memory::NUM_BYTES_OF_MEMORY) {
+                fault.kind = FaultKind::STACK_OVERFLOW;
+            } else {
+                fault.kind = FaultKind::OUT_OF_BOUNDS_MEMORY;
+            }
+            fault.programCounter = programCounter;
+            fault.frameNumber = frameNumber;
+            fault.message = e.what();
+            fault.input = input;
+            return true;
+        }
+    }
+    collectCoverage(worker);
+    return false;
+}
+
+uint8_t InputFuzzer::getHitCountBucket(uint8_t hitCount) {
+    if (hitCount <= 3) {
+        return hitCount == 3 ? 4 : hitCount;
+    }
+    if (hitCount < 32) {
+        return hitCount < 8 ? 8 : (hitCount < 16 ? 16 : 32);
+    }
+    return hitCount < 128 ? 64 : 128;
+}
+
+void InputFuzzer::collectCoverage(Worker &worker) {
+    const CoverageMap &coverage = worker.emulator.getCpu().getCoverage();
+    const uint8_t *edgeHitCounts = coverage.getEdgeHitCounts();
+    // few edges are ever hit, so the counts are skipped over a word at a time
+    for (int edge = 0; edge < CoverageMap::NUM_EDGES; edge += sizeof(uint64_t)) {
+        uint64_t hitCounts;
+        std::memcpy(&hitCounts, edgeHitCounts + edge, sizeof(hitCounts));
+        for (int i = 0; hitCounts != 0 && i < (int)sizeof(uint64_t); i++) {
+            if (edgeHitCounts[edge + i] != 0) {
+                worker.edgeBuckets[edge + i] |= getHitCountBucket(edgeHitCounts[edge + i]);
+            }
+        }
+    }
+    for (uint16_t address = 0; address < CoverageMap::NUM_ADDRESSES; address++) {
+        if (coverage.isAddressCovered(address)) {
+            worker.coveredAddresses.set(address);
+        }
+    }
+    worker.emulator.resetCoverage();
+}
+
+bool InputFuzzer::mergeCoverage(const Worker &worker) {
+    bool isNewCoverage = (worker.coveredAddresses & ~seenAddresses).any();
+    seenAddresses |= worker.coveredAddresses;
+    for (int edge = 0; edge < CoverageMap::NUM_EDGES; edge++) {
+        isNewCoverage = isNewCoverage || (worker.edgeBuckets[edge] & ~seenEdgeBuckets[edge]) != 0;
+        seenEdgeBuckets[edge] |= worker.edgeBuckets[edge];
+    }
+    return isNewCoverage;
+}
+
+std::vector<KeyPress> InputFuzzer::mutate(const std::vector<KeyPress> &input, const std::vector<KeyPress> &other,
+                                          std::mt19937 &random) const {
+    std::vector<KeyPress> mutated = input;
+    int numMutations = 1 + random() % MAX_STACKED_MUTATIONS;
+    for (int i = 0; i < numMutations; i++) {
+        size_t index = mutated.empty() ? 0 : random() % mutated.size();
+        switch (mutated.empty() ? 0 : random() % 6) {
+            case 0:
+                mutated.push_back({(uint32_t)(random() % numFrames), 1 + (uint32_t)(random() % MAX_PRESS_FRAMES),
+                                   (uint8_t)(random() % IInputController::NUM_KEYS)});
+                break;
+            case 1:
+                mutated.erase(mutated.begin() + index);
+                break;
+            case 2: {
+                int shift = (int)(random() % (2 * MAX_PRESS_FRAMES + 1)) - (int)MAX_PRESS_FRAMES;
+                mutated[index].startFrame = (uint32_t)std::max(0, std::min((int)numFrames - 1, (int)mutated[index].startFrame + shift));
+                break;
+            }
+            case 3:
+                mutated[index].numFrames = 1 + (uint32_t)(random() % MAX_PRESS_FRAMES);
+                break;
+            case 4:
+                mutated[index].keyNumber = (uint8_t)(random() % IInputController::NUM_KEYS);
+                break;
+            default: {
+                // the start of this input up to a random frame, followed by the rest of the other input
+                uint32_t spliceFrame = (uint32_t)(random() % numFrames);
+                mutated.erase(std::remove_if(mutated.begin(), mutated.end(),
+                                             [&](const KeyPress &press) { return press.startFrame >= spliceFrame; }),
+                              mutated.end());
+                for (const KeyPress &press : other) {
+                    if (press.startFrame >= spliceFrame) {
+                        mutated.push_back(press);
+                    }
+                }
+                break;
+            }
+        }
+    }
+    std::sort(mutated.begin(), mutated.end(), [](const KeyPress &a, const KeyPress &b) { return a.startFrame < b.startFrame; });
+    return mutated;
+}
+
+std::vector<uint16_t> InputFuzzer::getPressedKeysByFrame(const std::vector<KeyPress> &input) const {
+    std::vector<uint16_t> pressedKeys(numFrames);
+    for (const KeyPress &press : input) {
+        uint64_t endFrame = std::min((uint64_t)press.startFrame + press.numFrames, (uint64_t)numFrames);
+        for (uint64_t frameNumber = press.startFrame; frameNumber < endFrame; frameNumber++) {
+            pressedKeys[frameNumber] |= (uint16_t)(1 << press.keyNumber);
+        }
+    }
+    return pressedKeys;
+}
+
+bool InputFuzzer::replay(const std::vector<KeyPress> &input, FuzzerFault &fault) {
+    std::unique_ptr<Worker> worker(new Worker());
+    worker->emulator.loadGameData(rom.data(), rom.size());
+    std::vector<EmulatorState> snapshots;
+    return run(*worker, input, 0, powerOnState, snapshots, fault);
+}
+
+const std::vector<FuzzerFault> &InputFuzzer::getFaults() const { return faults; }
+
+size_t InputFuzzer::getCorpusSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return corpus.size();
+}
+
+std::vector<std::vector<KeyPress>> InputFuzzer::getCorpusInputs() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::vector<KeyPress>> inputs;
+    for (const auto &entry : corpus) {
+        inputs.push_back(entry->input);
+    }
+    return inputs;
+}
+
+uint64_t InputFuzzer::getNumExecutions() const { return numExecutions.load(); }
+
+unsigned int InputFuzzer::getNumCoveredAddresses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return (unsigned int)seenAddresses.count();
+}
+
+std::vector<KeyPress> InputFuzzer::parseInput(std::istream &script, uint32_t numFrames) {
+    std::vector<KeyPress> input;
+    unsigned long pressStartPolls[IInputController::NUM_KEYS];
+    bool isKeyDown[IInputController::NUM_KEYS] = {};
+    for (const ScriptedKeyEvent &event : ScriptedInputController::parseScript(script)) {
+        if (event.keyNumber >= IInputController::NUM_KEYS || event.isPressed == isKeyDown[event.keyNumber]) {
+            continue;
+        }
+        isKeyDown[event.keyNumber] = event.isPressed;
+        if (event.isPressed) {
+            pressStartPolls[event.keyNumber] = event.pollNumber;
+        } else {
+            input.push_back({(uint32_t)pressStartPolls[event.keyNumber], (uint32_t)(event.pollNumber - pressStartPolls[event.keyNumber]),
+                             event.keyNumber});
+        }
+    }
+    // keys that are never released are held until the last frame the input plays
+    for (uint8_t keyNumber = 0; keyNumber < IInputController::NUM_KEYS; keyNumber++) {
+        if (isKeyDown[keyNumber] && pressStartPolls[keyNumber] < numFrames) {
+            input.push_back({(uint32_t)pressStartPolls[keyNumber], numFrames - (uint32_t)pressStartPolls[keyNumber], keyNumber});
+        }
+    }
+    std::sort(input.begin(), input.end(), [](const KeyPress &a, const KeyPress &b) { return a.startFrame < b.startFrame; });
+    return input;
+}
+
+void InputFuzzer::writeInput(std::ostream &script, const std::vector<KeyPress> &input) {
+    // the held keys can only change on a frame where a press starts or ends, so only those frames are visited
+    std::vector<std::pair<uint64_t, int>> pressBoundaries;
+    for (size_t i = 0; i < input.size(); i++) {
+        pressBoundaries.push_back({input[i].startFrame, (int)i});
+        pressBoundaries.push_back({(uint64_t)input[i].startFrame + input[i].numFrames, (int)i});
+    }
+    std::sort(pressBoundaries.begin(), pressBoundaries.end());
+    // presses of the same key can overlap, so a key is held while any of its presses are, and events are written where that changes
+    unsigned int numPressesHeld[IInputController::NUM_KEYS] = {};
+    uint16_t previousPressedKeys = 0;
+    for (size_t i = 0; i < pressBoundaries.size();) {
+        uint64_t frameNumber = pressBoundaries[i].first;
+        for (; i < pressBoundaries.size() && pressBoundaries[i].first == frameNumber; i++) {
+            const KeyPress &press = input[pressBoundaries[i].second];
+            if (press.numFrames == 0) {
+                continue;
+            }
+            if (frameNumber == press.startFrame) {
+                numPressesHeld[press.keyNumber]++;
+            } else {
+                numPressesHeld[press.keyNumber]--;
+            }
+        }
+        uint16_t pressedKeys = 0;
+        for (unsigned int keyNumber = 0; keyNumber < IInputController::NUM_KEYS; keyNumber++) {
+            pressedKeys |= (uint16_t)((numPressesHeld[keyNumber] != 0) << keyNumber);
+        }
+        for (unsigned int keyNumber = 0; keyNumber < IInputController::NUM_KEYS; keyNumber++) {
+            if (((pressedKeys ^ previousPressedKeys) >> keyNumber) & 1) {
+                script << frameNumber << " " << std::hex << keyNumber << std::dec << " " << (((pressedKeys >> keyNumber) & 1) ? "down" : "up")
+                       << "\n";
+            }
+        }
+        previousPressedKeys = pressedKeys;
+    }
+}
+
+std::string InputFuzzer::getFaultKindName(FaultKind kind) {
+    switch (kind) {
+        case FaultKind::STACK_OVERFLOW:
+            return "stack_overflow";
+        case FaultKind::STACK_UNDERFLOW:
+            return "stack_underflow";
+        case FaultKind::UNIMPLEMENTED_OPCODE:
+            return "unimplemented_opcode";
+        default:
+            return "out_of_bounds_memory";
+    }
+}
+}
@@ -0,0 +1,181 @@
+#ifndef CHIP_8_INPUTFUZZER_H
+#define CHIP_8_INPUTFUZZER_H
+
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Chip8.h"
+#include "../EmulatorState.h"
+#include "../cpu/CoverageMap.h"
+#include "../subsystems/HeadlessSubsystemManager.h"
+
+/**
+ * A coverage-guided fuzzer that treats a ROM as the target and the keys pressed while it plays as the input.
+ * Inputs are mutated, run headlessly, and kept in the corpus when they execute an address or an edge (see CoverageMap) that no input
+ * reached before. Inputs that make the ROM fault (a stack overflow or underflow, an unimplemented opcode, or an access past the end of
+ * memory) are reported once per kind of fault and address.
+ *
+ * Every input in the corpus keeps snapshots of the emulator at regular frames. A mutated input only differs from its parent from some
+ * frame on, so it is run from the parent's last snapshot before that frame instead of from power-on. Edge hit counts are bucketed
+ * separately for each stretch of frames between snapshots, so resuming partway through a game doesn't make its hit counts look new.
+ * Workers on every core share the corpus, the coverage seen so far and the faults, and each has an emulator of its own.
+ *
+ * The cpu only records coverage when built with CHIP8_COVERAGE, so this is only built into tools that link chip8_core_coverage.
+ */
+namespace Chip8 {
+
+/**
+ * A key held down from startFrame for numFrames frames
+ */
+class KeyPress {
+   public:
+    uint32_t startFrame;
+    uint32_t numFrames;
+    uint8_t keyNumber;
+};
+
+enum class FaultKind : uint8_t { STACK_OVERFLOW, STACK_UNDERFLOW, UNIMPLEMENTED_OPCODE, OUT_OF_BOUNDS_MEMORY };
+
+class FuzzerFault {
+   public:
+    FaultKind kind;
+    // the program counter when the fault was thrown, which is past the faulting instruction for most faults
+    uint16_t programCounter;
+    uint32_t frameNumber;
+    std::string message;
+    std::vector<KeyPress> input;
+};
+
+class InputFuzzer {
+   public:
+    static const uint32_t DEFAULT_NUM_FRAMES = 600;
+    static const uint32_t FRAMES_PER_SNAPSHOT = 30;
+    static const uint32_t RANDOM_SEED = 1;
+
+    /**
+     * @param rom the game, as loaded by Chip8Emulator::loadGameData()
+     * @param numFrames how many frames every input plays for
+     * @throws InitializationException if numFrames is 0
+     */
+    InputFuzzer(const std::vector<uint8_t> &rom, uint32_t numFrames = DEFAULT_NUM_FRAMES);
+
+    /**
+     * Adds an input to the corpus before fuzzing starts (ex: an input script a person wrote to get past a menu)
+     */
+    void addSeedInput(const std::vector<KeyPress> &input);
+
+    /**
+     * Fuzzes on numWorkers threads until numSeconds have passed. The corpus always starts with at least one input: the input that presses
+     * no keys, which is kept even if it faults
+     */
+    void fuzz(unsigned int numWorkers, double numSeconds);
+
+    /**
+     * Plays a single input from power-on, as the fuzzer would
+     * @param fault set to the fault the input caused, if any
+     * @return true if the input caused a fault
+     */
+    bool replay(const std::vector<KeyPress> &input, FuzzerFault &fault);
+
+    const std::vector<FuzzerFault> &getFaults() const;
+
+    size_t getCorpusSize() const;
+
+    std::vector<std::vector<KeyPress>> getCorpusInputs() const;
+
+    uint64_t getNumExecutions() const;
+
+    unsigned int getNumCoveredAddresses() const;
+
+    /**
+     * Reads an input script (see ScriptedInputController::parseScript()), counting one poll per frame
+     * @param numFrames how many frames the input plays for. Keys that are never released are held until then
+     */
+    static std::vector<KeyPress> parseInput(std::istream &script, uint32_t numFrames);
+
+    /**
+     * Writes an input as a script that parseInput() reads back, and that tools taking input scripts with one poll per frame can play
+     */
+    static void writeInput(std::ostream &script, const std::vector<KeyPress> &input);
+
+    static std::string getFaultKindName(FaultKind kind);
+
+   private:
+    class CorpusEntry {
+       public:
+        std::vector<KeyPress> input;
+        // snapshots[i] is the state at the start of frame i * FRAMES_PER_SNAPSHOT
+        std::vector<EmulatorState> snapshots;
+    };
+
+    /**
+     * The emulator and random number generator that one worker thread has to itself, and the coverage of the input it last ran
+     */
+    class Worker {
+       public:
+        HeadlessSubsystemManager subsystemManager;
+        Chip8Emulator emulator{subsystemManager};
+        std::mt19937 random;
+        // every hit count bucket each edge landed in, over all of the stretches of frames run
+        std::vector<uint8_t> edgeBuckets = std::vector<uint8_t>(CoverageMap::NUM_EDGES);
+        std::bitset<CoverageMap::NUM_ADDRESSES> coveredAddresses;
+    };
+
+    const std::vector<uint8_t> rom;
+    const uint32_t numFrames;
+    EmulatorState powerOnState;
+
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<const CorpusEntry>> corpus;
+    // like AFL, an edge counts as new coverage whenever its hit count lands in a bucket (1, 2, 3, 4-7, 8-15, ...) it never landed in
+    std::vector<uint8_t> seenEdgeBuckets;
+    std::bitset<CoverageMap::NUM_ADDRESSES> seenAddresses;
+    std::vector<FuzzerFault> faults;
+    std::atomic<uint64_t> numExecutions{0};
+
+    void runWorker(unsigned int workerNumber, std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * Plays the input from startFrame on, starting in startState.
+     * @param snapshots receives a snapshot for every FRAMES_PER_SNAPSHOT frames from startFrame on
+     * @return true if the input caused a fault
+     */
+    bool run(Worker &worker, const std::vector<KeyPress> &input, uint32_t startFrame, const EmulatorState &startState,
+             std::vector<EmulatorState> &snapshots, FuzzerFault &fault);
+
+    /**
+     * Runs an input (reusing the parent's snapshots if there is one), and keeps it if it reached new coverage or a new fault
+     */
+    void evaluate(Worker &worker, const std::vector<KeyPress> &input, const CorpusEntry *parent);
+
+    /**
+     * Adds the coverage the emulator recorded since it was last reset to the worker's coverage, then resets it
+     */
+    void collectCoverage(Worker &worker);
+
+    /**
+     * Adds the worker's coverage to the coverage seen so far. Must be called with the mutex held
+     * @return true if the worker reached any coverage that wasn't seen before
+     */
+    bool mergeCoverage(const Worker &worker);
+
+    /**
+     * Applies a few random mutations to input. other is another input from the corpus, for splicing the two together
+     */
+    std::vector<KeyPress> mutate(const std::vector<KeyPress> &input, const std::vector<KeyPress> &other, std::mt19937 &random) const;
+
+    std::vector<uint16_t> getPressedKeysByFrame(const std::vector<KeyPress> &input) const;
+
+    static uint8_t getHitCountBucket(uint8_t hitCount);
+};
+}
+
+#endif  // CHIP_8_INPUTFUZZER_H
@@ -0,0 +1,43 @@
+#include "BinaryStream.h"
+#include "../constants/Constants.h"
+#include "../exceptions/IOException.h"
+
+namespace Chip8 {
+void BinaryStream::writeInteger(std::ostream &output, uint64_t value, int numBytes) {
+    for (int i = 0; i < numBytes; i++) {
+        output.put((char)((value >> (i * Constants::BITS_IN_BYTE)) & Constants::MAX_BYTE_SIZE));
+    }
+}
+
+uint64_t BinaryStream::readInteger(std::istream &input, int numBytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < numBytes; i++) {
+        int byte = input.get();
+        if (byte == std::istream::traits_type::eof()) {
+            throw IOException("The file ends too early");
+        }
+        value |= (uint64_t)byte << (i * Constants::BITS_IN_BYTE);
+    }
+    return value;
+}
+
+void BinaryStream::writeVariableLengthInteger(std::ostream &output, uint64_t value) {
+    while (value >= VARIABLE_LENGTH_CONTINUE_BIT) {
+        output.put((char)((value & VARIABLE_LENGTH_VALUE_BITS) | VARIABLE_LENGTH_CONTINUE_BIT));
+        value >>= VARIABLE_LENGTH_BITS_PER_BYTE;
+    }
+    output.put((char)value);
+}
+
+uint64_t BinaryStream::readVariableLengthInteger(std::istream &input) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += VARIABLE_LENGTH_BITS_PER_BYTE) {
+        uint64_t byte = readInteger(input, sizeof(uint8_t));
+        value |= (byte & VARIABLE_LENGTH_VALUE_BITS) << shift;
+        if (!(byte & VARIABLE_LENGTH_CONTINUE_BIT)) {
+            return value;
+        }
+    }
+    throw IOException("The file has an integer that is too long");
+}
+}
@@ -0,0 +1,37 @@
+#ifndef CHIP_8_BINARYSTREAM_H
+#define CHIP_8_BINARYSTREAM_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+/**
+ * Reads and writes the integers of the emulator's binary files (ex: input movies). Integers are little endian, so files can be shared
+ * between machines, and can also be written with a variable length: 7 bits at a time, lowest first, with the top bit of each byte set if
+ * more bytes follow. Small numbers like the time between two events then take a single byte.
+ */
+namespace Chip8 {
+class BinaryStream {
+   public:
+    static void writeInteger(std::ostream &output, uint64_t value, int numBytes);
+
+    /**
+     * @throws IOException if input ends before numBytes bytes were read
+     */
+    static uint64_t readInteger(std::istream &input, int numBytes);
+
+    static void writeVariableLengthInteger(std::ostream &output, uint64_t value);
+
+    /**
+     * @throws IOException if input ends early, or the integer doesn't fit in 64 bits
+     */
+    static uint64_t readVariableLengthInteger(std::istream &input);
+
+   private:
+    static const uint8_t VARIABLE_LENGTH_CONTINUE_BIT = 0x80;
+    static const uint8_t VARIABLE_LENGTH_VALUE_BITS = 0x7F;
+    static const int VARIABLE_LENGTH_BITS_PER_BYTE = 7;
+};
+}
+
+#endif  // CHIP_8_BINARYSTREAM_H
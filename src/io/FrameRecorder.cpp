@@ -0,0 +1,302 @@
+#include "FrameRecorder.h"
+#include <algorithm>
+#include "../constants/Constants.h"
+#include "../exceptions/IOException.h"
+#include "../utils/FutexUtil.h"
+#include "../utils/HashUtil.h"
+#include "BinaryStream.h"
+
+namespace Chip8 {
+static const uint8_t PNG_SIGNATURE[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+static const uint8_t PNG_BIT_DEPTH = 1;
+static const uint8_t PNG_GRAYSCALE = 0;
+// a zlib header for a deflate stream with a 32KB window and no preset dictionary
+static const uint8_t ZLIB_HEADER[] = {0x78, 0x01};
+// the last deflate block of the stream, with its data stored rather than compressed
+static const uint8_t DEFLATE_FINAL_STORED_BLOCK = 0x01;
+static const uint8_t Y4M_PIXEL_ON = 0xFF;
+static const uint32_t MAX_APNG_DELAY_PART = 0xFFFF;
+
+// PNG integers are big endian, unlike the rest of the emulator's files
+static void appendBigEndian(std::vector<uint8_t> &bytes, uint32_t value, int numBytes) {
+    for (int i = numBytes - 1; i >= 0; i--) {
+        bytes.push_back((uint8_t)(value >> (i * Constants::BITS_IN_BYTE)));
+    }
+}
+
+static bool endsWith(const std::string &value, const std::string &suffix) {
+    return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+FrameRecorder::FrameRecorder(const std::string &path, Format format, uint32_t framesPerSecondNumerator,
+                             uint32_t framesPerSecondDenominator)
+    : file(path, std::ios::binary),
+      format(format),
+      framesPerSecondNumerator(framesPerSecondNumerator),
+      framesPerSecondDenominator(framesPerSecondDenominator) {
+    if (!file.is_open()) {
+        throw IOException("Could not create the video " + path);
+    }
+    encoderThread = std::thread(&FrameRecorder::encodeFrames, this);
+}
+
+FrameRecorder::~FrameRecorder() {
+    if (encoderThread.joinable()) {
+        isFinishing.store(true, std::memory_order_release);
+        numWakeUps.fetch_add(1, std::memory_order_release);
+        FutexUtil::wakeAll(numWakeUps);
+        encoderThread.join();
+    }
+}
+
+bool FrameRecorder::recordFrame(const FrameBuffer &frame) {
+    if (!frames.tryPush(frame)) {
+        numFramesDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    numWakeUps.fetch_add(1, std::memory_order_release);
+    FutexUtil::wakeAll(numWakeUps);
+    return true;
+}
+
+void FrameRecorder::finish() {
+    if (encoderThread.joinable()) {
+        isFinishing.store(true, std::memory_order_release);
+        numWakeUps.fetch_add(1, std::memory_order_release);
+        FutexUtil::wakeAll(numWakeUps);
+        encoderThread.join();
+        file.close();
+    }
+    if (!file) {
+        throw IOException("Could not write the video");
+    }
+}
+
+uint64_t FrameRecorder::getNumFramesWritten() const { return numFramesWritten.load(std::memory_order_relaxed); }
+
+uint64_t FrameRecorder::getNumFramesDropped() const { return numFramesDropped.load(std::memory_order_relaxed); }
+
+uint32_t FrameRecorder::getNumFramesQueued() const { return frames.size(); }
+
+FrameRecorder::Format FrameRecorder::getFormatForPath(const std::string &path) {
+    if (endsWith(path, ".y4m")) {
+        return Format::Y4M;
+    }
+    if (endsWith(path, ".png") || endsWith(path, ".apng")) {
+        return Format::APNG;
+    }
+    return Format::RUN_LENGTH_ENCODED;
+}
+
+void FrameRecorder::encodeFrames() {
+    writeHeader();
+    while (true) {
+        // read before popping, so a frame that is queued after the queue is found empty ends the wait below
+        uint32_t numWakeUpsSeen = numWakeUps.load(std::memory_order_acquire);
+        FrameBuffer frame;
+        while (frames.tryPop(frame)) {
+            writeFrame(frame);
+            numFramesWritten.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (isFinishing.load(std::memory_order_acquire) && frames.size() == 0) {
+            break;
+        }
+        FutexUtil::waitWhileEqual(numWakeUps, numWakeUpsSeen);
+    }
+    writeTrailer();
+    file.flush();
+}
+
+void FrameRecorder::writeHeader() {
+    switch (format) {
+        case Format::RUN_LENGTH_ENCODED:
+            BinaryStream::writeInteger(file, FILE_MAGIC, sizeof(uint32_t));
+            BinaryStream::writeInteger(file, FILE_VERSION, sizeof(uint16_t));
+            BinaryStream::writeVariableLengthInteger(file, framesPerSecondNumerator);
+            BinaryStream::writeVariableLengthInteger(file, framesPerSecondDenominator);
+            break;
+        case Format::Y4M:
+            file << "YUV4MPEG2 W" << FrameBuffer::MAX_WIDTH << " H" << FrameBuffer::MAX_HEIGHT << " F" << framesPerSecondNumerator << ":"
+                 << framesPerSecondDenominator << " Ip A1:1 Cmono\n";
+            break;
+        case Format::APNG: {
+            file.write((const char *)PNG_SIGNATURE, sizeof(PNG_SIGNATURE));
+            std::vector<uint8_t> header;
+            appendBigEndian(header, FrameBuffer::MAX_WIDTH, sizeof(uint32_t));
+            appendBigEndian(header, FrameBuffer::MAX_HEIGHT, sizeof(uint32_t));
+            // no compression method, filter method or interlacing to choose from
+            header.insert(header.end(), {PNG_BIT_DEPTH, PNG_GRAYSCALE, 0, 0, 0});
+            writeApngChunk("IHDR", header);
+            // the number of frames isn't known yet, so it is filled in by writeTrailer()
+            apngAnimationControlPosition = file.tellp();
+            writeApngChunk("acTL", getApngAnimationControl(0));
+            break;
+        }
+    }
+}
+
+void FrameRecorder::writeFrame(const FrameBuffer &frame) {
+    switch (format) {
+        case Format::RUN_LENGTH_ENCODED: {
+            encodedFrame.clear();
+            encodedFrame.push_back((uint8_t)(frame.isHighResolution != previousFrame.isHighResolution));
+            for (int y = 0; y < FrameBuffer::MAX_HEIGHT; y++) {
+                FrameBuffer::Row change = frame.rows[y] ^ previousFrame.rows[y];
+                for (int byteNumber = 0; byteNumber < BYTES_PER_ROW; byteNumber++) {
+                    encodedFrame.push_back((uint8_t)(change >> ((BYTES_PER_ROW - 1 - byteNumber) * Constants::BITS_IN_BYTE)));
+                }
+            }
+            size_t runStart = 0;
+            for (size_t i = 1; i <= encodedFrame.size(); i++) {
+                if (i == encodedFrame.size() || encodedFrame[i] != encodedFrame[runStart]) {
+                    BinaryStream::writeVariableLengthInteger(file, i - runStart);
+                    file.put((char)encodedFrame[runStart]);
+                    runStart = i;
+                }
+            }
+            previousFrame = frame;
+            break;
+        }
+        case Format::Y4M:
+            encodedFrame.assign(FrameBuffer::MAX_WIDTH * FrameBuffer::MAX_HEIGHT, 0);
+            for (int y = 0; y < FrameBuffer::MAX_HEIGHT; y++) {
+                for (int x = 0; x < FrameBuffer::MAX_WIDTH; x++) {
+                    encodedFrame[y * FrameBuffer::MAX_WIDTH + x] = frame.getScaledPixel(x, y) ? Y4M_PIXEL_ON : 0;
+                }
+            }
+            file << "FRAME\n";
+            file.write((const char *)encodedFrame.data(), encodedFrame.size());
+            break;
+        case Format::APNG: {
+            // frames last 1/fps seconds, as a fraction that must fit in 16 bits a part
+            uint32_t delayNumerator = framesPerSecondDenominator;
+            uint32_t delayDenominator = framesPerSecondNumerator;
+            while (delayNumerator > MAX_APNG_DELAY_PART || delayDenominator > MAX_APNG_DELAY_PART) {
+                delayNumerator = std::max(delayNumerator >> 1, 1u);
+                delayDenominator = std::max(delayDenominator >> 1, 1u);
+            }
+            std::vector<uint8_t> frameControl;
+            appendBigEndian(frameControl, apngSequenceNumber++, sizeof(uint32_t));
+            appendBigEndian(frameControl, FrameBuffer::MAX_WIDTH, sizeof(uint32_t));
+            appendBigEndian(frameControl, FrameBuffer::MAX_HEIGHT, sizeof(uint32_t));
+            appendBigEndian(frameControl, 0, sizeof(uint32_t));
+            appendBigEndian(frameControl, 0, sizeof(uint32_t));
+            appendBigEndian(frameControl, delayNumerator, sizeof(uint16_t));
+            appendBigEndian(frameControl, delayDenominator, sizeof(uint16_t));
+            // every frame replaces the whole image, so neither disposing of nor blending with the previous frame is needed
+            frameControl.insert(frameControl.end(), {0, 0});
+            writeApngChunk("fcTL", frameControl);
+
+            // each row starts with the type of filter applied to it, which is none
+            std::vector<uint8_t> rows;
+            for (int y = 0; y < FrameBuffer::MAX_HEIGHT; y++) {
+                rows.push_back(0);
+                for (int x = 0; x < FrameBuffer::MAX_WIDTH; x += Constants::BITS_IN_BYTE) {
+                    uint8_t pixels = 0;
+                    for (int bit = 0; bit < Constants::BITS_IN_BYTE; bit++) {
+                        pixels = (uint8_t)(pixels << 1 | (frame.getScaledPixel(x + bit, y) ? 1 : 0));
+                    }
+                    rows.push_back(pixels);
+                }
+            }
+            // the first frame is the PNG's image, and the rest are frame data chunks, which start with a sequence number
+            bool isFirstFrame = numFramesWritten.load(std::memory_order_relaxed) == 0;
+            encodedFrame.clear();
+            if (!isFirstFrame) {
+                appendBigEndian(encodedFrame, apngSequenceNumber++, sizeof(uint32_t));
+            }
+            encodedFrame.insert(encodedFrame.end(), ZLIB_HEADER, ZLIB_HEADER + sizeof(ZLIB_HEADER));
+            encodedFrame.push_back(DEFLATE_FINAL_STORED_BLOCK);
+            encodedFrame.push_back((uint8_t)rows.size());
+            encodedFrame.push_back((uint8_t)(rows.size() >> Constants::BITS_IN_BYTE));
+            encodedFrame.push_back((uint8_t)~rows.size());
+            encodedFrame.push_back((uint8_t)(~rows.size() >> Constants::BITS_IN_BYTE));
+            encodedFrame.insert(encodedFrame.end(), rows.begin(), rows.end());
+            appendBigEndian(encodedFrame, HashUtil::adler32(rows.data(), rows.size()), sizeof(uint32_t));
+            writeApngChunk(isFirstFrame ? "IDAT" : "fdAT", encodedFrame);
+            break;
+        }
+    }
+}
+
+void FrameRecorder::writeTrailer() {
+    if (format != Format::APNG) {
+        return;
+    }
+    // a PNG must have an image, so a recording without frames gets a blank one
+    if (numFramesWritten.load(std::memory_order_relaxed) == 0) {
+        writeFrame(FrameBuffer());
+        numFramesWritten.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::streampos endPosition = file.tellp();
+    file.seekp(apngAnimationControlPosition);
+    writeApngChunk("acTL", getApngAnimationControl((uint32_t)numFramesWritten.load(std::memory_order_relaxed)));
+    file.seekp(endPosition);
+    writeApngChunk("IEND", std::vector<uint8_t>());
+}
+
+void FrameRecorder::writeApngChunk(const char *type, const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> chunk;
+    appendBigEndian(chunk, (uint32_t)data.size(), sizeof(uint32_t));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    // the CRC covers the type and the data, but not the length
+    appendBigEndian(chunk, HashUtil::crc32(chunk.data() + sizeof(uint32_t), chunk.size() - sizeof(uint32_t)), sizeof(uint32_t));
+    file.write((const char *)chunk.data(), chunk.size());
+}
+
+std::vector<uint8_t> FrameRecorder::getApngAnimationControl(uint32_t numFrames) const {
+    std::vector<uint8_t> animationControl;
+    appendBigEndian(animationControl, numFrames, sizeof(uint32_t));
+    // play forever
+    appendBigEndian(animationControl, 0, sizeof(uint32_t));
+    return animationControl;
+}
+
+std::vector<FrameBuffer> FrameRecorder::load(std::istream &input) {
+    if (BinaryStream::readInteger(input, sizeof(uint32_t)) != FILE_MAGIC) {
+        throw IOException("Not a video recorded by the emulator, or one from another version of the emulator");
+    }
+    uint64_t version = BinaryStream::readInteger(input, sizeof(uint16_t));
+    if (version != FILE_VERSION && version != LOW_RESOLUTION_FILE_VERSION) {
+        throw IOException("Not a video recorded by the emulator, or one from another version of the emulator");
+    }
+    bool isLowResolutionOnly = version == LOW_RESOLUTION_FILE_VERSION;
+    int bytesPerFrame = isLowResolutionOnly ? LOW_RESOLUTION_BYTES_PER_FRAME : BYTES_PER_FRAME;
+    // a low resolution only frame has no resolution byte, and half as many bytes a row as there are now
+    int numRows = isLowResolutionOnly ? FrameBuffer::LOW_RESOLUTION_HEIGHT : FrameBuffer::MAX_HEIGHT;
+    int bytesPerRow = isLowResolutionOnly ? BYTES_PER_ROW / 2 : BYTES_PER_ROW;
+    // the frame rate
+    BinaryStream::readVariableLengthInteger(input);
+    BinaryStream::readVariableLengthInteger(input);
+    std::vector<FrameBuffer> frames;
+    FrameBuffer frame = {};
+    uint8_t changes[BYTES_PER_FRAME];
+    while (input.peek() != std::istream::traits_type::eof()) {
+        int numBytesRead = 0;
+        while (numBytesRead < bytesPerFrame) {
+            uint64_t runLength = BinaryStream::readVariableLengthInteger(input);
+            uint8_t value = (uint8_t)BinaryStream::readInteger(input, sizeof(uint8_t));
+            if (runLength == 0 || runLength > (uint64_t)(bytesPerFrame - numBytesRead)) {
+                throw IOException("The video has a frame of the wrong size");
+            }
+            for (uint64_t i = 0; i < runLength; i++) {
+                changes[numBytesRead++] = value;
+            }
+        }
+        const uint8_t *rowChanges = changes;
+        if (!isLowResolutionOnly) {
+            frame.isHighResolution = frame.isHighResolution != (changes[0] != 0);
+            rowChanges++;
+        }
+        for (int y = 0; y < numRows; y++) {
+            for (int byteNumber = 0; byteNumber < bytesPerRow; byteNumber++) {
+                FrameBuffer::Row change = rowChanges[y * bytesPerRow + byteNumber];
+                frame.rows[y] ^= change << ((BYTES_PER_ROW - 1 - byteNumber) * Constants::BITS_IN_BYTE);
+            }
+        }
+        frames.push_back(frame);
+    }
+    return frames;
+}
+}
@@ -0,0 +1,134 @@
+#ifndef CHIP_8_FRAMERECORDER_H
+#define CHIP_8_FRAMERECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../subsystems/display/FrameBuffer.h"
+#include "../utils/SpscRingBuffer.h"
+
+/**
+ * Records the frames of a session into a video file, without slowing down the thread that hands it the frames.
+ * recordFrame() copies a frame into a slot of a ring buffer that is allocated up front, so recording a frame never allocates, takes a
+ * lock or touches the file. An encoder thread of its own pops the frames and writes them to the file in order. If the encoder falls
+ * QUEUE_CAPACITY frames behind, new frames are dropped and counted rather than waited for.
+ * Videos can be written in three formats:
+ * - RUN_LENGTH_ENCODED, the emulator's own format: each frame is XORed with the one before it, and its 1025 bytes (whether the screen is
+ *   in high resolution, then 128 pixels a row, leftmost pixel in the highest bit) are stored as runs of a repeated byte, each a variable
+ *   length count (see BinaryStream) and the byte. An unchanged frame takes 3 bytes. load() reads it back.
+ * - Y4M, uncompressed 8-bit grayscale that ffmpeg and most video tools read directly (ex: ffmpeg -i session.y4m session.mp4)
+ * - APNG, an animated 1-bit grayscale PNG that browsers play. Its image data is stored uncompressed, since the emulator has no deflate
+ *   compressor, which costs about 1.1KB a frame.
+ * Y4M and APNG videos are always 128x64, with low resolution frames scaled up, since neither format can change size partway through.
+ */
+namespace Chip8 {
+class FrameRecorder {
+   public:
+    enum class Format : uint8_t { RUN_LENGTH_ENCODED, Y4M, APNG };
+
+    // 2 seconds of frames at the default speed
+    static const uint32_t QUEUE_CAPACITY = 128;
+
+    /**
+     * Creates the file and starts the encoder thread.
+     * @param framesPerSecondNumerator with framesPerSecondDenominator, the rate frames will be recorded at, ex: 125/2 at the default speed
+     * @throws IOException if the file can't be created
+     */
+    FrameRecorder(const std::string &path, Format format, uint32_t framesPerSecondNumerator, uint32_t framesPerSecondDenominator);
+
+    /**
+     * Finishes the video if finish() wasn't called, ignoring any error
+     */
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder &) = delete;
+    FrameRecorder &operator=(const FrameRecorder &) = delete;
+
+    /**
+     * Queues a frame for the encoder thread. Only one thread may record frames, and it never blocks.
+     * @return false if the encoder is too far behind, in which case the frame is dropped
+     */
+    bool recordFrame(const FrameBuffer &frame);
+
+    /**
+     * Waits for the encoder thread to write every queued frame, and completes the file. No frames may be recorded afterwards.
+     * @throws IOException if the file couldn't be written
+     */
+    void finish();
+
+    uint64_t getNumFramesWritten() const;
+
+    uint64_t getNumFramesDropped() const;
+
+    /**
+     * @return the number of frames waiting for the encoder thread. Like SpscRingBuffer::size(), only a snapshot
+     */
+    uint32_t getNumFramesQueued() const;
+
+    /**
+     * @return Y4M for paths ending in .y4m, APNG for paths ending in .png or .apng, and RUN_LENGTH_ENCODED for anything else
+     */
+    static Format getFormatForPath(const std::string &path);
+
+    /**
+     * Reads every frame of a video recorded in the RUN_LENGTH_ENCODED format, including ones recorded before the screen had a high
+     * resolution
+     * @throws IOException if input doesn't contain such a video
+     */
+    static std::vector<FrameBuffer> load(std::istream &input);
+
+   private:
+    // the characters "C8F1" when written in little endian
+    static const uint32_t FILE_MAGIC = 0x31463843;
+    static const int FILE_VERSION = 2;
+    // version 1 frames were only the 64x32 low resolution screen
+    static const int LOW_RESOLUTION_FILE_VERSION = 1;
+    static const int BYTES_PER_ROW = FrameBuffer::MAX_WIDTH / 8;
+    // the byte that tells whether the screen is in high resolution, then the rows
+    static const int BYTES_PER_FRAME = 1 + BYTES_PER_ROW * FrameBuffer::MAX_HEIGHT;
+    static const int LOW_RESOLUTION_BYTES_PER_FRAME = FrameBuffer::LOW_RESOLUTION_WIDTH / 8 * FrameBuffer::LOW_RESOLUTION_HEIGHT;
+
+    std::ofstream file;
+    Format format;
+    uint32_t framesPerSecondNumerator;
+    uint32_t framesPerSecondDenominator;
+    SpscRingBuffer<FrameBuffer, QUEUE_CAPACITY> frames;
+    // incremented after every frame is queued and when finishing, so the encoder thread can sleep until there is something to do
+    std::atomic<uint32_t> numWakeUps{0};
+    std::atomic<bool> isFinishing{false};
+    std::atomic<uint64_t> numFramesWritten{0};
+    std::atomic<uint64_t> numFramesDropped{0};
+    std::thread encoderThread;
+
+    // only used by the encoder thread
+    FrameBuffer previousFrame = {};
+    uint32_t apngSequenceNumber = 0;
+    std::streampos apngAnimationControlPosition;
+    // reused for every frame, so encoding doesn't allocate either
+    std::vector<uint8_t> encodedFrame;
+
+    /**
+     * The encoder thread: writes frames as they are queued, until finish() is called and the queue is empty
+     */
+    void encodeFrames();
+
+    void writeHeader();
+
+    void writeFrame(const FrameBuffer &frame);
+
+    void writeTrailer();
+
+    /**
+     * Writes a PNG chunk: the length of data, type, data, and the CRC-32 of type and data
+     */
+    void writeApngChunk(const char *type, const std::vector<uint8_t> &data);
+
+    std::vector<uint8_t> getApngAnimationControl(uint32_t numFrames) const;
+};
+}
+
+#endif  // CHIP_8_FRAMERECORDER_H
@@ -0,0 +1,52 @@
+#include "InputMovie.h"
+#include "BinaryStream.h"
+#include "../exceptions/IOException.h"
+
+namespace Chip8 {
+void InputMovie::save(std::ostream &output) const {
+    BinaryStream::writeInteger(output, FILE_MAGIC, sizeof(uint32_t));
+    BinaryStream::writeInteger(output, FILE_VERSION, sizeof(uint16_t));
+    BinaryStream::writeInteger(output, romHash, sizeof(uint64_t));
+    BinaryStream::writeInteger(output, randomSeed, sizeof(uint32_t));
+    BinaryStream::writeInteger(output, numCycles, sizeof(uint64_t));
+    BinaryStream::writeInteger(output, finalStateHash, sizeof(uint64_t));
+    BinaryStream::writeVariableLengthInteger(output, events.size());
+    uint64_t previousCycle = 0;
+    for (const CycleKeyEvent &event : events) {
+        BinaryStream::writeVariableLengthInteger(output, event.cycleNumber - previousCycle);
+        uint8_t key = (event.keyNumber & KEY_NUMBER_BITS) | (event.isPressed ? KEY_PRESSED_BIT : 0);
+        BinaryStream::writeInteger(output, key, sizeof(uint8_t));
+        previousCycle = event.cycleNumber;
+    }
+    if (!output) {
+        throw IOException("Could not write the input movie");
+    }
+}
+
+InputMovie InputMovie::load(std::istream &input) {
+    if (BinaryStream::readInteger(input, sizeof(uint32_t)) != FILE_MAGIC) {
+        throw IOException("Not an input movie");
+    }
+    uint64_t version = BinaryStream::readInteger(input, sizeof(uint16_t));
+    if (version < FILE_VERSION) {
+        throw IOException("The input movie is from an older version of the emulator, whose states hash differently, so it can't be "
+                          "replayed");
+    }
+    if (version != FILE_VERSION) {
+        throw IOException("The input movie is from a newer version of the emulator");
+    }
+    InputMovie movie;
+    movie.romHash = BinaryStream::readInteger(input, sizeof(uint64_t));
+    movie.randomSeed = (uint32_t)BinaryStream::readInteger(input, sizeof(uint32_t));
+    movie.numCycles = BinaryStream::readInteger(input, sizeof(uint64_t));
+    movie.finalStateHash = BinaryStream::readInteger(input, sizeof(uint64_t));
+    uint64_t numEvents = BinaryStream::readVariableLengthInteger(input);
+    uint64_t cycleNumber = 0;
+    for (uint64_t i = 0; i < numEvents; i++) {
+        cycleNumber += BinaryStream::readVariableLengthInteger(input);
+        uint8_t key = (uint8_t)BinaryStream::readInteger(input, sizeof(uint8_t));
+        movie.events.push_back({cycleNumber, (uint8_t)(key & KEY_NUMBER_BITS), (key & KEY_PRESSED_BIT) != 0});
+    }
+    return movie;
+}
+}
@@ -0,0 +1,46 @@
+#ifndef CHIP_8_INPUTMOVIE_H
+#define CHIP_8_INPUTMOVIE_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "../subsystems/input/KeyEvent.h"
+
+/**
+ * A recording of every key change in a session, keyed by the cycle it took effect at, along with everything else a replay needs to
+ * reach the same state: the hash of the ROM, and the seed of the cpu's random numbers.
+ * The number of cycles the session ran and the hash of its final state are kept too, so a replay can tell whether it ended up
+ * bit-identical to the recording.
+ * Movies are saved in a compact binary format: each event is the number of cycles since the previous event as a variable length
+ * integer (see BinaryStream), followed by a single byte for the key and whether it was pressed.
+ */
+namespace Chip8 {
+class InputMovie {
+   public:
+    uint64_t romHash = 0;
+    uint32_t randomSeed = 0;
+    uint64_t numCycles = 0;
+    uint64_t finalStateHash = 0;
+    // sorted by cycle
+    std::vector<CycleKeyEvent> events;
+
+    void save(std::ostream &output) const;
+
+    /**
+     * @throws IOException if input doesn't contain a movie
+     */
+    static InputMovie load(std::istream &input);
+
+   private:
+    // the characters "C8M1" when written in little endian
+    static const uint32_t FILE_MAGIC = 0x314D3843;
+    // version 2 movies end in the hash of a state that includes the SUPER-CHIP's big font and flag registers, which earlier versions'
+    // hashes can never match
+    static const int FILE_VERSION = 2;
+    static const uint8_t KEY_PRESSED_BIT = 0x80;
+    static const uint8_t KEY_NUMBER_BITS = 0x0F;
+};
+}
+
+#endif  // CHIP_8_INPUTMOVIE_H
@@ -0,0 +1,56 @@
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include "../exceptions/IOException.h"
+
+namespace Chip8 {
+MappedFile::MappedFile(const std::string &path) : data(nullptr), size(0), modifiedTime(0) {
+    int fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        throw IOException("Unable to open " + path + ": " + std::strerror(errno));
+    }
+
+    std::string error;
+    struct stat status;
+    if (fstat(fileDescriptor, &status) != 0) {
+        error = std::strerror(errno);
+    } else if (!S_ISREG(status.st_mode)) {
+        error = "not a regular file";
+    } else {
+        size = (size_t)status.st_size;
+        modifiedTime = (int64_t)status.st_mtime;
+    }
+
+    // an empty file can't be mapped, and has no bytes to map anyway
+    if (error.empty() && size > 0) {
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (mapping == MAP_FAILED) {
+            error = std::strerror(errno);
+        } else {
+            data = (const uint8_t *)mapping;
+        }
+    }
+    // the mapping stays valid after the descriptor is closed
+    close(fileDescriptor);
+
+    if (!error.empty()) {
+        throw IOException("Unable to map " + path + ": " + error);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data != nullptr) {
+        munmap((void *)data, size);
+    }
+}
+
+const uint8_t *MappedFile::getData() const { return data; }
+
+size_t MappedFile::getSize() const { return size; }
+
+int64_t MappedFile::getModifiedTime() const { return modifiedTime; }
+}
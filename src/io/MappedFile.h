@@ -0,0 +1,44 @@
+#ifndef CHIP_8_MAPPEDFILE_H
+#define CHIP_8_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * A file mapped read-only into this process (see mmap()) for as long as the object exists.
+ * Its bytes are read straight from the page cache, without copying them into a buffer first or parsing them through a stream.
+ */
+namespace Chip8 {
+class MappedFile {
+   public:
+    /**
+     * @throws IOException if the file can't be opened or mapped
+     */
+    explicit MappedFile(const std::string &path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @return the file's bytes, or nullptr if the file is empty
+     */
+    const uint8_t *getData() const;
+
+    size_t getSize() const;
+
+    /**
+     * @return when the file was last modified, in seconds since the Unix epoch
+     */
+    int64_t getModifiedTime() const;
+
+   private:
+    const uint8_t *data;
+    size_t size;
+    int64_t modifiedTime;
+};
+}
+
+#endif  // CHIP_8_MAPPEDFILE_H
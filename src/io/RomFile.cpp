@@ -0,0 +1,28 @@
+#include "RomFile.h"
+#include "../exceptions/IOException.h"
+#include "../utils/HashUtil.h"
+#include "MappedFile.h"
+
+namespace Chip8 {
+RomFile::RomFile(std::string filename) {
+    MappedFile file(filename);
+    if (file.getSize() == 0) {
+        throw IOException("Could not read any bytes in the file");
+    }
+    if (file.getSize() > MAX_ROM_SIZE) {
+        throw IOException("The ROM is " + std::to_string(file.getSize()) + " bytes, which is too large to fit in memory (at most " +
+                          std::to_string(MAX_ROM_SIZE) + " bytes)");
+    }
+    data.assign(file.getData(), file.getData() + file.getSize());
+}
+
+const std::vector<uint8_t> &RomFile::getData() const { return data; }
+
+uint64_t RomFile::getHash() const { return HashUtil::fnv1a(data.data(), data.size()); }
+
+void RomFile::loadToMemory(Memory &memory) const {
+    memory.fill(0, 0, Constants::MEMORY_PROGRAM_START_LOCATION);
+    memory.copyFrom(Constants::MEMORY_PROGRAM_START_LOCATION, data.data(), data.size());
+    memory.fill(Constants::MEMORY_PROGRAM_START_LOCATION + data.size(), 0, MAX_ROM_SIZE - data.size());
+}
+}
@@ -0,0 +1,41 @@
+#ifndef CHIP_8_ROMFILE_H
+#define CHIP_8_ROMFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../constants/Constants.h"
+#include "../storage/Memory.h"
+
+/**
+ * The contents of a ROM file, read entirely into memory.
+ * Offline tools use this to get at a ROM's bytes and its content hash, and to lay the ROM out in Memory the same way the emulator does.
+ */
+namespace Chip8 {
+class RomFile {
+   public:
+    static const int MAX_ROM_SIZE = Memory::NUM_BYTES_OF_MEMORY - Constants::MEMORY_PROGRAM_START_LOCATION;
+
+    /**
+     * @throws IOException if the file can't be read, is empty, or is larger than MAX_ROM_SIZE
+     */
+    RomFile(std::string filename);
+
+    const std::vector<uint8_t> &getData() const;
+
+    /**
+     * @return a hash of the ROM's contents, which identifies the ROM regardless of its file name
+     */
+    uint64_t getHash() const;
+
+    /**
+     * Copies the ROM to the program area of memory, and zeroes the rest of memory
+     */
+    void loadToMemory(Memory &memory) const;
+
+   private:
+    std::vector<uint8_t> data;
+};
+}
+
+#endif  // CHIP_8_ROMFILE_H
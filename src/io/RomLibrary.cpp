@@ -0,0 +1,134 @@
+#include "RomLibrary.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <unordered_set>
+#include "../exceptions/IOException.h"
+#include "../exceptions/IndexOutOfBoundsException.h"
+#include "../utils/HashUtil.h"
+#include "BinaryStream.h"
+#include "RomFile.h"
+
+namespace Chip8 {
+bool RomLibraryEntry::isLoadable() const { return size > 0 && size <= RomFile::MAX_ROM_SIZE; }
+
+RomLibrary::RomLibrary(const std::string &indexPath) : file(indexPath) {
+    if (file.getSize() < HEADER_SIZE || readInteger(file.getData(), 4) != FILE_MAGIC) {
+        throw IOException(indexPath + " is not a ROM library index");
+    }
+    if (readInteger(file.getData() + 4, 2) != FILE_VERSION) {
+        throw IOException(indexPath + " was built by an unsupported version of the emulator");
+    }
+    numRoms = (uint32_t)readInteger(file.getData() + 8, 4);
+    stringTableOffset = (uint32_t)readInteger(file.getData() + 12, 4);
+    if (stringTableOffset != HEADER_SIZE + (uint64_t)numRoms * ENTRY_SIZE || stringTableOffset > file.getSize()) {
+        throw IOException(indexPath + " is truncated or corrupt");
+    }
+}
+
+void RomLibrary::build(const std::vector<std::string> &romPaths, const std::string &indexPath) {
+    std::vector<RomLibraryEntry> entries;
+    std::unordered_set<uint64_t> hashes;
+    for (const std::string &romPath : romPaths) {
+        MappedFile romFile(romPath);
+        RomLibraryEntry entry;
+        entry.hash = HashUtil::fnv1a(romFile.getData(), romFile.getSize());
+        if (!hashes.insert(entry.hash).second) {
+            continue;
+        }
+        entry.size = (uint32_t)std::min(romFile.getSize(), (size_t)UINT32_MAX);
+        entry.modifiedTime = romFile.getModifiedTime();
+        entry.path = romPath;
+        size_t nameStart = romPath.find_last_of('/') + 1;
+        size_t extensionStart = romPath.find_last_of('.');
+        extensionStart = extensionStart == std::string::npos || extensionStart <= nameStart ? romPath.size() : extensionStart;
+        entry.title = romPath.substr(nameStart, extensionStart - nameStart);
+        entries.push_back(entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const RomLibraryEntry &a, const RomLibraryEntry &b) { return a.hash < b.hash; });
+
+    std::string temporaryPath = indexPath + ".tmp";
+    {
+        std::ofstream indexFile(temporaryPath, std::ios::binary);
+        BinaryStream::writeInteger(indexFile, FILE_MAGIC, 4);
+        BinaryStream::writeInteger(indexFile, FILE_VERSION, 2);
+        BinaryStream::writeInteger(indexFile, 0, 2);
+        BinaryStream::writeInteger(indexFile, entries.size(), 4);
+        BinaryStream::writeInteger(indexFile, HEADER_SIZE + entries.size() * ENTRY_SIZE, 4);
+        uint64_t stringOffset = 0;
+        for (const RomLibraryEntry &entry : entries) {
+            BinaryStream::writeInteger(indexFile, entry.hash, 8);
+            BinaryStream::writeInteger(indexFile, (uint64_t)entry.modifiedTime, 8);
+            BinaryStream::writeInteger(indexFile, entry.size, 4);
+            BinaryStream::writeInteger(indexFile, stringOffset, 4);
+            BinaryStream::writeInteger(indexFile, entry.path.size(), 4);
+            BinaryStream::writeInteger(indexFile, entry.title.size(), 4);
+            stringOffset += entry.path.size() + entry.title.size();
+        }
+        if (stringOffset > UINT32_MAX) {
+            throw IOException("Too many ROMs to index in " + indexPath);
+        }
+        for (const RomLibraryEntry &entry : entries) {
+            indexFile << entry.path << entry.title;
+        }
+        if (!indexFile) {
+            throw IOException("Could not write the ROM library index to " + temporaryPath);
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), indexPath.c_str()) != 0) {
+        throw IOException("Could not replace " + indexPath + " with the new ROM library index");
+    }
+}
+
+uint32_t RomLibrary::getNumRoms() const { return numRoms; }
+
+RomLibraryEntry RomLibrary::getRom(uint32_t index) const {
+    if (index >= numRoms) {
+        throw IndexOutOfBoundsException("ROM " + std::to_string(index) + " is past the end of the library (size " +
+                                         std::to_string(numRoms) + ")");
+    }
+    const uint8_t *entryData = getEntryData(index);
+    RomLibraryEntry entry;
+    entry.hash = readInteger(entryData, 8);
+    entry.modifiedTime = (int64_t)readInteger(entryData + 8, 8);
+    entry.size = (uint32_t)readInteger(entryData + 16, 4);
+    uint64_t pathOffset = stringTableOffset + readInteger(entryData + 20, 4);
+    uint64_t pathLength = readInteger(entryData + 24, 4);
+    uint64_t titleLength = readInteger(entryData + 28, 4);
+    if (pathOffset + pathLength + titleLength > file.getSize()) {
+        throw IOException("The ROM library index is corrupt");
+    }
+    const char *strings = (const char *)file.getData() + pathOffset;
+    entry.path.assign(strings, pathLength);
+    entry.title.assign(strings + pathLength, titleLength);
+    return entry;
+}
+
+bool RomLibrary::findRom(uint64_t hash, RomLibraryEntry &entry) const {
+    uint32_t low = 0;
+    uint32_t high = numRoms;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (readInteger(getEntryData(middle), 8) < hash) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == numRoms || readInteger(getEntryData(low), 8) != hash) {
+        return false;
+    }
+    entry = getRom(low);
+    return true;
+}
+
+const uint8_t *RomLibrary::getEntryData(uint32_t index) const { return file.getData() + HEADER_SIZE + (size_t)index * ENTRY_SIZE; }
+
+uint64_t RomLibrary::readInteger(const uint8_t *data, int numBytes) {
+    uint64_t value = 0;
+    for (int i = numBytes - 1; i >= 0; i--) {
+        value = value << 8 | data[i];
+    }
+    return value;
+}
+}
@@ -0,0 +1,81 @@
+#ifndef CHIP_8_ROMLIBRARY_H
+#define CHIP_8_ROMLIBRARY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+/**
+ * An index of a collection of ROMs, kept in one file that is built once and then mapped into memory, so batch jobs (ex: running every
+ * ROM of a collection) can look ROMs up and check their sizes without opening or parsing any of the ROMs.
+ * ROMs are identified by the same content hash as RomFile::getHash(), which input movies and block maps are also tagged with.
+ * The index file is little endian:
+ * - a 16 byte header: the characters "C8L1", a version, the number of ROMs, and where the string table starts
+ * - one 32 byte entry per ROM, sorted by hash: the hash, the ROM's modification time and size, and where its path and title are in the
+ *   string table
+ * - the string table, holding each ROM's path followed by its title
+ */
+namespace Chip8 {
+class RomLibraryEntry {
+   public:
+    uint64_t hash;
+    uint32_t size;
+    // in seconds since the Unix epoch, so a batch job can tell whether a ROM changed since the index was built
+    int64_t modifiedTime;
+    std::string path;
+    // the ROM's file name, without its directory or extension
+    std::string title;
+
+    /**
+     * @return whether the ROM fits in memory and isn't empty
+     */
+    bool isLoadable() const;
+};
+
+class RomLibrary {
+   public:
+    /**
+     * Maps an index built by build()
+     * @throws IOException if the file can't be mapped or isn't a valid index
+     */
+    explicit RomLibrary(const std::string &indexPath);
+
+    /**
+     * Hashes every ROM and writes the index of them to indexPath. ROMs whose contents are already in the index under an earlier path
+     * are left out. ROMs that are too large to load are still indexed, so they can be reported.
+     * @throws IOException if a ROM can't be read, or the index can't be written
+     */
+    static void build(const std::vector<std::string> &romPaths, const std::string &indexPath);
+
+    uint32_t getNumRoms() const;
+
+    /**
+     * @param index from 0 to getNumRoms() - 1. ROMs are in order of their hashes
+     */
+    RomLibraryEntry getRom(uint32_t index) const;
+
+    /**
+     * Binary searches the index for a ROM
+     * @return whether a ROM with the hash is in the index, in which case entry is set to it
+     */
+    bool findRom(uint64_t hash, RomLibraryEntry &entry) const;
+
+   private:
+    // the characters "C8L1" when written in little endian
+    static const uint32_t FILE_MAGIC = 0x314C3843;
+    static const int FILE_VERSION = 1;
+    static const int HEADER_SIZE = 16;
+    static const int ENTRY_SIZE = 32;
+
+    MappedFile file;
+    uint32_t numRoms;
+    uint32_t stringTableOffset;
+
+    const uint8_t *getEntryData(uint32_t index) const;
+
+    static uint64_t readInteger(const uint8_t *data, int numBytes);
+};
+}
+
+#endif  // CHIP_8_ROMLIBRARY_H
@@ -1,6 +1,14 @@
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 #include "Chip8.h"
+#include "exceptions/IOException.h"
 #include "subsystems/SdlSubsystemManager.h"
+#include "subsystems/input/InputController.h"
+#include "utils/OptionUtil.h"
+#include "utils/PhaseTracer.h"
 
 using namespace Chip8;
 
@@ -8,21 +16,137 @@ using namespace Chip8;
  * A simple main function to kick off execution of the emulator.
  */
 
-// Expecting the program name as arg 1, and the ROM file name to load as arg 2
-const int EXPECTED_NUM_ARGS = 2;
+// Expecting the program name as arg 1, the ROM file name to load as arg 2,
+// and optionally a library built from the ROM by chip_8_recompile as arg 3.
+// Options (ex: --audio-buffer=256, --keymap=keys.txt, --record=session.movie, --run-ahead=2, --trace=session.trace,
+// --timeline=timeline.json, --metrics=metrics.prom, --video=session.y4m, --turbo=8 or --turbo=max) can be given anywhere, and don't
+// count towards the number of args
+const int MIN_NUM_ARGS = 2;
+const int MAX_NUM_ARGS = 3;
 const int ROM_FILE_PATH_INDEX = 1;
+const int RECOMPILED_LIBRARY_PATH_INDEX = 2;
+const std::string AUDIO_BUFFER_OPTION = "--audio-buffer=";
+const std::string KEY_MAP_OPTION = "--keymap=";
+const std::string RECORD_OPTION = "--record=";
+const std::string RUN_AHEAD_OPTION = "--run-ahead=";
+const std::string TRACE_OPTION = "--trace=";
+const std::string TIMELINE_OPTION = "--timeline=";
+const std::string METRICS_OPTION = "--metrics=";
+const std::string VIDEO_OPTION = "--video=";
+const std::string TURBO_OPTION = "--turbo=";
+const std::string TURBO_UNTHROTTLED = "max";
+
 int main(int argc, char **argv) {
-    if (argc != EXPECTED_NUM_ARGS) {
-        std::cout << "Incorrect usage. Expected Chip8 ROM file path as an argument" << std::endl;
+    std::vector<std::string> args;
+    uint32_t audioBufferSize = SdlAudio::DEFAULT_BUFFER_SIZE;
+    std::string keyMapFilePath;
+    std::string movieFilePath;
+    uint32_t numRunAheadFrames = 0;
+    std::string traceFilePath;
+    std::string timelineFilePath;
+    std::string metricsFilePath;
+    std::string videoFilePath;
+    uint32_t turboMultiplier = Chip8Emulator::TURBO_OFF;
+    bool areOptionsValid = true;
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, AUDIO_BUFFER_OPTION.size(), AUDIO_BUFFER_OPTION) == 0) {
+            areOptionsValid &=
+                OptionUtil::parseNumber(arg.substr(AUDIO_BUFFER_OPTION.size()), 1, SdlAudio::MAX_BUFFER_SIZE, audioBufferSize);
+        } else if (arg.compare(0, KEY_MAP_OPTION.size(), KEY_MAP_OPTION) == 0) {
+            keyMapFilePath = arg.substr(KEY_MAP_OPTION.size());
+        } else if (arg.compare(0, RECORD_OPTION.size(), RECORD_OPTION) == 0) {
+            movieFilePath = arg.substr(RECORD_OPTION.size());
+        } else if (arg.compare(0, RUN_AHEAD_OPTION.size(), RUN_AHEAD_OPTION) == 0) {
+            areOptionsValid &=
+                OptionUtil::parseNumber(arg.substr(RUN_AHEAD_OPTION.size()), 0, Chip8Emulator::MAX_RUN_AHEAD_FRAMES, numRunAheadFrames);
+        } else if (arg.compare(0, TRACE_OPTION.size(), TRACE_OPTION) == 0) {
+            traceFilePath = arg.substr(TRACE_OPTION.size());
+        } else if (arg.compare(0, TIMELINE_OPTION.size(), TIMELINE_OPTION) == 0) {
+            timelineFilePath = arg.substr(TIMELINE_OPTION.size());
+        } else if (arg.compare(0, METRICS_OPTION.size(), METRICS_OPTION) == 0) {
+            metricsFilePath = arg.substr(METRICS_OPTION.size());
+        } else if (arg.compare(0, VIDEO_OPTION.size(), VIDEO_OPTION) == 0) {
+            videoFilePath = arg.substr(VIDEO_OPTION.size());
+        } else if (arg.compare(0, TURBO_OPTION.size(), TURBO_OPTION) == 0) {
+            std::string multiplier = arg.substr(TURBO_OPTION.size());
+            if (multiplier == TURBO_UNTHROTTLED) {
+                turboMultiplier = Chip8Emulator::UNTHROTTLED;
+            } else {
+                // a multiplier of 0 would mean unthrottled (see Chip8Emulator::UNTHROTTLED), which is asked for by name instead
+                areOptionsValid &= OptionUtil::parseNumber(multiplier, Chip8Emulator::TURBO_OFF, UINT32_MAX, turboMultiplier);
+            }
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (!areOptionsValid || args.size() < MIN_NUM_ARGS || args.size() > MAX_NUM_ARGS) {
+        std::cout << "Incorrect usage. Expected Chip8 ROM file path as an argument, optionally followed by a recompiled library path."
+                  << " Options: " << AUDIO_BUFFER_OPTION << "<samples> " << KEY_MAP_OPTION << "<file> " << RECORD_OPTION << "<file> "
+                  << RUN_AHEAD_OPTION << "<frames> " << TRACE_OPTION << "<file> " << TIMELINE_OPTION << "<file> " << METRICS_OPTION
+                  << "<file> " << VIDEO_OPTION << "<file> " << TURBO_OPTION << "<multiplier|" << TURBO_UNTHROTTLED << ">" << std::endl;
         return 1;
     }
     try {
-        SdlSubsystemManager sdlSubsystemManager;
+        SdlSubsystemManager sdlSubsystemManager((uint16_t)audioBufferSize);
+        if (!keyMapFilePath.empty()) {
+            std::ifstream keyMapFile(keyMapFilePath);
+            if (!keyMapFile) {
+                throw IOException("Could not open key map " + keyMapFilePath);
+            }
+            sdlSubsystemManager.setKeyMap(InputController::parseKeyMap(keyMapFile));
+        }
         Chip8Emulator chip8{sdlSubsystemManager};
-        chip8.loadGameFile(argv[ROM_FILE_PATH_INDEX]);
+        chip8.loadGameFile(args[ROM_FILE_PATH_INDEX]);
+        if (args.size() == MAX_NUM_ARGS) {
+            chip8.loadRecompiledProgram(args[RECOMPILED_LIBRARY_PATH_INDEX]);
+        }
+        chip8.setRunAheadFrames(numRunAheadFrames);
+        chip8.setTurbo(turboMultiplier);
+        chip8.setInstructionTracing(!traceFilePath.empty());
+        if (!metricsFilePath.empty()) {
+            chip8.setMetricsFile(metricsFilePath);
+        }
+        InputMovie movie;
+        if (!movieFilePath.empty()) {
+            chip8.startRecording(movie);
+        }
+        if (!timelineFilePath.empty()) {
+            PhaseTracer::start();
+        }
+        std::unique_ptr<FrameRecorder> frameRecorder;
+        if (!videoFilePath.empty()) {
+            frameRecorder.reset(new FrameRecorder(videoFilePath, FrameRecorder::getFormatForPath(videoFilePath),
+                                                  Chip8Emulator::DEFAULT_CYCLES_PER_SECOND, Chip8Emulator::CYCLES_PER_FRAME));
+            chip8.setFrameRecorder(frameRecorder.get());
+        }
         chip8.beginEmulation();
+        if (frameRecorder != nullptr) {
+            frameRecorder->finish();
+            if (frameRecorder->getNumFramesDropped() > 0) {
+                std::cout << "The video fell behind, so " << frameRecorder->getNumFramesDropped() << " frames are missing" << std::endl;
+            }
+        }
+        if (!timelineFilePath.empty()) {
+            PhaseTracer::stop();
+            std::ofstream timelineFile(timelineFilePath);
+            PhaseTracer::writeChromeTrace(timelineFile);
+            if (PhaseTracer::getNumDroppedPhases() > 0) {
+                std::cout << "The timeline was full, so the last " << PhaseTracer::getNumDroppedPhases() << " phases are missing"
+                          << std::endl;
+            }
+        }
+        if (!movieFilePath.empty()) {
+            chip8.stopRecording();
+            std::ofstream movieFile(movieFilePath, std::ios::binary);
+            movie.save(movieFile);
+        }
+        if (!traceFilePath.empty()) {
+            std::ofstream traceFile(traceFilePath, std::ios::binary);
+            chip8.getInstructionTrace().save(traceFile);
+        }
     } catch (BaseException e) {
         std::cout << "Exception Encountered: " << e.what();
     }
     return 0;
-}
\ No newline at end of file
+}
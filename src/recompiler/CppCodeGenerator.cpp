@@ -0,0 +1,248 @@
+#include "CppCodeGenerator.h"
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include "../constants/Constants.h"
+#include "../constants/OpcodeBitshifts.h"
+#include "../constants/Opcodes.h"
+#include "../cpu/Cpu.h"
+#include "../exceptions/IOException.h"
+#include "RecompilerContext.h"
+
+namespace Chip8 {
+CppCodeGenerator::CppCodeGenerator(const ControlFlowGraph &controlFlowGraph) : controlFlowGraph(controlFlowGraph) {}
+
+void CppCodeGenerator::generate(std::ostream &output, const std::string &sourceName) const {
+    output << "// Generated by chip_8_recompile from " << sourceName << ". Do not edit.\n";
+    output << "#include \"recompiler/RecompilerContext.h\"\n\n";
+    output << "using Chip8::RecompilerContext;\n\n";
+    output << "namespace {\n";
+    for (const auto &block : controlFlowGraph.getBasicBlocks()) {
+        generateBlockFunction(output, block.second);
+    }
+    output << "}\n\n";
+
+    output << "extern \"C\" const Chip8::RecompiledBlock " << RECOMPILED_BLOCKS_SYMBOL << "[] = {\n";
+    for (const auto &block : controlFlowGraph.getBasicBlocks()) {
+        output << "    {" << toHex(block.first, 3) << ", &" << getFunctionName(block.second) << "},\n";
+    }
+    output << "};\n";
+    output << "extern \"C\" const unsigned int " << RECOMPILED_BLOCK_COUNT_SYMBOL << " = " << controlFlowGraph.getBasicBlocks().size()
+           << ";\n";
+}
+
+void CppCodeGenerator::compileLibrary(const std::string &sourcePath, const std::string &libraryPath) {
+    // the flags are several arguments, so they are the only part of the command left unquoted
+    std::string compileCommand = quoteShellArgument(CHIP8_RECOMPILER_CXX) + " " + CHIP8_RECOMPILER_FLAGS + " -I" +
+                                 quoteShellArgument(CHIP8_RECOMPILER_INCLUDE_DIR) + " " + quoteShellArgument(sourcePath) + " -o " +
+                                 quoteShellArgument(libraryPath);
+    if (std::system(compileCommand.c_str()) != 0) {
+        throw IOException("Failed to compile the recompiled library with: " + compileCommand);
+    }
+}
+
+std::string CppCodeGenerator::quoteShellArgument(const std::string &argument) {
+    // nothing is special between single quotes, so only the single quotes themselves need escaping: close, escape one, and reopen
+    std::string quoted = "'";
+    for (char character : argument) {
+        if (character == '\'') {
+            quoted += "'\\''";
+        } else {
+            quoted += character;
+        }
+    }
+    return quoted + "'";
+}
+
+std::string CppCodeGenerator::toHex(unsigned int value, int numDigits) {
+    std::ostringstream hex;
+    hex << "0x" << std::uppercase << std::hex << std::setw(numDigits) << std::setfill('0') << value;
+    return hex.str();
+}
+
+std::string CppCodeGenerator::getFunctionName(const BasicBlock &block) { return "block_" + toHex(block.getStartAddress(), 3); }
+
+void CppCodeGenerator::generateBlockFunction(std::ostream &output, const BasicBlock &block) const {
+    const std::vector<Instruction> &instructions = block.getInstructions();
+    output << "unsigned int " << getFunctionName(block) << "(RecompilerContext &ctx) {\n";
+    generateGuard(output, block);
+
+    // every instruction except the last one continues on to the next instruction
+    for (size_t i = 0; i + 1 < instructions.size(); i++) {
+        if (!generateInstruction(output, instructions[i])) {
+            output << "    ctx.cpu.executeOpcodeAt(" << toHex(instructions[i].getAddress(), 3) << ", "
+                   << toHex(instructions[i].getOpcode(), 4) << ");\n";
+        }
+    }
+
+    const Instruction &lastInstruction = block.getLastInstruction();
+    if (lastInstruction.endsBasicBlock()) {
+        if (!generateControlFlowInstruction(output, lastInstruction)) {
+            output << "    ctx.cpu.executeOpcodeAt(" << toHex(lastInstruction.getAddress(), 3) << ", " << toHex(lastInstruction.getOpcode(), 4)
+                   << ");\n";
+        }
+    } else {
+        // the block falls through into the next block
+        if (!generateInstruction(output, lastInstruction)) {
+            output << "    ctx.cpu.executeOpcodeAt(" << toHex(lastInstruction.getAddress(), 3) << ", " << toHex(lastInstruction.getOpcode(), 4)
+                   << ");\n";
+        }
+        output << "    ctx.programCounter = " << toHex(block.getEndAddress(), 3) << ";\n";
+    }
+    output << "    return " << instructions.size() << ";\n";
+    output << "}\n\n";
+}
+
+void CppCodeGenerator::generateGuard(std::ostream &output, const BasicBlock &block) const {
+    output << "    if (";
+    const std::vector<Instruction> &instructions = block.getInstructions();
+    for (size_t i = 0; i < instructions.size(); i++) {
+        if (i > 0) {
+            output << " ||\n        ";
+        }
+        output << "!ctx.isOpcodeAt(" << toHex(instructions[i].getAddress(), 3) << ", " << toHex(instructions[i].getOpcode(), 4) << ")";
+    }
+    output << ") {\n";
+    output << "        return 0;\n";
+    output << "    }\n";
+}
+
+bool CppCodeGenerator::generateInstruction(std::ostream &output, const Instruction &instruction) const {
+    // the statements generated here must match the corresponding Cpu::execute*Opcode() implementation exactly,
+    // including the order in which the carry register is written and read
+    std::string x = "ctx.registers[" + std::to_string(instruction.getRegisterX()) + "]";
+    std::string y = "ctx.registers[" + std::to_string(instruction.getRegisterY()) + "]";
+    std::string carry = "ctx.registers[" + std::to_string(Cpu::INDEX_CARRY_REGISTER) + "]";
+    std::string value = toHex(instruction.getValue(), 2);
+
+    std::ostringstream statements;
+    switch (instruction.getOpcode() >> OpcodeBitshifts::NIBBLE_THREE) {
+        case 0x0:
+            if (instruction.getOpcode() != Opcodes::CLEAR_DISPLAY) {
+                return false;
+            }
+            statements << "    ctx.display.clearScreen();\n";
+            statements << "    ctx.updateScreen();\n";
+            break;
+        case 0x6:
+            statements << "    " << x << " = " << value << ";\n";
+            break;
+        case 0x7:
+            statements << "    " << x << " += " << value << ";\n";
+            break;
+        case 0x8:
+            switch (instruction.getLastNibble()) {
+                case 0x0:
+                    statements << "    " << x << " = " << y << ";\n";
+                    break;
+                case 0x1:
+                    statements << "    " << x << " = " << x << " | " << y << ";\n";
+                    break;
+                case 0x2:
+                    statements << "    " << x << " = " << x << " & " << y << ";\n";
+                    break;
+                case 0x3:
+                    statements << "    " << x << " = " << x << " ^ " << y << ";\n";
+                    break;
+                case 0x4:
+                    statements << "    " << carry << " = (" << x << " + " << y << " > " << toHex(Constants::MAX_BYTE_SIZE, 2)
+                               << ") ? 1 : 0;\n";
+                    statements << "    " << x << " += " << y << ";\n";
+                    break;
+                case 0x5:
+                    statements << "    " << carry << " = (" << x << " - " << y << " < 0) ? 0 : 1;\n";
+                    statements << "    " << x << " -= " << y << ";\n";
+                    break;
+                case 0x6:
+                    statements << "    " << carry << " = " << x << " & 0x01;\n";
+                    statements << "    " << x << " = " << x << " >> 1;\n";
+                    break;
+                case 0x7:
+                    statements << "    " << carry << " = (" << y << " - " << x << " < 0) ? 0 : 1;\n";
+                    statements << "    " << x << " = " << y << " - " << x << ";\n";
+                    break;
+                case 0xE:
+                    statements << "    " << carry << " = (" << x << " & 0x80) >> 7;\n";
+                    statements << "    " << x << " = " << x << " << 1;\n";
+                    break;
+                default:
+                    return false;
+            }
+            break;
+        case 0xA:
+            statements << "    ctx.indexRegister = " << toHex(instruction.getTargetAddress(), 3) << ";\n";
+            break;
+        case 0xF:
+            switch (instruction.getValue()) {
+                case Opcodes::SET_REGISTER_TO_DELAY_TIMER:
+                    statements << "    " << x << " = ctx.delayTimer;\n";
+                    break;
+                case Opcodes::SET_DELAY_TIMER_TO_REGISTER:
+                    statements << "    ctx.delayTimer = " << x << ";\n";
+                    break;
+                case Opcodes::SET_SOUND_TIMER_TO_REGISTER:
+                    statements << "    ctx.soundTimer = " << x << ";\n";
+                    break;
+                case Opcodes::ADD_REGISTER_TO_INDEX_REGISTER:
+                    statements << "    " << carry << " = (ctx.indexRegister + " << x << " > " << toHex(Constants::MAX_INDEX_REGISTER_VALUE, 3)
+                               << ") ? 1 : 0;\n";
+                    statements << "    ctx.indexRegister += " << x << ";\n";
+                    statements << "    ctx.indexRegister %= " << toHex(Constants::MAX_INDEX_REGISTER_VALUE + 1, 4) << ";\n";
+                    break;
+                case Opcodes::SET_SPRITE_LOCATION:
+                    statements << "    ctx.indexRegister = " << toHex(Constants::MEMORY_FONT_START_LOCATION, 3) << " + " << x << " * "
+                               << (int)Constants::FONT_NUM_BYTES_PER_CHARACTER << ";\n";
+                    break;
+                default:
+                    return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    output << "    ctx.updateTimers();\n" << statements.str();
+    return true;
+}
+
+bool CppCodeGenerator::generateControlFlowInstruction(std::ostream &output, const Instruction &instruction) const {
+    std::string x = "ctx.registers[" + std::to_string(instruction.getRegisterX()) + "]";
+    std::string y = "ctx.registers[" + std::to_string(instruction.getRegisterY()) + "]";
+    std::string condition;
+    switch (instruction.getControlFlow()) {
+        case ControlFlow::JUMP:
+            output << "    ctx.updateTimers();\n";
+            output << "    ctx.programCounter = " << toHex(instruction.getTargetAddress(), 3) << ";\n";
+            return true;
+        case ControlFlow::SKIP:
+            switch (instruction.getOpcode() >> OpcodeBitshifts::NIBBLE_THREE) {
+                case 0x3:
+                    condition = x + " == " + toHex(instruction.getValue(), 2);
+                    break;
+                case 0x4:
+                    condition = x + " != " + toHex(instruction.getValue(), 2);
+                    break;
+                case 0x5:
+                    condition = x + " == " + y;
+                    break;
+                case 0x9:
+                    condition = x + " != " + y;
+                    break;
+                default:
+                    // 0xEX9E and 0xEXA1
+                    condition = "ctx.inputController.isKeyPressed(" + x + ")";
+                    if (instruction.getValue() == Opcodes::KEYPRESS_SKIP_IF_NOT_PRESSED) {
+                        condition = "!" + condition;
+                    }
+                    break;
+            }
+            output << "    ctx.updateTimers();\n";
+            output << "    ctx.programCounter = (" << condition << ") ? "
+                   << toHex(instruction.getNextAddress() + Instruction::SIZE_IN_BYTES, 3) << " : " << toHex(instruction.getNextAddress(), 3)
+                   << ";\n";
+            return true;
+        default:
+            // calls, returns, indirect jumps, memory stores and invalid opcodes are left to the cpu
+            return false;
+    }
+}
+}
@@ -0,0 +1,61 @@
+#ifndef CHIP_8_CPPCODEGENERATOR_H
+#define CHIP_8_CPPCODEGENERATOR_H
+
+#include <ostream>
+#include <string>
+#include "../analysis/ControlFlowGraph.h"
+
+/**
+ * Translates the basic blocks of a ControlFlowGraph into C++ source code that can be compiled into a shared library and loaded with
+ * RecompiledProgram.
+ * Each block becomes one function. Simple opcodes (register arithmetic, skips, jumps, ...) are translated into equivalent C++ statements,
+ * while opcodes with more involved behaviour (drawing, subroutines, random numbers, ...) are handed back to the cpu's own implementation
+ * through Cpu::executeOpcodeAt(), so the generated code can never behave differently than the interpreter.
+ */
+namespace Chip8 {
+class CppCodeGenerator {
+   public:
+    CppCodeGenerator(const ControlFlowGraph &controlFlowGraph);
+
+    /**
+     * @param sourceName a description of where the program came from (ex: the ROM's file name), written into a comment in the output
+     */
+    void generate(std::ostream &output, const std::string &sourceName) const;
+
+    /**
+     * Compiles generated C++ into a shared library with the compiler, flags and include directory given by the CHIP8_RECOMPILER_*
+     * definitions of the program calling this, which are the ones the emulator was built with, so the library is ABI compatible with it
+     * @throws IOException if the compiler fails
+     */
+    static void compileLibrary(const std::string &sourcePath, const std::string &libraryPath);
+
+   private:
+    const ControlFlowGraph &controlFlowGraph;
+
+    /**
+     * @return the argument quoted for the shell, so paths with spaces or shell characters in them are passed to the compiler as they are
+     */
+    static std::string quoteShellArgument(const std::string &argument);
+
+    static std::string toHex(unsigned int value, int numDigits);
+
+    static std::string getFunctionName(const BasicBlock &block);
+
+    void generateBlockFunction(std::ostream &output, const BasicBlock &block) const;
+
+    void generateGuard(std::ostream &output, const BasicBlock &block) const;
+
+    /**
+     * @return true if the instruction was translated into C++, false if it has to be executed by the cpu
+     */
+    bool generateInstruction(std::ostream &output, const Instruction &instruction) const;
+
+    /**
+     * @return true if the instruction was translated into C++ that updates the program counter itself, false if it has to be executed by the
+     * cpu
+     */
+    bool generateControlFlowInstruction(std::ostream &output, const Instruction &instruction) const;
+};
+}
+
+#endif  // CHIP_8_CPPCODEGENERATOR_H
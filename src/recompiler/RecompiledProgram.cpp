@@ -0,0 +1,42 @@
+#include "RecompiledProgram.h"
+#include <dlfcn.h>
+#include "../exceptions/InitializationException.h"
+
+namespace Chip8 {
+RecompiledProgram::RecompiledProgram(std::string libraryPath) {
+    libraryHandle = dlopen(libraryPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (libraryHandle == nullptr) {
+        throw InitializationException("Could not load recompiled library: " + std::string(dlerror()));
+    }
+
+    const RecompiledBlock *blocks = (const RecompiledBlock *)findSymbol(RECOMPILED_BLOCKS_SYMBOL);
+    numBlocks = *(const unsigned int *)findSymbol(RECOMPILED_BLOCK_COUNT_SYMBOL);
+    for (unsigned int i = 0; i < numBlocks; i++) {
+        if (blocks[i].address < Memory::NUM_BYTES_OF_MEMORY) {
+            blockFunctions[blocks[i].address] = blocks[i].function;
+        }
+    }
+}
+
+void *RecompiledProgram::findSymbol(const char *symbolName) {
+    void *symbol = dlsym(libraryHandle, symbolName);
+    if (symbol == nullptr) {
+        // destructor won't be called if throwing from a constructor, so we should clean up after ourselves
+        dlclose(libraryHandle);
+        throw InitializationException("Recompiled library is missing symbol: " + std::string(symbolName));
+    }
+    return symbol;
+}
+
+unsigned int RecompiledProgram::executeBlock(RecompilerContext &context) const {
+    uint16_t programCounter = context.programCounter;
+    if (programCounter >= Memory::NUM_BYTES_OF_MEMORY || blockFunctions[programCounter] == nullptr) {
+        return 0;
+    }
+    return blockFunctions[programCounter](context);
+}
+
+unsigned int RecompiledProgram::getNumBlocks() const { return numBlocks; }
+
+RecompiledProgram::~RecompiledProgram() { dlclose(libraryHandle); }
+}
@@ -0,0 +1,42 @@
+#ifndef CHIP_8_RECOMPILEDPROGRAM_H
+#define CHIP_8_RECOMPILEDPROGRAM_H
+
+#include <string>
+#include "../storage/Memory.h"
+#include "RecompilerContext.h"
+
+/**
+ * A shared library produced by chip_8_recompile, loaded at runtime.
+ * The library contains one function per basic block of a ROM. Running a block executes all of its instructions without fetching or
+ * decoding any of them. Addresses that have no block (ex: targets of 0xBNNN jumps) must be run with the Cpu's interpreter instead.
+ */
+namespace Chip8 {
+class RecompiledProgram {
+   public:
+    RecompiledProgram(std::string libraryPath);
+
+    RecompiledProgram(const RecompiledProgram &) = delete;
+
+    RecompiledProgram &operator=(const RecompiledProgram &) = delete;
+
+    virtual ~RecompiledProgram();
+
+    /**
+     * Runs the block starting at the cpu's program counter, if there is one and it still matches the program in memory
+     * @return the number of cycles executed. 0 means nothing was executed, and the interpreter should execute the next cycle instead
+     */
+    unsigned int executeBlock(RecompilerContext &context) const;
+
+    unsigned int getNumBlocks() const;
+
+   private:
+    void *libraryHandle = nullptr;
+    unsigned int numBlocks = 0;
+    // indexed by address, so finding the block for the program counter doesn't require a search
+    RecompiledBlockFunction blockFunctions[Memory::NUM_BYTES_OF_MEMORY] = {};
+
+    void *findSymbol(const char *symbolName);
+};
+}
+
+#endif  // CHIP_8_RECOMPILEDPROGRAM_H
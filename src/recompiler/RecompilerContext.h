@@ -0,0 +1,82 @@
+#ifndef CHIP_8_RECOMPILERCONTEXT_H
+#define CHIP_8_RECOMPILERCONTEXT_H
+
+#include <cstdint>
+#include "../constants/Constants.h"
+#include "../cpu/Cpu.h"
+
+/**
+ * Everything recompiled code needs in order to run a chip-8 program in place of the Cpu's interpreter.
+ * This header is included by the C++ code that chip_8_recompile generates, so it is part of the interface between the emulator and
+ * recompiled libraries. Generated code reads and writes the cpu's registers through the references held here, calls the Memory/IDisplay/
+ * IInputController dependencies of the cpu directly, and hands any opcode it doesn't translate back to the cpu with Cpu::executeOpcodeAt().
+ */
+namespace Chip8 {
+class RecompilerContext {
+   public:
+    explicit RecompilerContext(Cpu &cpu)
+        : cpu(cpu),
+          registers(cpu.generalPurposeRegisters),
+          indexRegister(cpu.indexRegister),
+          programCounter(cpu.programCounter),
+          delayTimer(cpu.delayTimerRegister),
+          soundTimer(cpu.soundTimerRegister),
+          memory(cpu.memory),
+          display(cpu.display),
+          inputController(cpu.inputController) {}
+
+    Cpu &cpu;
+    uint8_t *registers;
+    uint16_t &indexRegister;
+    uint16_t &programCounter;
+    uint8_t &delayTimer;
+    uint8_t &soundTimer;
+    Memory &memory;
+    IDisplay &display;
+    IInputController &inputController;
+
+    /**
+     * Must be called once for every translated instruction, since the cpu updates its timers on every cycle
+     */
+    void updateTimers() {
+        if (delayTimer > 0) {
+            delayTimer--;
+        }
+        if (soundTimer > 0) {
+            soundTimer--;
+        }
+    }
+
+    /**
+     * Must be used instead of calling the display directly, so the cpu's count of screen updates stays accurate
+     */
+    void updateScreen() { cpu.updateScreen(); }
+
+    /**
+     * @return true if the opcode at address is still the one the code was recompiled from. Recompiled code checks this before running,
+     * so that programs that modify themselves fall back to the interpreter
+     */
+    bool isOpcodeAt(uint16_t address, uint16_t opcode) {
+        return memory.getDataAtAddress(address) == (opcode >> Constants::BITS_IN_BYTE) &&
+               memory.getDataAtAddress(address + 1) == (opcode & OpcodeBitmasks::LAST_BYTE);
+    }
+};
+
+/**
+ * Runs the basic block starting at the address the block was recompiled from.
+ * @return the number of cycles that were executed, or 0 if nothing was executed because the code in memory no longer matches
+ */
+typedef unsigned int (*RecompiledBlockFunction)(RecompilerContext &context);
+
+class RecompiledBlock {
+   public:
+    uint16_t address;
+    RecompiledBlockFunction function;
+};
+
+// every recompiled library exports an array of RecompiledBlocks and the number of entries in it under these names
+const char *const RECOMPILED_BLOCKS_SYMBOL = "CHIP8_RECOMPILED_BLOCKS";
+const char *const RECOMPILED_BLOCK_COUNT_SYMBOL = "CHIP8_RECOMPILED_BLOCK_COUNT";
+}
+
+#endif  // CHIP_8_RECOMPILERCONTEXT_H
@@ -1,8 +1,10 @@
 #include "Memory.h"
+#include <cstring>
+#include <string>
 #include "../exceptions/IndexOutOfBoundsException.h"
 
 namespace Chip8 {
-uint8_t Memory::getDataAtAddress(unsigned int address) {
+uint8_t Memory::getDataAtAddress(unsigned int address) const {
     checkAddressInBounds(address);
     return memory[address];
 }
@@ -12,9 +14,31 @@ void Memory::setDataAtAddress(unsigned int address, uint8_t data) {
     memory[address] = data;
 }
 
-void Memory::checkAddressInBounds(unsigned int address) {
+void Memory::copyTo(uint8_t *destination) const { std::memcpy(destination, memory, NUM_BYTES_OF_MEMORY); }
+
+void Memory::copyFrom(const uint8_t *source) { std::memcpy(memory, source, NUM_BYTES_OF_MEMORY); }
+
+void Memory::copyFrom(unsigned int address, const uint8_t *source, size_t size) {
+    checkRangeInBounds(address, size);
+    std::memcpy(memory + address, source, size);
+}
+
+void Memory::fill(unsigned int address, uint8_t value, size_t size) {
+    checkRangeInBounds(address, size);
+    std::memset(memory + address, value, size);
+}
+
+void Memory::checkAddressInBounds(unsigned int address) const {
     if (address >= NUM_BYTES_OF_MEMORY) {
-        throw IndexOutOfBoundsException("Address can't be bigger than memory size: " + NUM_BYTES_OF_MEMORY);
+        throw IndexOutOfBoundsException("Address " + std::to_string(address) + " is past the end of memory (size " +
+                                         std::to_string(NUM_BYTES_OF_MEMORY) + ")");
+    }
+}
+
+void Memory::checkRangeInBounds(unsigned int address, size_t size) const {
+    if (address > NUM_BYTES_OF_MEMORY || size > NUM_BYTES_OF_MEMORY - address) {
+        throw IndexOutOfBoundsException("Addresses " + std::to_string(address) + " to " + std::to_string(address + size) +
+                                         " are past the end of memory (size " + std::to_string(NUM_BYTES_OF_MEMORY) + ")");
     }
 }
 }
\ No newline at end of file
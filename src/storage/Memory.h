@@ -1,6 +1,7 @@
 #ifndef CHIP_8_MEMORY_H
 #define CHIP_8_MEMORY_H
 
+#include <cstddef>
 #include <cstdint>
 
 /**
@@ -12,14 +13,36 @@ class Memory {
    public:
     static const int NUM_BYTES_OF_MEMORY = 4096;
 
-    uint8_t getDataAtAddress(unsigned int address);
+    uint8_t getDataAtAddress(unsigned int address) const;
 
     void setDataAtAddress(unsigned int address, uint8_t data);
 
+    /**
+     * Copies all NUM_BYTES_OF_MEMORY bytes of memory to destination
+     */
+    void copyTo(uint8_t *destination) const;
+
+    /**
+     * Overwrites all of memory with the NUM_BYTES_OF_MEMORY bytes at source
+     */
+    void copyFrom(const uint8_t *source);
+
+    /**
+     * Overwrites the size bytes of memory starting at address with the bytes at source, checking the bounds once for the whole range
+     */
+    void copyFrom(unsigned int address, const uint8_t *source, size_t size);
+
+    /**
+     * Sets the size bytes of memory starting at address to value
+     */
+    void fill(unsigned int address, uint8_t value, size_t size);
+
    private:
     uint8_t memory[NUM_BYTES_OF_MEMORY];
 
-    void checkAddressInBounds(unsigned int address);
+    void checkAddressInBounds(unsigned int address) const;
+
+    void checkRangeInBounds(unsigned int address, size_t size) const;
 };
 }
 
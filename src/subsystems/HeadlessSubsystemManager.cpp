@@ -0,0 +1,13 @@
+#include "HeadlessSubsystemManager.h"
+
+namespace Chip8 {
+HeadlessSubsystemManager::HeadlessSubsystemManager(ScriptedInputController inputController) : inputController(inputController) {}
+
+IInputController &HeadlessSubsystemManager::getInputController() { return inputController; }
+
+IDisplay &HeadlessSubsystemManager::getDisplay() { return display; }
+
+ScriptedInputController &HeadlessSubsystemManager::getScriptedInputController() { return inputController; }
+
+HeadlessDisplay &HeadlessSubsystemManager::getHeadlessDisplay() { return display; }
+}
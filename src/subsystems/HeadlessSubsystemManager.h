@@ -0,0 +1,31 @@
+#ifndef CHIP_8_HEADLESSSUBSYSTEMMANAGER_H
+#define CHIP_8_HEADLESSSUBSYSTEMMANAGER_H
+
+#include "ISubsystemManager.h"
+#include "display/HeadlessDisplay.h"
+#include "input/ScriptedInputController.h"
+
+/**
+ * A subsystem manager for running the emulator without any windowing or input system: the screen is kept in memory and input comes
+ * from a script. Creating it costs next to nothing, unlike SdlSubsystemManager, which initializes video when it is created.
+ */
+namespace Chip8 {
+class HeadlessSubsystemManager : public ISubsystemManager {
+   public:
+    HeadlessSubsystemManager(ScriptedInputController inputController = ScriptedInputController());
+
+    IInputController &getInputController() override;
+
+    IDisplay &getDisplay() override;
+
+    ScriptedInputController &getScriptedInputController();
+
+    HeadlessDisplay &getHeadlessDisplay();
+
+   private:
+    HeadlessDisplay display;
+    ScriptedInputController inputController;
+};
+}
+
+#endif  // CHIP_8_HEADLESSSUBSYSTEMMANAGER_H
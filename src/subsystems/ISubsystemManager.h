@@ -1,6 +1,7 @@
 #ifndef CHIP_8_ISUBSYSTEMMANAGER_H
 #define CHIP_8_ISUBSYSTEMMANAGER_H
 
+#include "audio/IAudio.h"
 #include "display/IDisplay.h"
 #include "input/IInputController.h"
 
@@ -14,6 +15,11 @@ class ISubsystemManager {
 
     virtual IDisplay &getDisplay() = 0;
 
+    /**
+     * @return the audio output, or nullptr if the emulator should run without sound
+     */
+    virtual IAudio *getAudio() { return nullptr; }
+
     virtual ~ISubsystemManager(){};
 };
 }
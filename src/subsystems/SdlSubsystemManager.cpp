@@ -1,4 +1,6 @@
 #include "SdlSubsystemManager.h"
+#include <iostream>
+#include "../exceptions/InitializationException.h"
 #include "display/Display.h"
 #include "input/InputController.h"
 
@@ -7,7 +9,18 @@ IInputController &SdlSubsystemManager::getInputController() { return *inputContr
 
 IDisplay &SdlSubsystemManager::getDisplay() { return *display; }
 
-SdlSubsystemManager::SdlSubsystemManager() : display(new Display), inputController(new InputController) {}
+IAudio *SdlSubsystemManager::getAudio() { return audio.get(); }
+
+void SdlSubsystemManager::setKeyMap(const KeyMap &keyMap) { static_cast<InputController &>(*inputController).setKeyMap(keyMap); }
+
+SdlSubsystemManager::SdlSubsystemManager(uint16_t audioBufferSize) : display(new Display), inputController(new InputController) {
+    try {
+        audio.reset(new SdlAudio(audioBufferSize));
+    } catch (const InitializationException &e) {
+        // sound is optional, so machines without an audio device can still run games
+        std::cout << "Running without sound: " << e.what() << std::endl;
+    }
+}
 
 SdlSubsystemManager::~SdlSubsystemManager() {
     // manually destroy these smart pointers so they are freed before calling SDL_Quit()
@@ -15,6 +28,7 @@ SdlSubsystemManager::~SdlSubsystemManager() {
     // but the documentation here seems to say it is: https://wiki.libsdl.org/SDL_Quit
     display.reset();
     inputController.reset();
+    audio.reset();
     SDL_Quit();
 }
 }
\ No newline at end of file
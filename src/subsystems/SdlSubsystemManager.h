@@ -3,6 +3,8 @@
 
 #include <memory>
 #include "ISubsystemManager.h"
+#include "audio/SdlAudio.h"
+#include "input/KeyMap.h"
 
 /**
  * A class that controls the initialization and destruction of subsystems implemented with the SDL library
@@ -10,17 +12,28 @@
 namespace Chip8 {
 class SdlSubsystemManager : public ISubsystemManager {
    public:
-    SdlSubsystemManager();
+    /**
+     * @param audioBufferSize see SdlAudio. If no audio device can be opened, the emulator runs without sound
+     */
+    SdlSubsystemManager(uint16_t audioBufferSize = SdlAudio::DEFAULT_BUFFER_SIZE);
 
     IInputController &getInputController() override;
 
     IDisplay &getDisplay() override;
 
+    IAudio *getAudio() override;
+
+    /**
+     * Replaces the keyboard mapping of the input controller. Must be called from the thread that polls for key presses
+     */
+    void setKeyMap(const KeyMap &keyMap);
+
     virtual ~SdlSubsystemManager();
 
    private:
     std::unique_ptr<IDisplay> display;
     std::unique_ptr<IInputController> inputController;
+    std::unique_ptr<IAudio> audio;
 };
 }
 
@@ -0,0 +1,61 @@
+#include "AudioSampleQueue.h"
+#include <algorithm>
+#include "../../exceptions/InitializationException.h"
+
+namespace Chip8 {
+AudioSampleQueue::AudioSampleQueue(uint32_t sampleRate, uint32_t maxQueuedSamples, uint32_t toneFrequency)
+    : sampleRate(sampleRate), maxQueuedSamples(maxQueuedSamples) {
+    if (sampleRate == 0 || maxQueuedSamples > MAX_CAPACITY) {
+        throw InitializationException("Audio buffers can hold at most 16384 samples");
+    }
+    phaseIncrement = (uint32_t)(((uint64_t)toneFrequency << 32) / sampleRate);
+}
+
+void AudioSampleQueue::queueTone(bool isToneOn, uint32_t numSamples) {
+    uint32_t numQueuedSamples = samples.size();
+    uint32_t numFreeSamples = maxQueuedSamples > numQueuedSamples ? maxQueuedSamples - numQueuedSamples : 0;
+    uint32_t numSamplesToQueue = std::min(numSamples, numFreeSamples);
+    if (numSamplesToQueue < numSamples) {
+        numSamplesDropped.fetch_add(numSamples - numSamplesToQueue, std::memory_order_relaxed);
+    }
+
+    int16_t chunk[NUM_SAMPLES_PER_CHUNK];
+    while (numSamplesToQueue > 0) {
+        uint32_t numChunkSamples = numSamplesToQueue < NUM_SAMPLES_PER_CHUNK ? numSamplesToQueue : NUM_SAMPLES_PER_CHUNK;
+        for (uint32_t i = 0; i < numChunkSamples; i++) {
+            if (isToneOn) {
+                // high for the first half of each period, and low for the second half
+                chunk[i] = (phase & 0x80000000) ? -TONE_AMPLITUDE : TONE_AMPLITUDE;
+                phase += phaseIncrement;
+            } else {
+                chunk[i] = 0;
+            }
+        }
+        samples.tryPushMany(chunk, numChunkSamples);
+        numSamplesToQueue -= numChunkSamples;
+    }
+}
+
+void AudioSampleQueue::readSamples(int16_t *output, uint32_t numSamples) {
+    uint32_t numSamplesRead = samples.tryPopMany(output, numSamples);
+    std::fill(output + numSamplesRead, output + numSamples, 0);
+    numSamplesPlayed.fetch_add(numSamplesRead, std::memory_order_relaxed);
+
+    // running dry right after playing normally is an underrun. Staying dry (ex: while the emulator is paused) isn't counted again
+    bool isPlaying = numSamplesRead == numSamples;
+    if (!isPlaying && (numSamplesRead > 0 || wasPlaying)) {
+        numUnderruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    wasPlaying = isPlaying;
+}
+
+uint32_t AudioSampleQueue::getNumQueuedSamples() const { return samples.size(); }
+
+uint64_t AudioSampleQueue::getNumUnderruns() const { return numUnderruns.load(std::memory_order_relaxed); }
+
+uint64_t AudioSampleQueue::getNumSamplesDropped() const { return numSamplesDropped.load(std::memory_order_relaxed); }
+
+uint64_t AudioSampleQueue::getNumSamplesPlayed() const { return numSamplesPlayed.load(std::memory_order_relaxed); }
+
+double AudioSampleQueue::getQueuedLatencyMillis() const { return getNumQueuedSamples() * 1000.0 / sampleRate; }
+}
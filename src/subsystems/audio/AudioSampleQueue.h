@@ -0,0 +1,69 @@
+#ifndef CHIP_8_AUDIOSAMPLEQUEUE_H
+#define CHIP_8_AUDIOSAMPLEQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include "../../utils/SpscRingBuffer.h"
+
+/**
+ * Carries audio samples from the emulation thread, which generates the tone as a square wave, to an audio callback that plays them.
+ * The two sides only share a lock-free ring of samples and a few atomic counters, so the callback never allocates, locks or waits.
+ * At most maxQueuedSamples samples are ever queued, which bounds the latency between the sound timer changing and the change being heard.
+ */
+namespace Chip8 {
+class AudioSampleQueue {
+   public:
+    static const uint32_t MAX_CAPACITY = 16384;
+    static const uint32_t DEFAULT_TONE_FREQUENCY = 440;
+    static const int16_t TONE_AMPLITUDE = 4000;
+
+    AudioSampleQueue(uint32_t sampleRate, uint32_t maxQueuedSamples, uint32_t toneFrequency = DEFAULT_TONE_FREQUENCY);
+
+    /**
+     * Emulation thread only. Queues numSamples samples of the tone (or of silence), dropping any that don't fit
+     */
+    void queueTone(bool isToneOn, uint32_t numSamples);
+
+    /**
+     * Audio callback only. Fills output with queued samples, and with silence if there aren't enough
+     */
+    void readSamples(int16_t *output, uint32_t numSamples);
+
+    uint32_t getNumQueuedSamples() const;
+
+    /**
+     * @return the number of times the audio callback ran out of queued samples, whether they were the tone or silence, after a callback
+     * that had enough. Running out over several callbacks in a row (ex: while the emulator is paused) counts once
+     */
+    uint64_t getNumUnderruns() const;
+
+    /**
+     * @return the number of samples that were dropped because the queue was full
+     */
+    uint64_t getNumSamplesDropped() const;
+
+    uint64_t getNumSamplesPlayed() const;
+
+    /**
+     * @return how long a sample queued now will wait before the audio callback reads it
+     */
+    double getQueuedLatencyMillis() const;
+
+   private:
+    static const uint32_t NUM_SAMPLES_PER_CHUNK = 256;
+
+    SpscRingBuffer<int16_t, MAX_CAPACITY> samples;
+    uint32_t sampleRate;
+    uint32_t maxQueuedSamples;
+    // the position in the square wave's period as a fraction of 2^32, so it wraps around by itself at the end of every period
+    uint32_t phase = 0;
+    uint32_t phaseIncrement;
+    // only used by the audio callback
+    bool wasPlaying = false;
+    std::atomic<uint64_t> numUnderruns{0};
+    std::atomic<uint64_t> numSamplesDropped{0};
+    std::atomic<uint64_t> numSamplesPlayed{0};
+};
+}
+
+#endif  // CHIP_8_AUDIOSAMPLEQUEUE_H
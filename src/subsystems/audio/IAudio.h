@@ -0,0 +1,35 @@
+#ifndef CHIP_8_IAUDIO_H
+#define CHIP_8_IAUDIO_H
+
+#include <cstdint>
+
+/**
+ * An interface for playing the chip-8's tone, which sounds whenever the sound timer is non-zero.
+ * The emulator generates audio in step with emulated time: after running some cycles, it queues as many samples as those cycles took.
+ */
+namespace Chip8 {
+class IAudio {
+   public:
+    virtual ~IAudio(){};
+
+    virtual uint32_t getSampleRate() const = 0;
+
+    /**
+     * Queues numSamples samples of the tone, or of silence. Called from the emulation thread, so it must never block.
+     * Samples that don't fit (ex: when the emulator is running faster than real time) are dropped.
+     */
+    virtual void queueSamples(bool isToneOn, uint32_t numSamples) = 0;
+
+    /**
+     * @return the number of times the device ran out of queued samples to play, or 0 if this can't be told
+     */
+    virtual uint64_t getNumUnderruns() const { return 0; }
+
+    /**
+     * @return how long a sample queued now takes to be heard, or 0 if this can't be told
+     */
+    virtual double getLatencyMillis() const { return 0; }
+};
+}
+
+#endif  // CHIP_8_IAUDIO_H
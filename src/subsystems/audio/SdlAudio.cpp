@@ -0,0 +1,57 @@
+#include "SdlAudio.h"
+#include <string>
+#include "../../exceptions/InitializationException.h"
+
+namespace Chip8 {
+SdlAudio::SdlAudio(uint16_t bufferSize) {
+    if (bufferSize == 0 || bufferSize > MAX_BUFFER_SIZE) {
+        throw InitializationException("Audio buffers must hold from 1 to " + std::to_string(MAX_BUFFER_SIZE) + " samples");
+    }
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        throw InitializationException(std::string("Audio subsystem could not be initialized. SDL_Error: ") + SDL_GetError());
+    }
+
+    SDL_AudioSpec desiredSpec = {};
+    desiredSpec.freq = SAMPLE_RATE;
+    desiredSpec.format = AUDIO_S16SYS;
+    desiredSpec.channels = 1;
+    desiredSpec.samples = bufferSize;
+    desiredSpec.callback = &SdlAudio::fillAudioBuffer;
+    desiredSpec.userdata = this;
+    // no changes are allowed, so SDL converts to whatever the hardware wants, and the callback can always write 16-bit mono samples
+    device = SDL_OpenAudioDevice(NULL, 0, &desiredSpec, &spec, 0);
+    if (device == 0) {
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        throw InitializationException(std::string("Audio device could not be opened. SDL_Error: ") + SDL_GetError());
+    }
+
+    // the queue must exist before the device is unpaused, since the callback starts reading from it right away. The destructor won't run
+    // if this throws (ex: the device was opened with a larger buffer than asked for), so the device is closed here
+    try {
+        sampleQueue.reset(new AudioSampleQueue(spec.freq, spec.samples * NUM_BUFFERS_QUEUED_AHEAD));
+    } catch (...) {
+        SDL_CloseAudioDevice(device);
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        throw;
+    }
+    SDL_PauseAudioDevice(device, 0);
+}
+
+SdlAudio::~SdlAudio() {
+    SDL_CloseAudioDevice(device);
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+uint32_t SdlAudio::getSampleRate() const { return spec.freq; }
+
+void SdlAudio::queueSamples(bool isToneOn, uint32_t numSamples) { sampleQueue->queueTone(isToneOn, numSamples); }
+
+uint64_t SdlAudio::getNumUnderruns() const { return sampleQueue->getNumUnderruns(); }
+
+double SdlAudio::getLatencyMillis() const { return sampleQueue->getQueuedLatencyMillis() + spec.samples * 1000.0 / spec.freq; }
+
+void SdlAudio::fillAudioBuffer(void *userData, Uint8 *stream, int length) {
+    SdlAudio *audio = static_cast<SdlAudio *>(userData);
+    audio->sampleQueue->readSamples(reinterpret_cast<int16_t *>(stream), length / sizeof(int16_t));
+}
+}
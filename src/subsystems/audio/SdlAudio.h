@@ -0,0 +1,52 @@
+#ifndef CHIP_8_SDLAUDIO_H
+#define CHIP_8_SDLAUDIO_H
+
+#include <SDL.h>
+#include <memory>
+#include "AudioSampleQueue.h"
+#include "IAudio.h"
+
+/**
+ * An IAudio implementation using an SDL audio device. SDL's audio callback runs on its own thread and reads from an AudioSampleQueue, so
+ * it never waits on the emulation thread.
+ * Smaller buffers lower latency, but give the emulation thread less slack before the device runs out of samples (an underrun).
+ */
+namespace Chip8 {
+class SdlAudio : public IAudio {
+   public:
+    static const int SAMPLE_RATE = 44100;
+    static const uint16_t DEFAULT_BUFFER_SIZE = 512;
+    static const uint32_t NUM_BUFFERS_QUEUED_AHEAD = 2;
+    // the emulation thread's queue must fit every buffer it queues ahead
+    static const uint16_t MAX_BUFFER_SIZE = AudioSampleQueue::MAX_CAPACITY / NUM_BUFFERS_QUEUED_AHEAD;
+
+    /**
+     * @param bufferSize the number of samples the audio device plays per callback, from 1 to MAX_BUFFER_SIZE. The emulation thread queues
+     * at most NUM_BUFFERS_QUEUED_AHEAD buffers ahead
+     * @throws InitializationException if bufferSize is out of range, or the audio device can't be opened
+     */
+    explicit SdlAudio(uint16_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    ~SdlAudio() override;
+
+    uint32_t getSampleRate() const override;
+
+    void queueSamples(bool isToneOn, uint32_t numSamples) override;
+
+    uint64_t getNumUnderruns() const override;
+
+    /**
+     * @return the latency of the queue plus the device's own buffer
+     */
+    double getLatencyMillis() const override;
+
+   private:
+    SDL_AudioDeviceID device = 0;
+    SDL_AudioSpec spec;
+    std::unique_ptr<AudioSampleQueue> sampleQueue;
+
+    static void fillAudioBuffer(void *userData, Uint8 *stream, int length);
+};
+}
+
+#endif  // CHIP_8_SDLAUDIO_H
@@ -1,30 +1,29 @@
 #include "Display.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <sstream>
 #include "../../exceptions/InitializationException.h"
+#include "../../utils/PhaseTracer.h"
 
 namespace Chip8 {
-void Display::setPixel(int x, int y, bool value) {
-    if (isPixelInBounds(x, y)) {
-        int pixelIndex = getPixelIndex(x, y);
-        screenPixels[pixelIndex] = value;
-        if (value) {
-            setSdlPixel(x, y, 0xFFFF);
-        } else {
-            setSdlPixel(x, y, 0x0000);
-        }
-    }
-}
+// each glyph is 5 rows of 3 bits, with the leftmost pixel in the highest bit. Characters that aren't here are drawn as spaces
+static const char OVERLAY_FONT_CHARACTERS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ.:-/%";
+static const uint8_t OVERLAY_FONT[][5] = {
+    {7, 5, 5, 5, 7}, {2, 6, 2, 2, 7}, {7, 1, 7, 4, 7}, {7, 1, 3, 1, 7}, {5, 5, 7, 1, 1},  // 0-4
+    {7, 4, 7, 1, 7}, {7, 4, 7, 5, 7}, {7, 1, 1, 2, 2}, {7, 5, 7, 5, 7}, {7, 5, 7, 1, 7},  // 5-9
+    {2, 5, 7, 5, 5}, {6, 5, 6, 5, 6}, {3, 4, 4, 4, 3}, {6, 5, 5, 5, 6}, {7, 4, 6, 4, 7},  // A-E
+    {7, 4, 6, 4, 4}, {3, 4, 5, 5, 3}, {5, 5, 7, 5, 5}, {7, 2, 2, 2, 7}, {1, 1, 1, 5, 2},  // F-J
+    {5, 5, 6, 5, 5}, {4, 4, 4, 4, 7}, {5, 7, 7, 5, 5}, {6, 5, 5, 5, 5}, {2, 5, 5, 5, 2},  // K-O
+    {6, 5, 6, 4, 4}, {2, 5, 5, 6, 3}, {6, 5, 6, 5, 5}, {3, 4, 2, 1, 6}, {7, 2, 2, 2, 2},  // P-T
+    {5, 5, 5, 5, 7}, {5, 5, 5, 5, 2}, {5, 5, 7, 7, 5}, {5, 5, 2, 5, 5}, {5, 5, 2, 2, 2},  // U-Y
+    {7, 1, 2, 4, 7}, {0, 0, 0, 0, 2}, {0, 2, 0, 2, 0}, {0, 0, 7, 0, 0}, {1, 1, 2, 4, 4},  // Z . : - /
+    {5, 1, 2, 4, 5}                                                                        // %
+};
 
-bool Display::getPixel(int x, int y) {
-    if (isPixelInBounds(x, y)) {
-        return screenPixels[getPixelIndex(x, y)];
-    }
-    return false;
-}
-
-int Display::getPixelIndex(int x, int y) const { return x + SCREEN_WIDTH * y; }
+void Display::setPixel(int x, int y, bool value) { frameBuffer.setPixel(x, y, value); }
 
-bool Display::isPixelInBounds(int x, int y) { return !(x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT || x < 0 || y < 0); }
+bool Display::getPixel(int x, int y) { return frameBuffer.getPixel(x, y); }
 
 void throwSdlError(std::string errorMessage) {
     std::ostringstream errorStringStream;
@@ -35,10 +34,6 @@ void throwSdlError(std::string errorMessage) {
 }
 
 Display::Display() {
-    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
-        screenPixels[i] = false;
-    }
-
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         throwSdlError("SDL could not initialize video!");
     }
@@ -56,11 +51,11 @@ Display::Display() {
     }
 }
 
-void Display::setSdlPixel(int x, int y, uint32_t pixel) {
+void Display::setSdlPixel(int x, int y, int scale, uint32_t pixel) {
     Uint32 *pixels = (Uint32 *)surface->pixels;
-    for (int row = 0; row < SCREEN_SCALE; row++) {
-        for (int col = 0; col < SCREEN_SCALE; col++) {
-            pixels[(y * PHYSICAL_SCREEN_WIDTH * SCREEN_SCALE) + (row * PHYSICAL_SCREEN_WIDTH) + (x * SCREEN_SCALE) + col] = pixel;
+    for (int row = 0; row < scale; row++) {
+        for (int col = 0; col < scale; col++) {
+            pixels[(y * PHYSICAL_SCREEN_WIDTH * scale) + (row * PHYSICAL_SCREEN_WIDTH) + (x * scale) + col] = pixel;
         }
     }
 }
@@ -71,13 +66,97 @@ Display::~Display() {
     SDL_QuitSubSystem(SDL_INIT_VIDEO);
 }
 
-void Display::clearScreen() {
-    for (int width = 0; width < SCREEN_WIDTH; width++) {
-        for (int height = 0; height < SCREEN_HEIGHT; height++) {
-            setPixel(width, height, false);
+void Display::clearScreen() { frameBuffer.clear(); }
+
+void Display::setHighResolution(bool isHighResolution) { frameBuffer.setHighResolution(isHighResolution); }
+
+bool Display::isHighResolution() { return frameBuffer.isHighResolution; }
+
+void Display::scrollDown(int numPixels) { frameBuffer.scrollDown(numPixels); }
+
+void Display::scrollRight(int numPixels) { frameBuffer.scrollRight(numPixels); }
+
+void Display::scrollLeft(int numPixels) { frameBuffer.scrollLeft(numPixels); }
+
+void Display::copyFrameBufferTo(FrameBuffer &frameBuffer) { frameBuffer = this->frameBuffer; }
+
+void Display::copyFrameBufferFrom(const FrameBuffer &frameBuffer) { this->frameBuffer = frameBuffer; }
+
+void Display::updateScreen() {
+    frames.getWriteBuffer() = frameBuffer;
+    frames.publish();
+}
+
+bool Display::presentFrame() {
+    bool isNewFrame = frames.update();
+    if (!isNewFrame && !isOverlayChanged) {
+        return false;
+    }
+    const FrameBuffer &newFrameBuffer = frames.getReadBuffer();
+    {
+        ScopedPhase phase("draw");
+        int scale = PHYSICAL_SCREEN_WIDTH / newFrameBuffer.getWidth();
+        bool isResolutionChanged = newFrameBuffer.isHighResolution != presentedFrameBuffer.isHighResolution;
+        for (int y = 0; y < newFrameBuffer.getHeight(); y++) {
+            // only redraw the pixels that changed since the last frame that was presented, and the ones the overlay was drawn over.
+            // After the resolution changes, every pixel is a different size, so they are all redrawn
+            bool isRedrawn = isResolutionChanged || y * scale < overlayHeight;
+            if (!isRedrawn && newFrameBuffer.rows[y] == presentedFrameBuffer.rows[y]) {
+                continue;
+            }
+            for (int x = 0; x < newFrameBuffer.getWidth(); x++) {
+                bool value = newFrameBuffer.getPixel(x, y);
+                if (isRedrawn || value != presentedFrameBuffer.getPixel(x, y)) {
+                    setSdlPixel(x, y, scale, value ? 0xFFFF : 0x0000);
+                }
+            }
         }
+        drawOverlay();
     }
+    presentedFrameBuffer = newFrameBuffer;
+    isOverlayChanged = false;
+    ScopedPhase phase("update window");
+    SDL_UpdateWindowSurface(window);
+    return isNewFrame;
 }
 
-void Display::updateScreen() { SDL_UpdateWindowSurface(window); }
+void Display::setOverlayText(const std::vector<std::string> &lines) {
+    if (lines != overlayLines) {
+        overlayLines = lines;
+        isOverlayChanged = true;
+    }
+}
+
+void Display::drawOverlay() {
+    const int glyphAdvance = (OVERLAY_GLYPH_WIDTH + 1) * OVERLAY_SCALE;
+    const int lineHeight = (OVERLAY_GLYPH_HEIGHT + 1) * OVERLAY_SCALE;
+    Uint32 backgroundColor = SDL_MapRGB(surface->format, 0x00, 0x00, 0x00);
+    Uint32 textColor = SDL_MapRGB(surface->format, 0x00, 0xFF, 0x00);
+    for (size_t lineNumber = 0; lineNumber < overlayLines.size(); lineNumber++) {
+        const std::string &line = overlayLines[lineNumber];
+        int top = (int)lineNumber * lineHeight;
+        SDL_Rect background = {0, top, std::min((int)line.size() * glyphAdvance + OVERLAY_SCALE, PHYSICAL_SCREEN_WIDTH),
+                               lineHeight + OVERLAY_SCALE};
+        SDL_FillRect(surface, &background, backgroundColor);
+        for (size_t characterNumber = 0; characterNumber < line.size(); characterNumber++) {
+            char character = (char)std::toupper((unsigned char)line[characterNumber]);
+            const char *fontCharacter = character == '\0' ? nullptr : std::strchr(OVERLAY_FONT_CHARACTERS, character);
+            int left = OVERLAY_SCALE + (int)characterNumber * glyphAdvance;
+            if (fontCharacter == nullptr || left + glyphAdvance > PHYSICAL_SCREEN_WIDTH) {
+                continue;
+            }
+            const uint8_t *glyph = OVERLAY_FONT[fontCharacter - OVERLAY_FONT_CHARACTERS];
+            for (int glyphY = 0; glyphY < OVERLAY_GLYPH_HEIGHT; glyphY++) {
+                for (int glyphX = 0; glyphX < OVERLAY_GLYPH_WIDTH; glyphX++) {
+                    if ((glyph[glyphY] >> (OVERLAY_GLYPH_WIDTH - 1 - glyphX)) & 1) {
+                        SDL_Rect pixel = {left + glyphX * OVERLAY_SCALE, top + OVERLAY_SCALE + glyphY * OVERLAY_SCALE, OVERLAY_SCALE,
+                                          OVERLAY_SCALE};
+                        SDL_FillRect(surface, &pixel, textColor);
+                    }
+                }
+            }
+        }
+    }
+    overlayHeight = overlayLines.empty() ? 0 : (int)overlayLines.size() * lineHeight + OVERLAY_SCALE;
+}
 }
\ No newline at end of file
@@ -2,11 +2,18 @@
 #define CHIP_8_DISPLAY_H
 
 #include <SDL.h>
+#include <string>
+#include <vector>
+#include "../../utils/TripleBuffer.h"
+#include "FrameBuffer.h"
 #include "IDisplay.h"
 
 /**
- * A (very) simple IDisplay implementation using SDL. Creates a window that is SCREEN_SCALE * the CHIP-8's physical screen resolution.
- * Ideally, this class should allow the user to specify an arbitrary scale, but the scale is currently hardcoded in SCREEN_SCALE.
+ * A (very) simple IDisplay implementation using SDL. Creates a window that is LOW_RESOLUTION_SCALE * the CHIP-8's low resolution, and
+ * draws high resolution pixels at half that scale, so the window is the same size in both resolutions.
+ * Ideally, this class should allow the user to specify an arbitrary scale, but the scale is currently hardcoded in LOW_RESOLUTION_SCALE.
+ * The emulation thread draws into a FrameBuffer and hands finished frames over through a triple buffer in updateScreen(). SDL is only
+ * called from presentFrame(), on the thread that created the window, so drawing never waits on the window being updated.
  */
 namespace Chip8 {
 class Display : public IDisplay {
@@ -21,25 +28,57 @@ class Display : public IDisplay {
 
     void clearScreen() override;
 
+    void setHighResolution(bool isHighResolution) override;
+
+    bool isHighResolution() override;
+
+    void scrollDown(int numPixels) override;
+
+    void scrollRight(int numPixels) override;
+
+    void scrollLeft(int numPixels) override;
+
     void updateScreen() override;
 
+    void copyFrameBufferTo(FrameBuffer &frameBuffer) override;
+
+    void copyFrameBufferFrom(const FrameBuffer &frameBuffer) override;
+
+    bool presentFrame() override;
+
+    void setOverlayText(const std::vector<std::string> &lines) override;
+
    private:
-    static const int SCREEN_SCALE = 10;
-    static const int SCREEN_WIDTH = 64;
-    static const int SCREEN_HEIGHT = 32;
-    static const int PHYSICAL_SCREEN_WIDTH = SCREEN_WIDTH * SCREEN_SCALE;
-    static const int PHYSICAL_SCREEN_HEIGHT = SCREEN_HEIGHT * SCREEN_SCALE;
+    static const int LOW_RESOLUTION_SCALE = 10;
+    static const int PHYSICAL_SCREEN_WIDTH = FrameBuffer::LOW_RESOLUTION_WIDTH * LOW_RESOLUTION_SCALE;
+    static const int PHYSICAL_SCREEN_HEIGHT = FrameBuffer::LOW_RESOLUTION_HEIGHT * LOW_RESOLUTION_SCALE;
+    // overlay text is drawn with a 3x5 font, at OVERLAY_SCALE physical pixels per font pixel
+    static const int OVERLAY_SCALE = 2;
+    static const int OVERLAY_GLYPH_WIDTH = 3;
+    static const int OVERLAY_GLYPH_HEIGHT = 5;
 
     SDL_Surface *surface = NULL;
     SDL_Window *window = NULL;
 
-    bool screenPixels[SCREEN_WIDTH * SCREEN_HEIGHT];
-
-    bool isPixelInBounds(int x, int y);
+    // only used by the emulation thread
+    FrameBuffer frameBuffer = {};
+    TripleBuffer<FrameBuffer> frames;
+    // only used by the thread that presents frames
+    FrameBuffer presentedFrameBuffer = {};
+    std::vector<std::string> overlayLines;
+    bool isOverlayChanged = false;
+    // the number of physical rows, from the top, that the overlay drawn last covers
+    int overlayHeight = 0;
 
-    int getPixelIndex(int x, int y) const;
+    /**
+     * Fills the scale x scale square of the surface that the chip-8 pixel (x, y) covers
+     */
+    void setSdlPixel(int x, int y, int scale, uint32_t pixel);
 
-    void setSdlPixel(int x, int y, uint32_t pixel);
+    /**
+     * Draws the overlay lines over the top left of the surface, on a black background
+     */
+    void drawOverlay();
 };
 }
 
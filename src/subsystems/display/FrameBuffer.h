@@ -0,0 +1,134 @@
+#ifndef CHIP_8_FRAMEBUFFER_H
+#define CHIP_8_FRAMEBUFFER_H
+
+#include <cstdint>
+#include <cstring>
+#include "../../utils/HashUtil.h"
+
+/**
+ * The contents of the chip-8's monochrome screen, packed one bit per pixel. The screen is 64x32 in low resolution, and 128x64 in the
+ * SUPER-CHIP's high resolution.
+ * Each row of the screen is a single 128-bit integer, with the leftmost pixel in the most significant bit. In low resolution only the top
+ * left 64x32 pixels are used, so a low resolution row is the high 64 bits of the integer. This keeps a whole frame in 1KB, so it can be
+ * copied, compared and hashed cheaply, it matches the layout of sprite data (leftmost pixel in the most significant bit of each byte), and
+ * it makes scrolling the screen a shift of every row, or a move of the rows themselves.
+ * This class has no constructor on purpose: it is plain data, so it can be placed in memory that is shared with other processes.
+ */
+namespace Chip8 {
+class FrameBuffer {
+   public:
+    typedef unsigned __int128 Row;
+
+    static const int LOW_RESOLUTION_WIDTH = 64;
+    static const int LOW_RESOLUTION_HEIGHT = 32;
+    static const int MAX_WIDTH = 128;
+    static const int MAX_HEIGHT = 64;
+
+    Row rows[MAX_HEIGHT];
+    bool isHighResolution;
+
+    int getWidth() const { return isHighResolution ? MAX_WIDTH : LOW_RESOLUTION_WIDTH; }
+
+    int getHeight() const { return isHighResolution ? MAX_HEIGHT : LOW_RESOLUTION_HEIGHT; }
+
+    bool isPixelInBounds(int x, int y) const { return !(x >= getWidth() || y >= getHeight() || x < 0 || y < 0); }
+
+    /**
+     * @return the value of the pixel, or false if the pixel is out of bounds
+     */
+    bool getPixel(int x, int y) const { return isPixelInBounds(x, y) && ((rows[y] >> getBitIndex(x)) & 1) != 0; }
+
+    /**
+     * sets the value of the pixel. If the pixel is out of bounds, does nothing
+     */
+    void setPixel(int x, int y, bool value) {
+        if (isPixelInBounds(x, y)) {
+            Row pixelBit = (Row)1 << getBitIndex(x);
+            rows[y] = value ? (rows[y] | pixelBit) : (rows[y] & ~pixelBit);
+        }
+    }
+
+    /**
+     * @return the pixel at (x, y) of a 128x64 image of the screen, where every low resolution pixel is 2x2 pixels
+     */
+    bool getScaledPixel(int x, int y) const { return isHighResolution ? getPixel(x, y) : getPixel(x / 2, y / 2); }
+
+    void clear() { std::memset(rows, 0, sizeof(rows)); }
+
+    /**
+     * Clears the screen and switches to high or low resolution
+     */
+    void setHighResolution(bool isHighResolution) {
+        this->isHighResolution = isHighResolution;
+        clear();
+    }
+
+    /**
+     * Moves every row down by numRows. The rows that are moved off the bottom are lost, and the rows left at the top are cleared
+     */
+    void scrollDown(int numRows) {
+        int height = getHeight();
+        numRows = numRows < height ? numRows : height;
+        std::memmove(rows + numRows, rows, (height - numRows) * sizeof(Row));
+        std::memset(rows, 0, numRows * sizeof(Row));
+    }
+
+    /**
+     * Moves every pixel right by numPixels. The pixels moved off the right edge are lost, and the columns left on the left are cleared
+     */
+    void scrollRight(int numPixels) {
+        if (numPixels >= getWidth()) {
+            clear();
+            return;
+        }
+        Row rowMask = getRowMask();
+        for (int y = 0; y < getHeight(); y++) {
+            rows[y] = (rows[y] >> numPixels) & rowMask;
+        }
+    }
+
+    /**
+     * Moves every pixel left by numPixels. The pixels moved off the left edge are lost, and the columns left on the right are cleared
+     */
+    void scrollLeft(int numPixels) {
+        if (numPixels >= getWidth()) {
+            clear();
+            return;
+        }
+        for (int y = 0; y < getHeight(); y++) {
+            rows[y] = rows[y] << numPixels;
+        }
+    }
+
+    /**
+     * @return a hash of the screen. A low resolution frame hashes the same way it did before the screen had a high resolution (a 64-bit
+     * integer per row), so hashes recorded back then still match
+     */
+    uint64_t getHash(uint64_t hash = HashUtil::FNV1A_OFFSET_BASIS) const {
+        if (isHighResolution) {
+            return HashUtil::fnv1a((const uint8_t *)rows, sizeof(rows), hash);
+        }
+        for (int y = 0; y < LOW_RESOLUTION_HEIGHT; y++) {
+            uint64_t row = (uint64_t)(rows[y] >> LOW_RESOLUTION_WIDTH);
+            hash = HashUtil::fnv1a((const uint8_t *)&row, sizeof(row), hash);
+        }
+        return hash;
+    }
+
+    bool operator==(const FrameBuffer &other) const {
+        return isHighResolution == other.isHighResolution && std::memcmp(rows, other.rows, sizeof(rows)) == 0;
+    }
+
+    bool operator!=(const FrameBuffer &other) const { return !(*this == other); }
+
+   private:
+    static int getBitIndex(int x) { return MAX_WIDTH - 1 - x; }
+
+    /**
+     * @return the bits of a row that hold pixels in the current resolution
+     */
+    Row getRowMask() const { return isHighResolution ? ~(Row)0 : ~(Row)0 << (MAX_WIDTH - LOW_RESOLUTION_WIDTH); }
+};
+}
+
+#endif  // CHIP_8_FRAMEBUFFER_H
@@ -0,0 +1,31 @@
+#include "HeadlessDisplay.h"
+
+namespace Chip8 {
+HeadlessDisplay::HeadlessDisplay() { frameBuffer.setHighResolution(false); }
+
+void HeadlessDisplay::setPixel(int x, int y, bool value) { frameBuffer.setPixel(x, y, value); }
+
+bool HeadlessDisplay::getPixel(int x, int y) { return frameBuffer.getPixel(x, y); }
+
+void HeadlessDisplay::clearScreen() { frameBuffer.clear(); }
+
+void HeadlessDisplay::setHighResolution(bool isHighResolution) { frameBuffer.setHighResolution(isHighResolution); }
+
+bool HeadlessDisplay::isHighResolution() { return frameBuffer.isHighResolution; }
+
+void HeadlessDisplay::scrollDown(int numPixels) { frameBuffer.scrollDown(numPixels); }
+
+void HeadlessDisplay::scrollRight(int numPixels) { frameBuffer.scrollRight(numPixels); }
+
+void HeadlessDisplay::scrollLeft(int numPixels) { frameBuffer.scrollLeft(numPixels); }
+
+void HeadlessDisplay::updateScreen() { numScreenUpdates++; }
+
+void HeadlessDisplay::copyFrameBufferTo(FrameBuffer &frameBuffer) { frameBuffer = this->frameBuffer; }
+
+void HeadlessDisplay::copyFrameBufferFrom(const FrameBuffer &frameBuffer) { this->frameBuffer = frameBuffer; }
+
+const FrameBuffer &HeadlessDisplay::getFrameBuffer() const { return frameBuffer; }
+
+unsigned long HeadlessDisplay::getNumScreenUpdates() const { return numScreenUpdates; }
+}
@@ -0,0 +1,51 @@
+#ifndef CHIP_8_HEADLESSDISPLAY_H
+#define CHIP_8_HEADLESSDISPLAY_H
+
+#include "FrameBuffer.h"
+#include "IDisplay.h"
+
+/**
+ * An IDisplay implementation that keeps the screen in memory instead of showing it in a window.
+ * It needs no windowing system at all, so it is cheap to create and works on machines without a display (ex: build servers).
+ */
+namespace Chip8 {
+class HeadlessDisplay : public IDisplay {
+   public:
+    HeadlessDisplay();
+
+    void setPixel(int x, int y, bool value) override;
+
+    bool getPixel(int x, int y) override;
+
+    void clearScreen() override;
+
+    void setHighResolution(bool isHighResolution) override;
+
+    bool isHighResolution() override;
+
+    void scrollDown(int numPixels) override;
+
+    void scrollRight(int numPixels) override;
+
+    void scrollLeft(int numPixels) override;
+
+    /**
+     * There is no screen to update, so this only counts how many times the screen would have been updated
+     */
+    void updateScreen() override;
+
+    void copyFrameBufferTo(FrameBuffer &frameBuffer) override;
+
+    void copyFrameBufferFrom(const FrameBuffer &frameBuffer) override;
+
+    const FrameBuffer &getFrameBuffer() const;
+
+    unsigned long getNumScreenUpdates() const;
+
+   private:
+    FrameBuffer frameBuffer;
+    unsigned long numScreenUpdates = 0;
+};
+}
+
+#endif  // CHIP_8_HEADLESSDISPLAY_H
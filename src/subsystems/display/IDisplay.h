@@ -1,6 +1,10 @@
 #ifndef CHIP_8_IDISPLAY_H
 #define CHIP_8_IDISPLAY_H
 
+#include <string>
+#include <vector>
+#include "FrameBuffer.h"
+
 /**
  * An interface that must be implemented in order to allow the chip-8 emulator to draw any output onto the screen
  * The interface is fairly simple, allowing just about any platform to implement it as necessary, hopefully simplifying cross-platform
@@ -29,10 +33,66 @@ class IDisplay {
 
     virtual void clearScreen() = 0;
 
+    /**
+     * Switches between the 64x32 low resolution screen and the SUPER-CHIP's 128x64 high resolution screen, clearing it
+     */
+    virtual void setHighResolution(bool isHighResolution) = 0;
+
+    virtual bool isHighResolution() = 0;
+
+    /**
+     * Each of these moves the whole screen by a number of pixels of the current resolution. Pixels moved off the screen are lost, and the
+     * ones left behind are cleared. Like setPixel(), updateScreen() must be called for this to take effect.
+     */
+    virtual void scrollDown(int numPixels) = 0;
+
+    virtual void scrollRight(int numPixels) = 0;
+
+    virtual void scrollLeft(int numPixels) = 0;
+
     /**
      * sets all the pixels on the screen that were set with setPixel()
      */
     virtual void updateScreen() = 0;
+
+    /**
+     * Copies every pixel set with setPixel() into frameBuffer. Displays that keep their pixels in a FrameBuffer should override this
+     * with a single copy, since it is used to take snapshots of the emulator many times a second.
+     */
+    virtual void copyFrameBufferTo(FrameBuffer &frameBuffer) {
+        frameBuffer.setHighResolution(isHighResolution());
+        for (int y = 0; y < frameBuffer.getHeight(); y++) {
+            for (int x = 0; x < frameBuffer.getWidth(); x++) {
+                frameBuffer.setPixel(x, y, getPixel(x, y));
+            }
+        }
+    }
+
+    /**
+     * Sets the resolution and every pixel to the ones in frameBuffer. Like setPixel(), updateScreen() must be called for this to take
+     * effect.
+     */
+    virtual void copyFrameBufferFrom(const FrameBuffer &frameBuffer) {
+        setHighResolution(frameBuffer.isHighResolution);
+        for (int y = 0; y < frameBuffer.getHeight(); y++) {
+            for (int x = 0; x < frameBuffer.getWidth(); x++) {
+                setPixel(x, y, frameBuffer.getPixel(x, y));
+            }
+        }
+    }
+
+    /**
+     * Displays that can't be drawn to from the emulation thread only hand frames over in updateScreen(), and actually show them when
+     * this is called from the thread that created the display (ex: the UI thread).
+     * @return true if a frame that hadn't been shown yet was shown
+     */
+    virtual bool presentFrame() { return false; }
+
+    /**
+     * Shows lines of text over the frames that presentFrame() shows (ex: the emulator's metrics), until it is called again. No lines hides
+     * the text. Like presentFrame(), only called from the thread that created the display. Displays that can't show text ignore it.
+     */
+    virtual void setOverlayText(const std::vector<std::string> &lines) { (void)lines; }
 };
 }
 
@@ -0,0 +1,72 @@
+#include "CycleInputController.h"
+
+namespace Chip8 {
+CycleInputController::CycleInputController(IInputController &hostInputController) : hostInputController(hostInputController) {}
+
+bool CycleInputController::isKeyPressed(unsigned int keyNumber) {
+    if (keyNumber >= NUM_KEYS) {
+        return false;
+    }
+    return (pressedKeys >> keyNumber) & 1;
+}
+
+uint16_t CycleInputController::getPressedKeys() { return pressedKeys; }
+
+void CycleInputController::checkForKeyPresses() { hostInputController.checkForKeyPresses(); }
+
+bool CycleInputController::isExitButtonPressed() { return hostInputController.isExitButtonPressed(); }
+
+uint8_t CycleInputController::waitForKeyPress() {
+    for (uint8_t keyNumber = 0; keyNumber < NUM_KEYS; keyNumber++) {
+        if (isKeyPressed(keyNumber)) {
+            return keyNumber;
+        }
+    }
+    uint8_t keyNumber = hostInputController.waitForKeyPress();
+    setKeyPressed(keyNumber, true);
+    return keyNumber;
+}
+
+void CycleInputController::scheduleEvent(const CycleKeyEvent &event) {
+    CycleKeyEvent scheduledEvent = event;
+    if (!scheduledEvents.empty() && scheduledEvent.cycleNumber < scheduledEvents.back().cycleNumber) {
+        scheduledEvent.cycleNumber = scheduledEvents.back().cycleNumber;
+    }
+    scheduledEvents.push_back(scheduledEvent);
+}
+
+void CycleInputController::applyEventsUpTo(uint64_t cycleNumber) {
+    currentCycle = cycleNumber;
+    while (!scheduledEvents.empty() && scheduledEvents.front().cycleNumber <= cycleNumber) {
+        applyNextEvent();
+    }
+}
+
+bool CycleInputController::applyNextEvent() {
+    if (scheduledEvents.empty()) {
+        return false;
+    }
+    setKeyPressed(scheduledEvents.front().keyNumber, scheduledEvents.front().isPressed);
+    scheduledEvents.pop_front();
+    return true;
+}
+
+void CycleInputController::setRecording(std::vector<CycleKeyEvent> *recordedEvents) { this->recordedEvents = recordedEvents; }
+
+void CycleInputController::reset() {
+    scheduledEvents.clear();
+    pressedKeys = 0;
+    currentCycle = 0;
+    recordedEvents = nullptr;
+}
+
+void CycleInputController::setKeyPressed(uint8_t keyNumber, bool isPressed) {
+    if (keyNumber >= NUM_KEYS || isKeyPressed(keyNumber) == isPressed) {
+        return;
+    }
+    pressedKeys ^= (uint16_t)(1 << keyNumber);
+    if (recordedEvents != nullptr) {
+        recordedEvents->push_back({currentCycle, keyNumber, isPressed});
+    }
+}
+}
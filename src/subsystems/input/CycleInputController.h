@@ -0,0 +1,83 @@
+#ifndef CHIP_8_CYCLEINPUTCONTROLLER_H
+#define CHIP_8_CYCLEINPUTCONTROLLER_H
+
+#include <deque>
+#include <vector>
+#include "IInputController.h"
+#include "KeyEvent.h"
+
+/**
+ * The input controller the cpu reads while it is being driven by Chip8Emulator. Keys don't change whenever the host controller notices
+ * them. Instead, each change is scheduled for an emulated cycle and applied right before that cycle runs,
+ * so a key press lands at the same instruction every time the same events are scheduled.
+ * Anything the cpu can't get from the scheduled key state (the exit button, and key waits while no key is held) is passed on to the host
+ * controller.
+ * Every change can also be recorded along with the cycle it took effect at. Scheduling the recorded changes again makes the cpu see
+ * exactly the same keys at exactly the same cycles, which is what input movies are made of.
+ */
+namespace Chip8 {
+class CycleInputController : public IInputController {
+   public:
+    static const uint64_t NO_EVENT = (uint64_t)-1;
+
+    CycleInputController(IInputController &hostInputController);
+
+    bool isKeyPressed(unsigned int keyNumber) override;
+
+    uint16_t getPressedKeys() override;
+
+    void checkForKeyPresses() override;
+
+    bool isExitButtonPressed() override;
+
+    /**
+     * @return the lowest key that is held down. If no key is, waits on the host controller instead, and the key it returns is pressed
+     * from the current cycle on
+     */
+    uint8_t waitForKeyPress() override;
+
+    /**
+     * Schedules a key change. Events must be scheduled in order: an event scheduled for an earlier cycle than the one before it takes
+     * effect at that one's cycle instead.
+     */
+    void scheduleEvent(const CycleKeyEvent &event);
+
+    /**
+     * Applies every event scheduled at or before cycleNumber, which becomes the current cycle. This must be called before every cycle
+     * runs, so that events are recorded with the right cycle.
+     */
+    void applyEventsUpTo(uint64_t cycleNumber);
+
+    /**
+     * Applies the next scheduled event early, at the current cycle, if there is one
+     * @return false if no event is scheduled
+     */
+    bool applyNextEvent();
+
+    /**
+     * @return the cycle the next event is scheduled for, or NO_EVENT
+     */
+    uint64_t getNextEventCycle() const { return scheduledEvents.empty() ? NO_EVENT : scheduledEvents.front().cycleNumber; }
+
+    /**
+     * Starts appending every change to the pressed keys to recordedEvents, or stops recording if recordedEvents is null
+     */
+    void setRecording(std::vector<CycleKeyEvent> *recordedEvents);
+
+    /**
+     * Releases every key, drops every scheduled event, stops recording and goes back to cycle 0
+     */
+    void reset();
+
+   private:
+    IInputController &hostInputController;
+    std::deque<CycleKeyEvent> scheduledEvents;
+    uint16_t pressedKeys = 0;
+    uint64_t currentCycle = 0;
+    std::vector<CycleKeyEvent> *recordedEvents = nullptr;
+
+    void setKeyPressed(uint8_t keyNumber, bool isPressed);
+};
+}
+
+#endif  // CHIP_8_CYCLEINPUTCONTROLLER_H
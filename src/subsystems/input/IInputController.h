@@ -9,6 +9,11 @@
  * In addition, this interface can be mocked out in testing where applicable in order to test any classes that use it as a dependency.
  */
 namespace Chip8 {
+/**
+ * Emulator functions (rather than chip-8 keys) that a frontend can bind to keys
+ */
+enum class Hotkey : uint8_t { TOGGLE_RUN_AHEAD, TOGGLE_INSTRUCTION_TRACE, TOGGLE_METRICS_OVERLAY, TOGGLE_TURBO };
+
 class IInputController {
    public:
     static const int NUM_KEYS = 16;
@@ -20,8 +25,29 @@ class IInputController {
      */
     virtual bool isKeyPressed(unsigned int keyNumber) = 0;
 
+    /**
+     * @return a bitmask of every key that is pressed, where bit N is set if key N is pressed
+     */
+    virtual uint16_t getPressedKeys() {
+        uint16_t pressedKeys = 0;
+        for (unsigned int keyNumber = 0; keyNumber < NUM_KEYS; keyNumber++) {
+            if (isKeyPressed(keyNumber)) {
+                pressedKeys |= 1 << keyNumber;
+            }
+        }
+        return pressedKeys;
+    }
+
     virtual bool isExitButtonPressed() = 0;
 
+    /**
+     * @return true if the hotkey was pressed since the last time this was called for it. Controllers without hotkeys never report any
+     */
+    virtual bool wasHotkeyPressed(Hotkey hotkey) {
+        (void)hotkey;
+        return false;
+    }
+
     virtual void checkForKeyPresses() = 0;
 
     /**
@@ -1,6 +1,9 @@
 #include "InputController.h"
 #include <SDL.h>
 #include <SDL_events.h>
+#include <sstream>
+#include <string>
+#include "../../exceptions/IOException.h"
 #include "../../exceptions/InitializationException.h"
 
 namespace Chip8 {
@@ -8,9 +11,11 @@ bool InputController::isKeyPressed(unsigned int keyNumber) {
     if (keyNumber >= NUM_KEYS) {
         return false;
     }
-    return keyPressedStates[keyNumber];
+    return (pressedKeys.load(std::memory_order_relaxed) >> keyNumber) & 1;
 }
 
+uint16_t InputController::getPressedKeys() { return pressedKeys.load(std::memory_order_relaxed); }
+
 void InputController::checkForKeyPresses() {
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
@@ -19,6 +24,12 @@ void InputController::checkForKeyPresses() {
 }
 
 uint8_t InputController::waitForKeyPress() {
+    uint16_t currentPressedKeys = pressedKeys.load(std::memory_order_relaxed);
+    for (uint8_t keyNumber = 0; keyNumber < NUM_KEYS; keyNumber++) {
+        if ((currentPressedKeys >> keyNumber) & 1) {
+            return keyNumber;
+        }
+    }
     // note that this error value should never be returned
     // because the function will block until a value other than the error value is returned
     int keyPressed = ERROR_NO_INPUT_HANDLED;
@@ -44,6 +55,9 @@ uint8_t InputController::waitForKeyPress() {
 int InputController::handleInputEvents(const SDL_Event &e) {
     if (e.type == SDL_KEYDOWN) {
         SDL_Keycode pressedKey = e.key.keysym.sym;
+        if (!e.key.repeat) {
+            handleHotkey(pressedKey);
+        }
         return setKeyPressedState(pressedKey, true);
     } else if (e.type == SDL_KEYUP) {
         SDL_Keycode releasedKey = e.key.keysym.sym;
@@ -54,14 +68,74 @@ int InputController::handleInputEvents(const SDL_Event &e) {
     return ERROR_NO_INPUT_HANDLED;
 }
 
+void InputController::handleHotkey(SDL_Keycode pressedKey) {
+    if (pressedKey == SDLK_F2) {
+        pressedHotkeys |= 1 << (int)Hotkey::TOGGLE_RUN_AHEAD;
+    } else if (pressedKey == SDLK_F3) {
+        pressedHotkeys |= 1 << (int)Hotkey::TOGGLE_INSTRUCTION_TRACE;
+    } else if (pressedKey == SDLK_F4) {
+        pressedHotkeys |= 1 << (int)Hotkey::TOGGLE_METRICS_OVERLAY;
+    } else if (pressedKey == SDLK_F5) {
+        pressedHotkeys |= 1 << (int)Hotkey::TOGGLE_TURBO;
+    }
+}
+
+bool InputController::wasHotkeyPressed(Hotkey hotkey) {
+    uint32_t hotkeyBit = 1 << (int)hotkey;
+    bool wasPressed = (pressedHotkeys & hotkeyBit) != 0;
+    pressedHotkeys &= ~hotkeyBit;
+    return wasPressed;
+}
+
 int InputController::setKeyPressedState(SDL_Keycode pressedKey, bool state) {
-    for (int i = 0; i < NUM_KEYS; i++) {
-        if (keyboardMappings[i] == pressedKey) {
-            keyPressedStates[i] = state;
-            return i;
+    int keyNumber = keyMap.getKeyNumber(pressedKey);
+    if (keyNumber == KeyMap::NO_KEY) {
+        return ERROR_NO_INPUT_HANDLED;
+    }
+    uint16_t keyBit = (uint16_t)(1 << keyNumber);
+    if (state) {
+        pressedKeys.fetch_or(keyBit, std::memory_order_relaxed);
+    } else {
+        pressedKeys.fetch_and((uint16_t)~keyBit, std::memory_order_relaxed);
+    }
+    return keyNumber;
+}
+
+void InputController::setKeyMap(const KeyMap &keyMap) {
+    this->keyMap = keyMap;
+    pressedKeys.store(0, std::memory_order_relaxed);
+}
+
+KeyMap InputController::getDefaultKeyMap() {
+    const SDL_Keycode defaultKeycodes[NUM_KEYS] = {SDLK_1, SDLK_2, SDLK_3, SDLK_4, SDLK_q, SDLK_w, SDLK_e, SDLK_r,
+                                                   SDLK_a, SDLK_s, SDLK_d, SDLK_f, SDLK_z, SDLK_x, SDLK_c, SDLK_v};
+    KeyMap keyMap;
+    for (unsigned int keyNumber = 0; keyNumber < NUM_KEYS; keyNumber++) {
+        keyMap.setMapping(defaultKeycodes[keyNumber], keyNumber);
+    }
+    return keyMap;
+}
+
+KeyMap InputController::parseKeyMap(std::istream &keyMapFile) {
+    KeyMap keyMap;
+    std::string line;
+    while (std::getline(keyMapFile, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream lineStream(line);
+        unsigned int keyNumber;
+        std::string keyName;
+        if (!(lineStream >> std::hex >> keyNumber) || !std::getline(lineStream >> std::ws, keyName) || keyNumber >= NUM_KEYS) {
+            throw IOException("Invalid key map line: " + line);
         }
+        SDL_Keycode keycode = SDL_GetKeyFromName(keyName.c_str());
+        if (keycode == SDLK_UNKNOWN) {
+            throw IOException("Unknown key name in key map: " + keyName);
+        }
+        keyMap.setMapping(keycode, keyNumber);
     }
-    return ERROR_NO_INPUT_HANDLED;
+    return keyMap;
 }
 
 bool InputController::isExitButtonPressed() { return isExitPressed; }
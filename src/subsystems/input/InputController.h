@@ -2,11 +2,16 @@
 #define CHIP_8_INPUTCONTROLLER_H
 
 #include <SDL.h>
+#include <atomic>
+#include <istream>
 #include "IInputController.h"
+#include "KeyMap.h"
 
 /**
  * An implementation of IInputController using SDL. This is a fairly simple implementation
- * that doesn't do too much beyond mapping chip-8 input to a few keyboard keys.
+ * that doesn't do too much beyond mapping chip-8 input to keyboard keys.
+ * Events are polled on the UI thread, which writes the state of all 16 keys into a single atomic bitmask. The emulation thread reads it,
+ * so checking a key is a single load, and never races with the UI thread.
  */
 namespace Chip8 {
 class InputController : public IInputController {
@@ -20,24 +25,49 @@ class InputController : public IInputController {
      */
     bool isKeyPressed(unsigned int keyNumber) override;
 
+    uint16_t getPressedKeys() override;
+
     void checkForKeyPresses() override;
 
     bool isExitButtonPressed() override;
 
     /**
-     * Blocks until the next keydown event occurs, and handles the next keydown event
+     * Hotkeys are F keys: F2 toggles run-ahead, F3 toggles instruction tracing, F4 toggles the metrics overlay, F5 toggles turbo
+     */
+    bool wasHotkeyPressed(Hotkey hotkey) override;
+
+    /**
+     * Returns the lowest key that is held down. If none are, blocks until the next keydown event occurs, and handles the next keydown event
      * @return the number of the key that was pressed
      */
     uint8_t waitForKeyPress() override;
 
+    /**
+     * Replaces the key map, and releases every key. Must be called from the thread that polls for key presses.
+     */
+    void setKeyMap(const KeyMap &keyMap);
+
+    /**
+     * @return the default key map, which maps the 4x4 chip-8 keypad onto the 4x4 block of keys from 1 to V on a QWERTY keyboard
+     */
+    static KeyMap getDefaultKeyMap();
+
+    /**
+     * Reads a key map with one mapping per line, in the form "<key number in hex> <SDL key name>" (ex: "a Space").
+     * Empty lines and lines starting with '#' are ignored.
+     */
+    static KeyMap parseKeyMap(std::istream &keyMapFile);
+
    private:
     static const int ERROR_NO_INPUT_HANDLED = -1;
 
-    SDL_Keycode keyboardMappings[NUM_KEYS] = {SDLK_1, SDLK_2, SDLK_3, SDLK_4, SDLK_q, SDLK_w, SDLK_e, SDLK_r,
-                                              SDLK_a, SDLK_s, SDLK_d, SDLK_f, SDLK_z, SDLK_x, SDLK_c, SDLK_v};
-    // initialize all the array values to zero
-    bool keyPressedStates[NUM_KEYS] = {};
-    bool isExitPressed = false;
+    KeyMap keyMap = getDefaultKeyMap();
+    std::atomic<uint16_t> pressedKeys{0};
+    std::atomic<bool> isExitPressed{false};
+    // a bit per Hotkey, only used by the thread that polls for key presses
+    uint32_t pressedHotkeys = 0;
+
+    void handleHotkey(SDL_Keycode pressedKey);
 
     /**
      * @return the chip-8 key number mapped to the keyboard key if the specified pressedKey is mapped to a chip-8 key
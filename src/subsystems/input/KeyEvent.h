@@ -0,0 +1,28 @@
+#ifndef CHIP_8_KEYEVENT_H
+#define CHIP_8_KEYEVENT_H
+
+#include <cstdint>
+
+namespace Chip8 {
+/**
+ * A key press or release, stamped with the host's steady clock (in nanoseconds) when the thread polling for input saw it
+ */
+class TimedKeyEvent {
+   public:
+    uint64_t hostTimeNanos;
+    uint8_t keyNumber;
+    bool isPressed;
+};
+
+/**
+ * A key press or release that takes effect right before the emulated cycle with the given number runs
+ */
+class CycleKeyEvent {
+   public:
+    uint64_t cycleNumber;
+    uint8_t keyNumber;
+    bool isPressed;
+};
+}
+
+#endif  // CHIP_8_KEYEVENT_H
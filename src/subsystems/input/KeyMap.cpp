@@ -0,0 +1,23 @@
+#include "KeyMap.h"
+#include <algorithm>
+#include <string>
+#include "../../exceptions/IndexOutOfBoundsException.h"
+
+namespace Chip8 {
+KeyMap::KeyMap() { std::fill(keyNumbers, keyNumbers + NUM_CHARACTER_KEYCODES + NUM_SCANCODES, (int8_t)NO_KEY); }
+
+void KeyMap::setMapping(int32_t keycode, unsigned int keyNumber) {
+    int index = getTableIndex(keycode);
+    if (index == NO_KEY || keyNumber >= IInputController::NUM_KEYS) {
+        throw IndexOutOfBoundsException("Can't map keycode " + std::to_string(keycode) + " to key " + std::to_string(keyNumber));
+    }
+    keyNumbers[index] = (int8_t)keyNumber;
+}
+
+void KeyMap::removeMapping(int32_t keycode) {
+    int index = getTableIndex(keycode);
+    if (index != NO_KEY) {
+        keyNumbers[index] = NO_KEY;
+    }
+}
+}
@@ -0,0 +1,55 @@
+#ifndef CHIP_8_KEYMAP_H
+#define CHIP_8_KEYMAP_H
+
+#include <cstdint>
+#include "IInputController.h"
+
+/**
+ * Maps keyboard keycodes to chip-8 keys with a lookup table, so a key event is mapped in constant time however many keys are mapped.
+ * Keycodes follow SDL's scheme: keys that produce a character use the character's code, and every other key has bit 30 set with its
+ * scancode in the low bits. Both ranges are small, so the table covers all of them directly.
+ */
+namespace Chip8 {
+class KeyMap {
+   public:
+    static const int NO_KEY = -1;
+
+    KeyMap();
+
+    /**
+     * Maps keycode to keyNumber, replacing whatever keycode was mapped to before. A chip-8 key can be mapped to more than one keycode.
+     * @throws IndexOutOfBoundsException if the keycode can't be mapped, or keyNumber isn't a chip-8 key
+     */
+    void setMapping(int32_t keycode, unsigned int keyNumber);
+
+    void removeMapping(int32_t keycode);
+
+    /**
+     * @return the chip-8 key the keycode is mapped to, or NO_KEY
+     */
+    int getKeyNumber(int32_t keycode) const {
+        int index = getTableIndex(keycode);
+        return index == NO_KEY ? NO_KEY : keyNumbers[index];
+    }
+
+   private:
+    static const int32_t SCANCODE_KEYCODE_BIT = 1 << 30;
+    static const int NUM_CHARACTER_KEYCODES = 128;
+    static const int NUM_SCANCODES = 512;
+
+    int8_t keyNumbers[NUM_CHARACTER_KEYCODES + NUM_SCANCODES];
+
+    static int getTableIndex(int32_t keycode) {
+        if (keycode >= 0 && keycode < NUM_CHARACTER_KEYCODES) {
+            return keycode;
+        }
+        int32_t scancode = keycode & ~SCANCODE_KEYCODE_BIT;
+        if ((keycode & SCANCODE_KEYCODE_BIT) && scancode >= 0 && scancode < NUM_SCANCODES) {
+            return NUM_CHARACTER_KEYCODES + scancode;
+        }
+        return NO_KEY;
+    }
+};
+}
+
+#endif  // CHIP_8_KEYMAP_H
@@ -0,0 +1,81 @@
+#include "ScriptedInputController.h"
+#include <sstream>
+#include <string>
+#include "../../exceptions/IOException.h"
+
+namespace Chip8 {
+ScriptedInputController::ScriptedInputController(std::vector<ScriptedKeyEvent> events, unsigned long exitPollNumber)
+    : events(events), exitPollNumber(exitPollNumber) {}
+
+std::vector<ScriptedKeyEvent> ScriptedInputController::parseScript(std::istream &script) {
+    std::vector<ScriptedKeyEvent> events;
+    std::string line;
+    while (std::getline(script, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream lineStream(line);
+        unsigned long pollNumber;
+        unsigned int keyNumber;
+        std::string state;
+        if (!(lineStream >> pollNumber >> std::hex >> keyNumber >> state) || keyNumber >= NUM_KEYS || (state != "down" && state != "up")) {
+            throw IOException("Invalid input script line: " + line);
+        }
+        if (!events.empty() && pollNumber < events.back().pollNumber) {
+            throw IOException("Input script events must be in order: " + line);
+        }
+        events.push_back({pollNumber, (uint8_t)keyNumber, state == "down"});
+    }
+    return events;
+}
+
+bool ScriptedInputController::isKeyPressed(unsigned int keyNumber) {
+    if (keyNumber >= NUM_KEYS) {
+        return false;
+    }
+    return keyPressedStates[keyNumber];
+}
+
+bool ScriptedInputController::isExitButtonPressed() { return isExitPressed; }
+
+void ScriptedInputController::checkForKeyPresses() {
+    while (nextEventIndex < events.size() && events[nextEventIndex].pollNumber <= pollNumber) {
+        applyEvent(events[nextEventIndex]);
+        nextEventIndex++;
+    }
+    if (pollNumber >= exitPollNumber) {
+        isExitPressed = true;
+    }
+    pollNumber++;
+}
+
+uint8_t ScriptedInputController::waitForKeyPress() {
+    for (uint8_t keyNumber = 0; keyNumber < NUM_KEYS; keyNumber++) {
+        if (keyPressedStates[keyNumber]) {
+            return keyNumber;
+        }
+    }
+    while (nextEventIndex < events.size()) {
+        const ScriptedKeyEvent &event = events[nextEventIndex];
+        nextEventIndex++;
+        applyEvent(event);
+        if (event.isPressed) {
+            return event.keyNumber;
+        }
+    }
+    isExitPressed = true;
+    return 0;
+}
+
+void ScriptedInputController::applyEvent(const ScriptedKeyEvent &event) { keyPressedStates[event.keyNumber] = event.isPressed; }
+
+void ScriptedInputController::setKeyPressed(unsigned int keyNumber, bool isPressed) {
+    if (keyNumber < NUM_KEYS) {
+        keyPressedStates[keyNumber] = isPressed;
+    }
+}
+
+void ScriptedInputController::pressExitButton() { isExitPressed = true; }
+
+unsigned long ScriptedInputController::getPollNumber() const { return pollNumber; }
+}
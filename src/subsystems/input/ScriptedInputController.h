@@ -0,0 +1,72 @@
+#ifndef CHIP_8_SCRIPTEDINPUTCONTROLLER_H
+#define CHIP_8_SCRIPTEDINPUTCONTROLLER_H
+
+#include <cstdint>
+#include <istream>
+#include <vector>
+#include "IInputController.h"
+
+/**
+ * An IInputController implementation that replays a script of key presses and releases instead of reading a keyboard.
+ * Time in a script is measured in polls: the number of times checkForKeyPresses() has been called, which the emulator does once per
+ * iteration of its loop. Keys can also be pressed and released directly, for programs that drive the emulator themselves.
+ */
+namespace Chip8 {
+class ScriptedKeyEvent {
+   public:
+    unsigned long pollNumber;
+    uint8_t keyNumber;
+    bool isPressed;
+};
+
+class ScriptedInputController : public IInputController {
+   public:
+    static const unsigned long NEVER_EXIT = (unsigned long)-1;
+
+    /**
+     * @param events must be sorted by poll number
+     * @param exitPollNumber the poll at which the exit button is pressed
+     */
+    ScriptedInputController(std::vector<ScriptedKeyEvent> events = {}, unsigned long exitPollNumber = NEVER_EXIT);
+
+    /**
+     * Reads a script with one event per line, in the form "<poll number> <key number in hex> <down|up>".
+     * Empty lines and lines starting with '#' are ignored.
+     */
+    static std::vector<ScriptedKeyEvent> parseScript(std::istream &script);
+
+    bool isKeyPressed(unsigned int keyNumber) override;
+
+    bool isExitButtonPressed() override;
+
+    /**
+     * Applies every scripted event up to and including the current poll, then moves on to the next poll
+     */
+    void checkForKeyPresses() override;
+
+    /**
+     * There is nobody to wait for, so if a key is already held down (ex: set with setKeyPressed()), the lowest one is returned.
+     * Otherwise this immediately applies the script up to its next key press and returns the key that was pressed.
+     * If the script has no more key presses, the exit button is pressed instead and 0 is returned.
+     */
+    uint8_t waitForKeyPress() override;
+
+    void setKeyPressed(unsigned int keyNumber, bool isPressed);
+
+    void pressExitButton();
+
+    unsigned long getPollNumber() const;
+
+   private:
+    std::vector<ScriptedKeyEvent> events;
+    size_t nextEventIndex = 0;
+    unsigned long pollNumber = 0;
+    unsigned long exitPollNumber;
+    bool isExitPressed = false;
+    bool keyPressedStates[NUM_KEYS] = {};
+
+    void applyEvent(const ScriptedKeyEvent &event);
+};
+}
+
+#endif  // CHIP_8_SCRIPTEDINPUTCONTROLLER_H
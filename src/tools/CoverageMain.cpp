@@ -0,0 +1,92 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "../Chip8.h"
+#include "../analysis/AnalysisCache.h"
+#include "../analysis/Disassembler.h"
+#include "../constants/Constants.h"
+#include "../exceptions/IOException.h"
+#include "../io/RomFile.h"
+#include "../subsystems/HeadlessSubsystemManager.h"
+#include "../utils/OptionUtil.h"
+
+using namespace Chip8;
+
+static_assert(Cpu::CoveragePolicy::IS_ENABLED, "chip_8_coverage must be built with CHIP8_COVERAGE defined (see chip8_core_coverage)");
+
+/**
+ * Runs a ROM without a window for a number of frames, optionally with scripted input, then prints its disassembly with every instruction
+ * marked by whether it was executed. This shows how much of a game an input script exercises, and which parts it never reaches.
+ */
+
+// Expecting the program name as arg 1, the ROM file name as arg 2, the number of frames to run as arg 3,
+// and optionally an input script (see ScriptedInputController::parseScript(), with one poll per frame) as arg 4
+const int MIN_NUM_ARGS = 3;
+const int MAX_NUM_ARGS = 4;
+const int ROM_FILE_PATH_INDEX = 1;
+const int NUM_FRAMES_INDEX = 2;
+const int INPUT_SCRIPT_PATH_INDEX = 3;
+
+void printSummary(const RomAnalysis &analysis, const CoverageMap &coverage) {
+    unsigned int numInstructions = 0;
+    unsigned int numExecutedInstructions = 0;
+    for (const auto &basicBlock : analysis.getControlFlowGraph().getBasicBlocks()) {
+        for (const Instruction &instruction : basicBlock.second.getInstructions()) {
+            numInstructions++;
+            numExecutedInstructions += coverage.isAddressCovered(instruction.getAddress()) ? 1 : 0;
+        }
+    }
+    double percentage = numInstructions == 0 ? 0 : 100.0 * numExecutedInstructions / numInstructions;
+    std::cout << "Executed " << numExecutedInstructions << " of " << numInstructions << " reachable instructions (" << std::fixed
+              << std::setprecision(1) << percentage << "%), " << coverage.getNumCoveredAddresses() << " addresses in total, along "
+              << coverage.getNumCoveredEdges() << " distinct edges\n";
+}
+
+int main(int argc, char **argv) {
+    uint64_t numFrames = 0;
+    if (argc < MIN_NUM_ARGS || argc > MAX_NUM_ARGS || !OptionUtil::parseNumber(argv[NUM_FRAMES_INDEX], 0, UINT64_MAX, numFrames)) {
+        std::cout << "Incorrect usage. Expected: chip_8_coverage <rom_file> <num_frames> [input_script_file]" << std::endl;
+        return 1;
+    }
+    try {
+        std::vector<ScriptedKeyEvent> events;
+        if (argc == MAX_NUM_ARGS) {
+            std::ifstream script(argv[INPUT_SCRIPT_PATH_INDEX]);
+            if (!script.is_open()) {
+                throw IOException("Unable to open input script");
+            }
+            events = ScriptedInputController::parseScript(script);
+        }
+        HeadlessSubsystemManager headlessSubsystemManager{ScriptedInputController(events)};
+        ScriptedInputController &inputController = headlessSubsystemManager.getScriptedInputController();
+        Chip8Emulator chip8{headlessSubsystemManager};
+        chip8.loadGameFile(argv[ROM_FILE_PATH_INDEX]);
+        for (uint64_t frameNumber = 0; frameNumber < numFrames; frameNumber++) {
+            inputController.checkForKeyPresses();
+            // a key wait with no key held idles until the script presses one, instead of skipping ahead to it
+            if (!(chip8.getCpu().isNextInstructionWaitForKeyPress() && inputController.getPressedKeys() == 0)) {
+                RunResult result = chip8.runFrames(1, EmulationEvent::WAITING_FOR_KEY | EmulationEvent::FAULT);
+                if (result.stopReason == StopReason::FAULT) {
+                    std::cerr << "The ROM faulted at frame " << frameNumber << ": " << chip8.getLastFaultMessage() << std::endl;
+                    break;
+                }
+            }
+        }
+
+        RomFile romFile(argv[ROM_FILE_PATH_INDEX]);
+        Memory memory;
+        romFile.loadToMemory(memory);
+        BlockMap blockMap = AnalysisCache::loadOrAnalyze(argv[ROM_FILE_PATH_INDEX], romFile.getHash(), memory);
+        RomAnalysis analysis(memory, Constants::MEMORY_PROGRAM_START_LOCATION, blockMap.getBlockStartAddresses());
+        const CoverageMap &coverage = chip8.getCpu().getCoverage();
+        printSummary(analysis, coverage);
+        Disassembler(memory, analysis)
+            .writeListing(std::cout, Constants::MEMORY_PROGRAM_START_LOCATION,
+                          Constants::MEMORY_PROGRAM_START_LOCATION + romFile.getData().size(), &coverage);
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what();
+        return 1;
+    }
+    return 0;
+}
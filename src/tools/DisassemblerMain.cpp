@@ -0,0 +1,46 @@
+#include <fstream>
+#include <iostream>
+#include "../analysis/AnalysisCache.h"
+#include "../analysis/Disassembler.h"
+#include "../constants/Constants.h"
+#include "../exceptions/BaseException.h"
+#include "../io/RomFile.h"
+
+using namespace Chip8;
+
+/**
+ * An offline tool that prints an annotated disassembly of a ROM, and saves the ROM's block map to a sidecar file next to the ROM so that
+ * runtime engines don't have to analyze the ROM again.
+ */
+
+// Expecting the program name as arg 1, and the ROM file name to disassemble as arg 2
+const int EXPECTED_NUM_ARGS = 2;
+const int ROM_FILE_PATH_INDEX = 1;
+int main(int argc, char **argv) {
+    if (argc != EXPECTED_NUM_ARGS) {
+        std::cout << "Incorrect usage. Expected: chip_8_disasm <rom_file>" << std::endl;
+        return 1;
+    }
+    try {
+        RomFile romFile(argv[ROM_FILE_PATH_INDEX]);
+        Memory memory;
+        romFile.loadToMemory(memory);
+        RomAnalysis analysis(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+
+        Disassembler disassembler(memory, analysis);
+        disassembler.writeSummary(std::cout);
+        disassembler.writeListing(std::cout, Constants::MEMORY_PROGRAM_START_LOCATION,
+                                  Constants::MEMORY_PROGRAM_START_LOCATION + romFile.getData().size());
+
+        std::string sidecarPath = AnalysisCache::getSidecarPath(argv[ROM_FILE_PATH_INDEX]);
+        std::ofstream sidecarFile(sidecarPath, std::ios::binary);
+        if (sidecarFile.is_open()) {
+            BlockMap(analysis).save(sidecarFile, romFile.getHash());
+            std::cerr << "Saved block map to " << sidecarPath << std::endl;
+        }
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <string>
+#include "../Chip8.h"
+#include "../env/EnvironmentServer.h"
+#include "../subsystems/HeadlessSubsystemManager.h"
+#include "../utils/OptionUtil.h"
+
+using namespace Chip8;
+
+/**
+ * Serves a ROM to an agent in another process through a shared memory segment (see EnvironmentServer), until the agent stops it.
+ */
+
+// Expecting the program name as arg 1, the ROM file name as arg 2, the shared memory segment name as arg 3,
+// and optionally the start (in hex) and length of the reward region as args 4 and 5
+const int MIN_NUM_ARGS = 3;
+const int MAX_NUM_ARGS = 5;
+const int ROM_FILE_PATH_INDEX = 1;
+const int SEGMENT_NAME_INDEX = 2;
+const int REWARD_REGION_START_INDEX = 3;
+const int REWARD_REGION_LENGTH_INDEX = 4;
+
+int main(int argc, char **argv) {
+    uint32_t rewardRegionStart = 0;
+    uint32_t rewardRegionLength = 0;
+    bool areArgsValid = argc == MIN_NUM_ARGS || argc == MAX_NUM_ARGS;
+    if (areArgsValid && argc == MAX_NUM_ARGS) {
+        // the server checks that the whole region is in memory
+        uint32_t maxAddress = Memory::NUM_BYTES_OF_MEMORY - 1;
+        areArgsValid = OptionUtil::parseNumber(argv[REWARD_REGION_START_INDEX], 0, maxAddress, rewardRegionStart, 16) &&
+                       OptionUtil::parseNumber(argv[REWARD_REGION_LENGTH_INDEX], 0, maxAddress + 1, rewardRegionLength);
+    }
+    if (!areArgsValid) {
+        std::cout << "Incorrect usage. Expected: chip_8_env <rom_file> <segment_name> [reward_region_start_hex reward_region_length]"
+                  << std::endl;
+        return 1;
+    }
+    try {
+        HeadlessSubsystemManager headlessSubsystemManager;
+        Chip8Emulator chip8{headlessSubsystemManager};
+        chip8.loadGameFile(argv[ROM_FILE_PATH_INDEX]);
+        EnvironmentServer server(chip8, headlessSubsystemManager, argv[SEGMENT_NAME_INDEX], (uint16_t)rewardRegionStart,
+                                 (uint16_t)rewardRegionLength);
+        std::cout << "Serving " << argv[ROM_FILE_PATH_INDEX] << " at " << argv[SEGMENT_NAME_INDEX] << std::endl;
+        server.serve();
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <climits>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "../Chip8.h"
+#include "../exceptions/IOException.h"
+#include "../subsystems/HeadlessSubsystemManager.h"
+#include "../utils/OptionUtil.h"
+
+using namespace Chip8;
+
+/**
+ * Runs the emulator without a window for a fixed number of loop iterations, optionally with scripted input, then prints the final screen.
+ * This only depends on chip8_core, so it can run on machines without SDL or a display.
+ */
+
+// Expecting the program name as arg 1, the ROM file name as arg 2, the number of iterations to run as arg 3,
+// and optionally an input script (see ScriptedInputController::parseScript()) as arg 4
+const int MIN_NUM_ARGS = 3;
+const int MAX_NUM_ARGS = 4;
+const int ROM_FILE_PATH_INDEX = 1;
+const int NUM_ITERATIONS_INDEX = 2;
+const int INPUT_SCRIPT_PATH_INDEX = 3;
+
+void printScreen(const FrameBuffer &frameBuffer) {
+    for (int y = 0; y < frameBuffer.getHeight(); y++) {
+        for (int x = 0; x < frameBuffer.getWidth(); x++) {
+            std::cout << (frameBuffer.getPixel(x, y) ? '#' : '.');
+        }
+        std::cout << "\n";
+    }
+}
+
+int main(int argc, char **argv) {
+    uint64_t numIterations = 0;
+    if (argc < MIN_NUM_ARGS || argc > MAX_NUM_ARGS || !OptionUtil::parseNumber(argv[NUM_ITERATIONS_INDEX], 0, ULONG_MAX, numIterations)) {
+        std::cout << "Incorrect usage. Expected: chip_8_headless <rom_file> <num_iterations> [input_script_file]" << std::endl;
+        return 1;
+    }
+    try {
+        std::vector<ScriptedKeyEvent> events;
+        if (argc == MAX_NUM_ARGS) {
+            std::ifstream script(argv[INPUT_SCRIPT_PATH_INDEX]);
+            if (!script.is_open()) {
+                throw IOException("Unable to open input script");
+            }
+            events = ScriptedInputController::parseScript(script);
+        }
+        HeadlessSubsystemManager headlessSubsystemManager(ScriptedInputController(events, (unsigned long)numIterations));
+        ScriptedInputController &inputController = headlessSubsystemManager.getScriptedInputController();
+        Chip8Emulator chip8{headlessSubsystemManager};
+        chip8.loadGameFile(argv[ROM_FILE_PATH_INDEX]);
+        // run one cycle per poll on this thread, as fast as possible, so the script lines up with the same cycles on every run
+        do {
+            inputController.checkForKeyPresses();
+            chip8.runCycles(1);
+        } while (!inputController.isExitButtonPressed());
+        printScreen(headlessSubsystemManager.getHeadlessDisplay().getFrameBuffer());
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "../exceptions/IOException.h"
+#include "../fuzz/InputFuzzer.h"
+#include "../io/RomFile.h"
+#include "../utils/OptionUtil.h"
+
+using namespace Chip8;
+
+/**
+ * Fuzzes the key presses a ROM is played with to find inputs that make it fault, like a stack overflow or a jump off the end of memory.
+ * Every fault found is written to <output_dir>/crashes as an input script, which chip_8_headless and chip_8_coverage can play back
+ * (with one poll per frame), and every input that reached new code is written to <output_dir>/corpus.
+ */
+
+// Expecting the program name as arg 1, the ROM file name as arg 2, the output directory as arg 3,
+// and optionally any number of input scripts to seed the corpus with.
+// Options (ex: --seconds=60, --frames=600, --jobs=8, --replay=crash.txt) can be given anywhere, and don't count towards the number of args
+const int MIN_NUM_ARGS = 3;
+const int ROM_FILE_PATH_INDEX = 1;
+const int OUTPUT_DIRECTORY_INDEX = 2;
+const int FIRST_SEED_SCRIPT_INDEX = 3;
+const std::string SECONDS_OPTION = "--seconds=";
+const std::string FRAMES_OPTION = "--frames=";
+const std::string JOBS_OPTION = "--jobs=";
+const std::string REPLAY_OPTION = "--replay=";
+const double DEFAULT_NUM_SECONDS = 60;
+const uint32_t MAX_NUM_JOBS = 1024;
+
+void makeDirectory(const std::string &path) {
+    if (mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw IOException("Could not create directory " + path);
+    }
+}
+
+std::vector<KeyPress> readInput(const std::string &path, uint32_t numFrames) {
+    std::ifstream script(path);
+    if (!script.is_open()) {
+        throw IOException("Unable to open input script " + path);
+    }
+    return InputFuzzer::parseInput(script, numFrames);
+}
+
+void printFault(const FuzzerFault &fault) {
+    std::cout << InputFuzzer::getFaultKindName(fault.kind) << " at frame " << fault.frameNumber << ", program counter 0x" << std::hex
+              << fault.programCounter << std::dec << ": " << fault.message << std::endl;
+}
+
+int main(int argc, char **argv) {
+    std::vector<std::string> args;
+    double numSeconds = DEFAULT_NUM_SECONDS;
+    uint32_t numFrames = InputFuzzer::DEFAULT_NUM_FRAMES;
+    uint32_t numJobs = std::max(1u, std::thread::hardware_concurrency());
+    std::string replayScriptPath;
+    bool areOptionsValid = true;
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, SECONDS_OPTION.size(), SECONDS_OPTION) == 0) {
+            areOptionsValid &= OptionUtil::parseNumber(arg.substr(SECONDS_OPTION.size()), 0, HUGE_VAL, numSeconds) && numSeconds > 0;
+        } else if (arg.compare(0, FRAMES_OPTION.size(), FRAMES_OPTION) == 0) {
+            areOptionsValid &= OptionUtil::parseNumber(arg.substr(FRAMES_OPTION.size()), 1, UINT32_MAX, numFrames);
+        } else if (arg.compare(0, JOBS_OPTION.size(), JOBS_OPTION) == 0) {
+            areOptionsValid &= OptionUtil::parseNumber(arg.substr(JOBS_OPTION.size()), 1, MAX_NUM_JOBS, numJobs);
+        } else if (arg.compare(0, REPLAY_OPTION.size(), REPLAY_OPTION) == 0) {
+            replayScriptPath = arg.substr(REPLAY_OPTION.size());
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (!areOptionsValid || args.size() < MIN_NUM_ARGS) {
+        std::cout << "Incorrect usage. Expected: chip_8_fuzz <rom_file> <output_dir> [seed_input_scripts...]"
+                  << " Options: " << SECONDS_OPTION << "<seconds> " << FRAMES_OPTION << "<frames> " << JOBS_OPTION << "<threads> "
+                  << REPLAY_OPTION << "<input_script>" << std::endl;
+        return 1;
+    }
+    try {
+        RomFile romFile(args[ROM_FILE_PATH_INDEX]);
+        InputFuzzer fuzzer(romFile.getData(), numFrames);
+        if (!replayScriptPath.empty()) {
+            FuzzerFault fault;
+            if (!fuzzer.replay(readInput(replayScriptPath, numFrames), fault)) {
+                std::cout << "The input played for " << numFrames << " frames without a fault" << std::endl;
+                return 0;
+            }
+            printFault(fault);
+            return 1;
+        }
+
+        const std::string &outputDirectory = args[OUTPUT_DIRECTORY_INDEX];
+        makeDirectory(outputDirectory);
+        makeDirectory(outputDirectory + "/crashes");
+        makeDirectory(outputDirectory + "/corpus");
+        for (size_t i = FIRST_SEED_SCRIPT_INDEX; i < args.size(); i++) {
+            fuzzer.addSeedInput(readInput(args[i], numFrames));
+        }
+        fuzzer.fuzz(numJobs, numSeconds);
+
+        std::cout << "Ran " << fuzzer.getNumExecutions() << " inputs on " << numJobs << " threads over " << numSeconds << " seconds ("
+                  << (uint64_t)(fuzzer.getNumExecutions() / numSeconds) << " per second). The corpus has " << fuzzer.getCorpusSize()
+                  << " inputs, which executed " << fuzzer.getNumCoveredAddresses() << " addresses" << std::endl;
+        std::cout << "Found " << fuzzer.getFaults().size() << " distinct faults" << std::endl;
+        for (const FuzzerFault &fault : fuzzer.getFaults()) {
+            printFault(fault);
+            std::ostringstream crashFilePath;
+            crashFilePath << outputDirectory << "/crashes/" << InputFuzzer::getFaultKindName(fault.kind) << "_0x" << std::hex
+                          << fault.programCounter << ".txt";
+            std::ofstream crashFile(crashFilePath.str());
+            crashFile << "# " << InputFuzzer::getFaultKindName(fault.kind) << " at frame " << fault.frameNumber << ": " << fault.message
+                      << "\n# Random seed " << InputFuzzer::RANDOM_SEED << ", replay with: chip_8_fuzz " << args[ROM_FILE_PATH_INDEX]
+                      << " " << outputDirectory << " " << FRAMES_OPTION << numFrames << " " << REPLAY_OPTION << crashFilePath.str() << "\n";
+            InputFuzzer::writeInput(crashFile, fault.input);
+        }
+        size_t inputNumber = 0;
+        for (const std::vector<KeyPress> &input : fuzzer.getCorpusInputs()) {
+            std::ofstream inputFile(outputDirectory + "/corpus/input_" + std::to_string(inputNumber++) + ".txt");
+            InputFuzzer::writeInput(inputFile, input);
+        }
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what();
+        return 1;
+    }
+    return 0;
+}
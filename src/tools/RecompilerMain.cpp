@@ -0,0 +1,53 @@
+#include <fstream>
+#include <iostream>
+#include "../analysis/AnalysisCache.h"
+#include "../analysis/ControlFlowGraph.h"
+#include "../constants/Constants.h"
+#include "../exceptions/IOException.h"
+#include "../io/RomFile.h"
+#include "../recompiler/CppCodeGenerator.h"
+
+using namespace Chip8;
+
+/**
+ * An offline tool that translates a ROM into C++ (one function per basic block), and optionally compiles the C++ into a shared library
+ * that the emulator can load with its recompiled library argument.
+ */
+
+// Expecting the program name as arg 1, the ROM file name as arg 2, the C++ file to write as arg 3, and optionally the library to build as arg 4
+const int MIN_NUM_ARGS = 3;
+const int MAX_NUM_ARGS = 4;
+const int ROM_FILE_PATH_INDEX = 1;
+const int SOURCE_FILE_PATH_INDEX = 2;
+const int LIBRARY_FILE_PATH_INDEX = 3;
+
+int main(int argc, char **argv) {
+    if (argc < MIN_NUM_ARGS || argc > MAX_NUM_ARGS) {
+        std::cout << "Incorrect usage. Expected: chip_8_recompile <rom_file> <output_cpp_file> [output_library_file]" << std::endl;
+        return 1;
+    }
+    try {
+        RomFile romFile(argv[ROM_FILE_PATH_INDEX]);
+        Memory memory;
+        romFile.loadToMemory(memory);
+        // the blocks are found from the ROM's cached block map when it has one, instead of following every path of execution again
+        BlockMap blockMap = AnalysisCache::loadOrAnalyze(argv[ROM_FILE_PATH_INDEX], romFile.getHash(), memory);
+        ControlFlowGraph controlFlowGraph(memory, blockMap.getBlockStartAddresses());
+
+        std::ofstream sourceFile(argv[SOURCE_FILE_PATH_INDEX]);
+        if (!sourceFile.is_open()) {
+            throw IOException("Unable to open output file");
+        }
+        CppCodeGenerator(controlFlowGraph).generate(sourceFile, argv[ROM_FILE_PATH_INDEX]);
+        sourceFile.close();
+        std::cout << "Recompiled " << controlFlowGraph.getBasicBlocks().size() << " basic blocks" << std::endl;
+
+        if (argc == MAX_NUM_ARGS) {
+            CppCodeGenerator::compileLibrary(argv[SOURCE_FILE_PATH_INDEX], argv[LIBRARY_FILE_PATH_INDEX]);
+        }
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Chip8.h"
+#include "../exceptions/IOException.h"
+#include "../subsystems/HeadlessSubsystemManager.h"
+
+using namespace Chip8;
+
+/**
+ * Replays an input movie recorded by the emulator (see --record) without a window, as fast as possible, and checks that the replay ends
+ * in exactly the state the recording did. This turns a recorded session into a quick, repeatable reproduction.
+ */
+
+// Expecting the program name as arg 1, the ROM file name as arg 2, and the movie file name as arg 3.
+// The option --trace=<file> can be given anywhere, to save the last instructions of the replay (see chip_8_trace), and --video=<file> to
+// record its frames (see FrameRecorder for the formats)
+const int NUM_ARGS = 3;
+const int ROM_FILE_PATH_INDEX = 1;
+const int MOVIE_FILE_PATH_INDEX = 2;
+const uint32_t NUM_CYCLES_PER_RUN = 1 << 20;
+const std::string TRACE_OPTION = "--trace=";
+const std::string VIDEO_OPTION = "--video=";
+
+int main(int argc, char **argv) {
+    std::vector<std::string> args;
+    std::string traceFilePath;
+    std::string videoFilePath;
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, TRACE_OPTION.size(), TRACE_OPTION) == 0) {
+            traceFilePath = arg.substr(TRACE_OPTION.size());
+        } else if (arg.compare(0, VIDEO_OPTION.size(), VIDEO_OPTION) == 0) {
+            videoFilePath = arg.substr(VIDEO_OPTION.size());
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (args.size() != NUM_ARGS) {
+        std::cout << "Incorrect usage. Expected: chip_8_replay <rom_file> <movie_file> [" << TRACE_OPTION << "<file>] [" << VIDEO_OPTION
+                  << "<file>]" << std::endl;
+        return 1;
+    }
+    try {
+        std::ifstream movieFile(args[MOVIE_FILE_PATH_INDEX], std::ios::binary);
+        if (!movieFile.is_open()) {
+            throw IOException("Unable to open the movie");
+        }
+        InputMovie movie = InputMovie::load(movieFile);
+
+        HeadlessSubsystemManager headlessSubsystemManager;
+        Chip8Emulator chip8{headlessSubsystemManager};
+        chip8.loadGameFile(args[ROM_FILE_PATH_INDEX]);
+        chip8.startReplay(movie);
+        chip8.setInstructionTracing(!traceFilePath.empty());
+        std::unique_ptr<FrameRecorder> frameRecorder;
+        if (!videoFilePath.empty()) {
+            frameRecorder.reset(new FrameRecorder(videoFilePath, FrameRecorder::getFormatForPath(videoFilePath),
+                                                  Chip8Emulator::DEFAULT_CYCLES_PER_SECOND, Chip8Emulator::CYCLES_PER_FRAME));
+            chip8.setFrameRecorder(frameRecorder.get());
+        }
+        auto startTime = std::chrono::steady_clock::now();
+        uint64_t numCyclesRemaining = movie.numCycles;
+        // a replay runs far faster than frames can be encoded, so while recording it runs half a queue of frames at a time, and waits for
+        // the video to catch up in between rather than have frames dropped
+        uint32_t numCyclesPerRun =
+            frameRecorder == nullptr ? NUM_CYCLES_PER_RUN : FrameRecorder::QUEUE_CAPACITY / 2 * Chip8Emulator::CYCLES_PER_FRAME;
+        while (numCyclesRemaining > 0) {
+            while (frameRecorder != nullptr && frameRecorder->getNumFramesQueued() > FrameRecorder::QUEUE_CAPACITY / 2) {
+                std::this_thread::yield();
+            }
+            uint32_t numCycles = numCyclesRemaining < numCyclesPerRun ? (uint32_t)numCyclesRemaining : numCyclesPerRun;
+            chip8.runCycles(numCycles);
+            numCyclesRemaining -= numCycles;
+        }
+        double numSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+        if (!traceFilePath.empty()) {
+            std::ofstream traceFile(traceFilePath, std::ios::binary);
+            chip8.getInstructionTrace().save(traceFile);
+        }
+        if (frameRecorder != nullptr) {
+            frameRecorder->finish();
+            std::cout << "Recorded " << frameRecorder->getNumFramesWritten() << " frames, dropping "
+                      << frameRecorder->getNumFramesDropped() << " the video couldn't keep up with" << std::endl;
+        }
+
+        std::cout << "Replayed " << movie.events.size() << " key events over " << movie.numCycles << " cycles in " << numSeconds
+                  << " seconds" << std::endl;
+        if (chip8.saveState().getHash() != movie.finalStateHash) {
+            std::cout << "The replay diverged from the recording" << std::endl;
+            return 1;
+        }
+        std::cout << "The replay ended in the recorded state" << std::endl;
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../exceptions/BaseException.h"
+#include "../io/RomLibrary.h"
+#include "../utils/OptionUtil.h"
+
+using namespace Chip8;
+
+/**
+ * Builds and queries ROM library indexes (see RomLibrary). A collection is indexed once, after which batch jobs can look its ROMs up by
+ * content hash, or list the ones that are too large to load, without opening a single ROM.
+ */
+
+// Expecting the program name as arg 1, a command as arg 2, and the index file name as arg 3. The build command takes the ROM file names
+// after that, and the find command the hash of the ROM to find, in hex
+const int MIN_NUM_ARGS = 3;
+const int COMMAND_INDEX = 1;
+const int INDEX_FILE_PATH_INDEX = 2;
+const int FIRST_ROM_FILE_PATH_INDEX = 3;
+const int HASH_INDEX = 3;
+const int NUM_FIND_ARGS = 4;
+
+void printRom(const RomLibraryEntry &entry) {
+    std::cout << std::hex << std::setw(16) << std::setfill('0') << entry.hash << std::dec << std::setfill(' ') << " " << std::setw(6)
+              << entry.size << (entry.isLoadable() ? "  " : " !") << " " << entry.title << "  " << entry.path << "\n";
+}
+
+int main(int argc, char **argv) {
+    std::string command = argc >= MIN_NUM_ARGS ? argv[COMMAND_INDEX] : "";
+    uint64_t hash = 0;
+    bool isValidUsage = command == "build" || command == "list" ||
+                        (command == "find" && argc == NUM_FIND_ARGS && OptionUtil::parseNumber(argv[HASH_INDEX], 0, UINT64_MAX, hash, 16));
+    if (!isValidUsage) {
+        std::cout << "Incorrect usage. Expected: chip_8_library build <index_file> <rom_file>...\n"
+                  << "                           chip_8_library list <index_file>\n"
+                  << "                           chip_8_library find <index_file> <rom_hash>" << std::endl;
+        return 1;
+    }
+    try {
+        if (command == "build") {
+            std::vector<std::string> romPaths(argv + FIRST_ROM_FILE_PATH_INDEX, argv + argc);
+            RomLibrary::build(romPaths, argv[INDEX_FILE_PATH_INDEX]);
+            std::cerr << "Indexed " << RomLibrary(argv[INDEX_FILE_PATH_INDEX]).getNumRoms() << " distinct ROMs" << std::endl;
+        } else if (command == "list") {
+            // ROMs marked with ! are empty or too large to load
+            RomLibrary library(argv[INDEX_FILE_PATH_INDEX]);
+            for (uint32_t index = 0; index < library.getNumRoms(); index++) {
+                printRom(library.getRom(index));
+            }
+        } else {
+            RomLibrary library(argv[INDEX_FILE_PATH_INDEX]);
+            RomLibraryEntry entry;
+            if (!library.findRom(hash, entry)) {
+                std::cerr << "No ROM with that hash is in the library" << std::endl;
+                return 1;
+            }
+            printRom(entry);
+        }
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what();
+        return 1;
+    }
+    return 0;
+}
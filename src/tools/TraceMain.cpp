@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../analysis/Disassembler.h"
+#include "../cpu/InstructionTrace.h"
+#include "../exceptions/IOException.h"
+
+using namespace Chip8;
+
+/**
+ * Decodes an instruction trace saved by the emulator (see --trace) into one line per instruction, or diffs two traces and shows where
+ * they first differ. Tracing the same movie through two builds (or an interpreter and another engine) and diffing the traces points
+ * straight at the instruction where they desync.
+ */
+
+// Expecting the program name as arg 1, the trace file name as arg 2, and optionally a second trace file to diff against as arg 3
+const int MIN_NUM_ARGS = 2;
+const int MAX_NUM_ARGS = 3;
+const int TRACE_FILE_PATH_INDEX = 1;
+const int OTHER_TRACE_FILE_PATH_INDEX = 2;
+// the number of instructions shown before the first difference
+const size_t NUM_CONTEXT_RECORDS = 8;
+
+std::vector<TraceRecord> loadTrace(const std::string &path) {
+    std::ifstream traceFile(path, std::ios::binary);
+    if (!traceFile.is_open()) {
+        throw IOException("Unable to open trace " + path);
+    }
+    return InstructionTrace::load(traceFile);
+}
+
+std::string formatRecord(const TraceRecord &record) {
+    std::ostringstream line;
+    line << std::setw(10) << record.cycleNumber << std::hex << std::uppercase << std::setfill('0') << "  0x" << std::setw(3)
+         << record.programCounter << "  " << std::setw(4) << record.opcode << "  " << std::setfill(' ') << std::left << std::setw(18)
+         << Disassembler::getMnemonic(Instruction::decode(record.programCounter, record.opcode)) << std::right << std::setfill('0')
+         << "I=0x" << std::setw(3) << record.indexRegister;
+    uint8_t registerNumber = record.getChangedRegisterNumber();
+    if (registerNumber != TraceRecord::NO_REGISTER_CHANGED) {
+        line << "  V" << (int)registerNumber << "=0x" << std::setw(2) << (int)record.changedRegisterValue;
+        if (record.changedRegisters != (1 << registerNumber)) {
+            const char *separator = " (and ";
+            for (int otherRegister = registerNumber + 1; otherRegister < TraceRecord::NUM_REGISTERS; otherRegister++) {
+                if (record.changedRegisters & (1 << otherRegister)) {
+                    line << separator << "V" << otherRegister;
+                    separator = ", ";
+                }
+            }
+            line << ")";
+        }
+    }
+    return line.str();
+}
+
+/**
+ * @return the number of the first record of trace at or after cycleNumber
+ */
+size_t findCycle(const std::vector<TraceRecord> &trace, uint64_t cycleNumber) {
+    return std::lower_bound(trace.begin(), trace.end(), cycleNumber,
+                            [](const TraceRecord &record, uint64_t cycle) { return record.cycleNumber < cycle; }) -
+           trace.begin();
+}
+
+int diffTraces(const std::vector<TraceRecord> &trace, const std::vector<TraceRecord> &otherTrace) {
+    if (trace.empty() || otherTrace.empty()) {
+        std::cout << "A trace is empty, so there is nothing to compare" << std::endl;
+        return 0;
+    }
+    // the traces are rings, so they may have kept different stretches of the run. Only the cycles both kept are compared
+    uint64_t firstCycle = std::max(trace.front().cycleNumber, otherTrace.front().cycleNumber);
+    size_t index = findCycle(trace, firstCycle);
+    size_t otherIndex = findCycle(otherTrace, firstCycle);
+    size_t numCompared = 0;
+    while (index + numCompared < trace.size() && otherIndex + numCompared < otherTrace.size()) {
+        if (trace[index + numCompared] != otherTrace[otherIndex + numCompared]) {
+            size_t numContextRecords = std::min(numCompared, NUM_CONTEXT_RECORDS);
+            std::cout << "The traces agree on " << numCompared << " instructions from cycle " << firstCycle << ", then differ:\n";
+            for (size_t i = numCompared - numContextRecords; i < numCompared; i++) {
+                std::cout << "  " << formatRecord(trace[index + i]) << "\n";
+            }
+            std::cout << "< " << formatRecord(trace[index + numCompared]) << "\n";
+            std::cout << "> " << formatRecord(otherTrace[otherIndex + numCompared]) << std::endl;
+            return 1;
+        }
+        numCompared++;
+    }
+    std::cout << "The traces agree on all " << numCompared << " instructions they both have, from cycle " << firstCycle << std::endl;
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc < MIN_NUM_ARGS || argc > MAX_NUM_ARGS) {
+        std::cout << "Incorrect usage. Expected: chip_8_trace <trace_file> [other_trace_file]" << std::endl;
+        return 1;
+    }
+    try {
+        std::vector<TraceRecord> trace = loadTrace(argv[TRACE_FILE_PATH_INDEX]);
+        if (argc == MAX_NUM_ARGS) {
+            return diffTraces(trace, loadTrace(argv[OTHER_TRACE_FILE_PATH_INDEX]));
+        }
+        for (const TraceRecord &record : trace) {
+            std::cout << formatRecord(record) << "\n";
+        }
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what();
+        return 1;
+    }
+    return 0;
+}
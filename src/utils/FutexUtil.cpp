@@ -0,0 +1,34 @@
+#include "FutexUtil.h"
+#include <climits>
+#include <thread>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Chip8 {
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futexes require atomics with the same layout as a uint32_t");
+
+void FutexUtil::waitWhileEqual(std::atomic<uint32_t> &value, uint32_t expectedValue) {
+    for (unsigned int i = 0; i < NUM_SPINS_BEFORE_SLEEPING; i++) {
+        if (value.load(std::memory_order_acquire) != expectedValue) {
+            return;
+        }
+    }
+#ifdef __linux__
+    // not FUTEX_WAIT_PRIVATE, since the value may be in memory shared with another process
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&value), FUTEX_WAIT, expectedValue, nullptr, nullptr, 0);
+#else
+    std::this_thread::yield();
+#endif
+}
+
+void FutexUtil::wakeAll(std::atomic<uint32_t> &value) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&value), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)value;
+#endif
+}
+}
@@ -0,0 +1,31 @@
+#ifndef CHIP_8_FUTEXUTIL_H
+#define CHIP_8_FUTEXUTIL_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A utility for sleeping until a 32-bit atomic changes, without a mutex or condition variable.
+ * On Linux this uses futexes, which also work for atomics in memory shared between processes. Elsewhere, waiting falls back to yielding.
+ */
+namespace Chip8 {
+class FutexUtil {
+   public:
+    /**
+     * Returns once value is no longer equal to expectedValue. It spins for a short while first, since the value is usually changed by
+     * another thread or process that is already running, and only sleeps in the kernel if that doesn't happen quickly.
+     * Like any futex wait, it may also return early (ex: if interrupted by a signal), so callers must check the value again.
+     */
+    static void waitWhileEqual(std::atomic<uint32_t> &value, uint32_t expectedValue);
+
+    /**
+     * Wakes every thread that is sleeping in waitWhileEqual() on value. It must be called after value is changed.
+     */
+    static void wakeAll(std::atomic<uint32_t> &value);
+
+   private:
+    static const unsigned int NUM_SPINS_BEFORE_SLEEPING = 4000;
+};
+}
+
+#endif  // CHIP_8_FUTEXUTIL_H
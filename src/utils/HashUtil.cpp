@@ -0,0 +1,33 @@
+#include "HashUtil.h"
+
+namespace Chip8 {
+uint64_t HashUtil::fnv1a(const uint8_t *data, size_t length, uint64_t hash) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= FNV1A_PRIME;
+    }
+    return hash;
+}
+
+uint32_t HashUtil::crc32(const uint8_t *data, size_t length) {
+    // a bit at a time rather than with a table, since it is only used on small amounts of data
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+uint32_t HashUtil::adler32(const uint8_t *data, size_t length) {
+    uint32_t low = 1;
+    uint32_t high = 0;
+    for (size_t i = 0; i < length; i++) {
+        low = (low + data[i]) % ADLER32_MODULUS;
+        high = (high + low) % ADLER32_MODULUS;
+    }
+    return high << 16 | low;
+}
+}
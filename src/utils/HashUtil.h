@@ -0,0 +1,38 @@
+#ifndef CHIP_8_HASHUTIL_H
+#define CHIP_8_HASHUTIL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A utility for computing fast, non-cryptographic hashes of data (ex: to identify a ROM by its contents)
+ */
+namespace Chip8 {
+class HashUtil {
+   public:
+    static const uint64_t FNV1A_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+
+    /**
+     * @return the 64-bit FNV-1a hash of the data. A previously computed hash can be passed in as the initial hash to continue hashing
+     * data that isn't contiguous.
+     */
+    static uint64_t fnv1a(const uint8_t *data, size_t length, uint64_t hash = FNV1A_OFFSET_BASIS);
+
+    /**
+     * @return the CRC-32 of the data, as used by PNG and zip files
+     */
+    static uint32_t crc32(const uint8_t *data, size_t length);
+
+    /**
+     * @return the Adler-32 checksum of the data, as used by zlib streams
+     */
+    static uint32_t adler32(const uint8_t *data, size_t length);
+
+   private:
+    static const uint64_t FNV1A_PRIME = 0x100000001B3ULL;
+    static const uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+    static const uint32_t ADLER32_MODULUS = 65521;
+};
+}
+
+#endif  // CHIP_8_HASHUTIL_H
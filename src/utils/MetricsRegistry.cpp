@@ -0,0 +1,119 @@
+#include "MetricsRegistry.h"
+#include <cstdio>
+#include <fstream>
+#include "../exceptions/IOException.h"
+
+namespace Chip8 {
+const double NANOS_PER_SECOND = 1e9;
+
+int Histogram::getBucketIndex(uint64_t value) {
+    if (value < (uint64_t)1 << SUB_BUCKET_BITS) {
+        return (int)value;
+    }
+    // larger values keep only their top SUB_BUCKET_BITS bits, and every extra bit they are shifted by adds NUM_SUB_BUCKETS buckets
+    int highestBit = 63 - __builtin_clzll(value);
+    int shift = highestBit - SUB_BUCKET_BITS + 1;
+    return shift * NUM_SUB_BUCKETS + (int)(value >> shift);
+}
+
+uint64_t Histogram::getBucketUpperBound(int bucketIndex) {
+    if (bucketIndex < 1 << SUB_BUCKET_BITS) {
+        return (uint64_t)bucketIndex;
+    }
+    int shift = bucketIndex / NUM_SUB_BUCKETS - 1;
+    uint64_t subBucket = (uint64_t)(bucketIndex % NUM_SUB_BUCKETS + NUM_SUB_BUCKETS);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+uint64_t Histogram::getCount() const { return numValues.load(std::memory_order_relaxed); }
+
+uint64_t Histogram::getSumNanos() const { return sumNanos.load(std::memory_order_relaxed); }
+
+uint64_t Histogram::getValueAtPercentile(double percentile) const {
+    uint64_t numValuesNow = getCount();
+    if (numValuesNow == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(percentile / 100 * numValuesNow + 0.5);
+    rank = rank == 0 ? 1 : rank;
+    uint64_t numValuesSoFar = 0;
+    for (int bucketIndex = 0; bucketIndex < NUM_BUCKETS; bucketIndex++) {
+        numValuesSoFar += counts[bucketIndex].load(std::memory_order_relaxed);
+        if (numValuesSoFar >= rank) {
+            return getBucketUpperBound(bucketIndex);
+        }
+    }
+    // values recorded while this ran may have been counted in numValues but not yet in their bucket
+    return getBucketUpperBound(NUM_BUCKETS - 1);
+}
+
+void Histogram::reset() {
+    for (std::atomic<uint64_t> &count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    numValues.store(0, std::memory_order_relaxed);
+    sumNanos.store(0, std::memory_order_relaxed);
+}
+
+void Histogram::writePrometheus(std::ostream &output, const std::string &name) const {
+    uint64_t cumulativeCount = 0;
+    for (int bucketIndex = 0; bucketIndex < NUM_BUCKETS; bucketIndex++) {
+        uint64_t count = counts[bucketIndex].load(std::memory_order_relaxed);
+        if (count == 0) {
+            continue;
+        }
+        cumulativeCount += count;
+        output << name << "_bucket{le=\"" << getBucketUpperBound(bucketIndex) / NANOS_PER_SECOND << "\"} " << cumulativeCount << "\n";
+    }
+    output << name << "_bucket{le=\"+Inf\"} " << cumulativeCount << "\n";
+    output << name << "_sum " << getSumNanos() / NANOS_PER_SECOND << "\n";
+    output << name << "_count " << cumulativeCount << "\n";
+}
+
+Counter &MetricsRegistry::addCounter(const std::string &name, const std::string &help) {
+    metrics.push_back({name, help, Type::COUNTER, std::unique_ptr<Counter>(new Counter()), nullptr, nullptr});
+    return *metrics.back().counter;
+}
+
+Gauge &MetricsRegistry::addGauge(const std::string &name, const std::string &help) {
+    metrics.push_back({name, help, Type::GAUGE, nullptr, std::unique_ptr<Gauge>(new Gauge()), nullptr});
+    return *metrics.back().gauge;
+}
+
+Histogram &MetricsRegistry::addHistogram(const std::string &name, const std::string &help) {
+    metrics.push_back({name, help, Type::HISTOGRAM, nullptr, nullptr, std::unique_ptr<Histogram>(new Histogram())});
+    return *metrics.back().histogram;
+}
+
+void MetricsRegistry::writePrometheus(std::ostream &output) const {
+    for (const Metric &metric : metrics) {
+        output << "# HELP " << metric.name << " " << metric.help << "\n";
+        switch (metric.type) {
+            case Type::COUNTER:
+                output << "# TYPE " << metric.name << " counter\n" << metric.name << " " << metric.counter->getValue() << "\n";
+                break;
+            case Type::GAUGE:
+                output << "# TYPE " << metric.name << " gauge\n" << metric.name << " " << metric.gauge->getValue() << "\n";
+                break;
+            case Type::HISTOGRAM:
+                output << "# TYPE " << metric.name << " histogram\n";
+                metric.histogram->writePrometheus(output, metric.name);
+                break;
+        }
+    }
+}
+
+void MetricsRegistry::writePrometheusFile(const std::string &path) const {
+    std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath);
+        writePrometheus(file);
+        if (!file) {
+            throw IOException("Could not write metrics to " + temporaryPath);
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        throw IOException("Could not replace " + path + " with the new metrics");
+    }
+}
+}
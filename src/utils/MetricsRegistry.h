@@ -0,0 +1,122 @@
+#ifndef CHIP_8_METRICSREGISTRY_H
+#define CHIP_8_METRICSREGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Counters, gauges and histograms that show whether an emulator is keeping up (ex: instructions per second, how long presenting a frame
+ * takes). Metrics are updated with relaxed atomics, so any thread can update them without locks, and any thread can read them.
+ * A MetricsRegistry owns the metrics of one emulator, and writes them in the Prometheus text exposition format.
+ */
+namespace Chip8 {
+class Counter {
+   public:
+    void increment(uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+
+    uint64_t getValue() const { return value.load(std::memory_order_relaxed); }
+
+   private:
+    std::atomic<uint64_t> value{0};
+};
+
+class Gauge {
+   public:
+    void set(double newValue) { value.store(newValue, std::memory_order_relaxed); }
+
+    double getValue() const { return value.load(std::memory_order_relaxed); }
+
+   private:
+    std::atomic<double> value{0};
+};
+
+/**
+ * A histogram of durations in nanoseconds, with buckets laid out like an HDR histogram: every power of 2 is split into 16 linear buckets,
+ * so any value from a nanosecond to centuries is counted with a relative error under 1/16, in under 8KB of counts.
+ * Durations are exported in seconds.
+ */
+class Histogram {
+   public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int NUM_SUB_BUCKETS = 1 << (SUB_BUCKET_BITS - 1);
+    static const int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * NUM_SUB_BUCKETS + NUM_SUB_BUCKETS;
+
+    void record(uint64_t nanos) {
+        counts[getBucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+        numValues.fetch_add(1, std::memory_order_relaxed);
+        sumNanos.fetch_add(nanos, std::memory_order_relaxed);
+    }
+
+    uint64_t getCount() const;
+
+    uint64_t getSumNanos() const;
+
+    /**
+     * @param percentile from 0 to 100
+     * @return the highest value of the bucket the percentile falls in, or 0 if nothing was recorded
+     */
+    uint64_t getValueAtPercentile(double percentile) const;
+
+    void reset();
+
+    /**
+     * Writes the histogram's cumulative buckets, sum and count. Only the buckets that hold values are written, to keep the output short
+     */
+    void writePrometheus(std::ostream &output, const std::string &name) const;
+
+    static int getBucketIndex(uint64_t value);
+
+    /**
+     * @return the highest value that lands in the bucket
+     */
+    static uint64_t getBucketUpperBound(int bucketIndex);
+
+   private:
+    std::atomic<uint64_t> counts[NUM_BUCKETS] = {};
+    std::atomic<uint64_t> numValues{0};
+    std::atomic<uint64_t> sumNanos{0};
+};
+
+class MetricsRegistry {
+   public:
+    /**
+     * Each of these adds a metric with the name (ex: chip8_cycles_total) and help text given. The metric lives as long as the registry,
+     * so the reference can be kept.
+     */
+    Counter &addCounter(const std::string &name, const std::string &help);
+
+    Gauge &addGauge(const std::string &name, const std::string &help);
+
+    Histogram &addHistogram(const std::string &name, const std::string &help);
+
+    void writePrometheus(std::ostream &output) const;
+
+    /**
+     * Writes the metrics to a temporary file next to path, then renames it over path, so anything reading the file (ex: the Prometheus
+     * node exporter's textfile collector) never sees it half written
+     * @throws IOException if the file can't be written
+     */
+    void writePrometheusFile(const std::string &path) const;
+
+   private:
+    enum class Type : uint8_t { COUNTER, GAUGE, HISTOGRAM };
+
+    class Metric {
+       public:
+        std::string name;
+        std::string help;
+        Type type;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    std::vector<Metric> metrics;
+};
+}
+
+#endif  // CHIP_8_METRICSREGISTRY_H
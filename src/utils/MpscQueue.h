@@ -0,0 +1,87 @@
+#ifndef CHIP_8_MPSCQUEUE_H
+#define CHIP_8_MPSCQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A fixed capacity, lock-free queue that any number of threads can push to, and exactly one thread pops from.
+ * Each slot has a sequence number that says whether it is free for the producer that claimed it, or holds an item for the consumer, so
+ * producers only contend on claiming a write index, and never wait for each other to finish writing.
+ * (This is Dmitry Vyukov's bounded queue, with the consumer side simplified for a single consumer.)
+ */
+namespace Chip8 {
+template <typename T, uint32_t CAPACITY>
+class MpscQueue {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "The capacity of a queue must be a power of two");
+
+   public:
+    MpscQueue() {
+        for (uint32_t i = 0; i < CAPACITY; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /**
+     * Can be called from any thread.
+     * @return false if the queue is full, in which case nothing is written
+     */
+    bool tryPush(const T &item) {
+        uint32_t writeIndex = this->writeIndex.load(std::memory_order_relaxed);
+        while (true) {
+            Slot &slot = slots[writeIndex & (CAPACITY - 1)];
+            int32_t distance = (int32_t)(slot.sequence.load(std::memory_order_acquire) - writeIndex);
+            if (distance == 0) {
+                // the slot is free. Claim it, unless another producer got to it first
+                if (this->writeIndex.compare_exchange_weak(writeIndex, writeIndex + 1, std::memory_order_relaxed)) {
+                    slot.item = item;
+                    slot.sequence.store(writeIndex + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (distance < 0) {
+                // the slot still holds an item from the previous lap, which the consumer hasn't popped yet
+                return false;
+            } else {
+                writeIndex = this->writeIndex.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Consumer only.
+     * @return false if the queue is empty (or the next item is still being written), in which case item is left untouched
+     */
+    bool tryPop(T &item) {
+        Slot &slot = slots[readIndex & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != readIndex + 1) {
+            return false;
+        }
+        item = slot.item;
+        // free the slot for the producer that will write to it on the next lap
+        slot.sequence.store(readIndex + CAPACITY, std::memory_order_release);
+        readIndex++;
+        return true;
+    }
+
+   private:
+    class Slot {
+       public:
+        std::atomic<uint32_t> sequence;
+        T item;
+    };
+
+    static const int CACHE_LINE_SIZE = 64;
+
+    // padding keeps the producers' index off the cache line the consumer writes to (see TripleBuffer for why this isn't alignas)
+    std::atomic<uint32_t> writeIndex{0};
+    uint8_t writeIndexPadding[CACHE_LINE_SIZE];
+    uint32_t readIndex = 0;
+    uint8_t readIndexPadding[CACHE_LINE_SIZE];
+    Slot slots[CAPACITY];
+};
+}
+
+#endif  // CHIP_8_MPSCQUEUE_H
@@ -0,0 +1,50 @@
+#include "OptionUtil.h"
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+namespace Chip8 {
+bool OptionUtil::parseNumber(const std::string &value, uint64_t minValue, uint64_t maxValue, uint64_t &number, int base) {
+    // strtoull() would also accept whitespace, signs, a 0x prefix and trailing characters
+    if (value.empty()) {
+        return false;
+    }
+    for (char character : value) {
+        bool isDigit = base == 16 ? std::isxdigit((unsigned char)character) != 0 : (character >= '0' && character < '0' + base);
+        if (!isDigit) {
+            return false;
+        }
+    }
+    errno = 0;
+    unsigned long long parsedNumber = std::strtoull(value.c_str(), nullptr, base);
+    if (errno == ERANGE || parsedNumber < minValue || parsedNumber > maxValue) {
+        return false;
+    }
+    number = parsedNumber;
+    return true;
+}
+
+bool OptionUtil::parseNumber(const std::string &value, uint32_t minValue, uint32_t maxValue, uint32_t &number, int base) {
+    uint64_t parsedNumber;
+    if (!parseNumber(value, (uint64_t)minValue, (uint64_t)maxValue, parsedNumber, base)) {
+        return false;
+    }
+    number = (uint32_t)parsedNumber;
+    return true;
+}
+
+bool OptionUtil::parseNumber(const std::string &value, double minValue, double maxValue, double &number) {
+    if (value.empty() || std::isspace((unsigned char)value[0])) {
+        return false;
+    }
+    char *end;
+    errno = 0;
+    double parsedNumber = std::strtod(value.c_str(), &end);
+    if (*end != '\0' || errno == ERANGE || !std::isfinite(parsedNumber) || parsedNumber < minValue || parsedNumber > maxValue) {
+        return false;
+    }
+    number = parsedNumber;
+    return true;
+}
+}
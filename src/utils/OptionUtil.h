@@ -0,0 +1,31 @@
+#ifndef CHIP_8_OPTIONUTIL_H
+#define CHIP_8_OPTIONUTIL_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * A utility for parsing the numeric values of command line options (ex: the 8 in --turbo=8).
+ * Unlike std::stoul() and std::stod(), a bad value is reported rather than thrown, and values with whitespace, signs or trailing
+ * characters are bad values rather than being partly read, so tools can print their usage message instead.
+ */
+namespace Chip8 {
+class OptionUtil {
+   public:
+    /**
+     * Parses a whole number written with only the digits of base
+     * @return false if value isn't a whole number from minValue to maxValue, in which case number is left unchanged
+     */
+    static bool parseNumber(const std::string &value, uint64_t minValue, uint64_t maxValue, uint64_t &number, int base = 10);
+
+    static bool parseNumber(const std::string &value, uint32_t minValue, uint32_t maxValue, uint32_t &number, int base = 10);
+
+    /**
+     * Parses a decimal number (ex: 2.5)
+     * @return false if value isn't a finite number from minValue to maxValue, in which case number is left unchanged
+     */
+    static bool parseNumber(const std::string &value, double minValue, double maxValue, double &number);
+};
+}
+
+#endif  // CHIP_8_OPTIONUTIL_H
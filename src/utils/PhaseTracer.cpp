@@ -0,0 +1,111 @@
+#include "PhaseTracer.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace Chip8 {
+std::atomic<bool> PhaseTracer::isTracing{false};
+std::mutex PhaseTracer::threadBuffersMutex;
+std::vector<std::unique_ptr<PhaseTracer::ThreadBuffer>> PhaseTracer::threadBuffers;
+
+// JSON needs quotes and backslashes escaped, and names are only ever written by the emulator's own code
+static void writeJsonString(std::ostream &output, const std::string &value) {
+    output << '"';
+    for (char character : value) {
+        if (character == '"' || character == '\\') {
+            output << '\\';
+        }
+        output << character;
+    }
+    output << '"';
+}
+
+void PhaseTracer::start() { isTracing.store(true, std::memory_order_relaxed); }
+
+void PhaseTracer::stop() { isTracing.store(false, std::memory_order_relaxed); }
+
+PhaseTracer::ThreadBuffer &PhaseTracer::getThreadBuffer() {
+    // a thread only takes the lock the first time it records, to add its buffer
+    thread_local ThreadBuffer *threadBuffer = nullptr;
+    if (threadBuffer == nullptr) {
+        std::lock_guard<std::mutex> lock(threadBuffersMutex);
+        threadBuffers.emplace_back(new ThreadBuffer());
+        threadBuffer = threadBuffers.back().get();
+        threadBuffer->threadNumber = (uint32_t)threadBuffers.size();
+    }
+    return *threadBuffer;
+}
+
+void PhaseTracer::setThreadName(const std::string &name) {
+    ThreadBuffer &threadBuffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(threadBuffersMutex);
+    threadBuffer.threadName = name;
+}
+
+void PhaseTracer::recordPhase(const char *name, uint64_t startNanos, uint64_t endNanos) {
+    ThreadBuffer &threadBuffer = getThreadBuffer();
+    size_t numPhases = threadBuffer.numPhases.load(std::memory_order_relaxed);
+    // allocated on the first phase rather than with the buffer, so threads that are only named don't pay for it
+    if (threadBuffer.phases.empty()) {
+        threadBuffer.phases.resize(EVENTS_PER_THREAD);
+    }
+    if (numPhases == threadBuffer.phases.size()) {
+        threadBuffer.numDroppedPhases.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    threadBuffer.phases[numPhases] = {name, startNanos, endNanos};
+    threadBuffer.numPhases.store(numPhases + 1, std::memory_order_release);
+}
+
+void PhaseTracer::writeChromeTrace(std::ostream &output) {
+    std::lock_guard<std::mutex> lock(threadBuffersMutex);
+    uint64_t firstNanos = UINT64_MAX;
+    for (const auto &threadBuffer : threadBuffers) {
+        size_t numPhases = threadBuffer->numPhases.load(std::memory_order_acquire);
+        for (size_t i = 0; i < numPhases; i++) {
+            firstNanos = std::min(firstNanos, threadBuffer->phases[i].startNanos);
+        }
+    }
+
+    // complete ("X") events, with times in microseconds from the first phase, and a metadata ("M") event naming each thread
+    output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    const char *separator = "\n";
+    output << std::fixed << std::setprecision(3);
+    for (const auto &threadBuffer : threadBuffers) {
+        if (!threadBuffer->threadName.empty()) {
+            output << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadBuffer->threadNumber
+                   << ",\"args\":{\"name\":";
+            writeJsonString(output, threadBuffer->threadName);
+            output << "}}";
+            separator = ",\n";
+        }
+        size_t numPhases = threadBuffer->numPhases.load(std::memory_order_acquire);
+        for (size_t i = 0; i < numPhases; i++) {
+            const Phase &phase = threadBuffer->phases[i];
+            output << separator << "{\"name\":";
+            writeJsonString(output, phase.name);
+            output << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadBuffer->threadNumber
+                   << ",\"ts\":" << (phase.startNanos - firstNanos) / 1000.0 << ",\"dur\":" << (phase.endNanos - phase.startNanos) / 1000.0
+                   << "}";
+            separator = ",\n";
+        }
+    }
+    output << "\n]}\n";
+}
+
+uint64_t PhaseTracer::getNumDroppedPhases() {
+    std::lock_guard<std::mutex> lock(threadBuffersMutex);
+    uint64_t numDroppedPhases = 0;
+    for (const auto &threadBuffer : threadBuffers) {
+        numDroppedPhases += threadBuffer->numDroppedPhases.load(std::memory_order_relaxed);
+    }
+    return numDroppedPhases;
+}
+
+void PhaseTracer::clear() {
+    std::lock_guard<std::mutex> lock(threadBuffersMutex);
+    for (const auto &threadBuffer : threadBuffers) {
+        threadBuffer->numPhases.store(0, std::memory_order_relaxed);
+        threadBuffer->numDroppedPhases.store(0, std::memory_order_relaxed);
+    }
+}
+}
@@ -0,0 +1,116 @@
+#ifndef CHIP_8_PHASETRACER_H
+#define CHIP_8_PHASETRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Records how long each phase of the frame loop takes on each thread (ex: polling input, emulating a batch of cycles, presenting a frame,
+ * sleeping), and writes the timeline as a Chrome trace, which chrome://tracing and https://ui.perfetto.dev can open.
+ * Every thread records into a buffer of its own, so recording never takes a lock or waits on another thread. Buffers have a fixed
+ * capacity, and once a thread's buffer is full its later phases are dropped and counted.
+ * While tracing is stopped, timing a phase costs a single relaxed atomic load.
+ */
+namespace Chip8 {
+class PhaseTracer {
+   public:
+    static const size_t EVENTS_PER_THREAD = 1 << 18;
+
+    static void start();
+
+    static void stop();
+
+    static bool isEnabled() { return isTracing.load(std::memory_order_relaxed); }
+
+    /**
+     * Names the calling thread in the timeline (ex: "emulation")
+     */
+    static void setThreadName(const std::string &name);
+
+    /**
+     * Records a phase of the calling thread.
+     * @param name must be a string literal (or otherwise live until the trace is written), since only the pointer is kept
+     */
+    static void recordPhase(const char *name, uint64_t startNanos, uint64_t endNanos);
+
+    /**
+     * Writes every phase recorded so far as Chrome trace JSON. Phases that threads record while this runs may or may not be included
+     */
+    static void writeChromeTrace(std::ostream &output);
+
+    /**
+     * @return the number of phases that didn't fit in their thread's buffer
+     */
+    static uint64_t getNumDroppedPhases();
+
+    /**
+     * Forgets every phase recorded so far. Must not be called while other threads are recording
+     */
+    static void clear();
+
+    static uint64_t getNowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+   private:
+    class Phase {
+       public:
+        const char *name;
+        uint64_t startNanos;
+        uint64_t endNanos;
+    };
+
+    /**
+     * Written only by the thread it belongs to. numPhases is published after each phase is written, so the phases below it can be read
+     * from any thread
+     */
+    class ThreadBuffer {
+       public:
+        uint32_t threadNumber;
+        std::string threadName;
+        std::vector<Phase> phases;
+        std::atomic<size_t> numPhases{0};
+        std::atomic<uint64_t> numDroppedPhases{0};
+    };
+
+    static std::atomic<bool> isTracing;
+    // every thread's buffer is kept until the process exits, so a trace can still be written after the thread that recorded it is gone
+    static std::mutex threadBuffersMutex;
+    static std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+    static ThreadBuffer &getThreadBuffer();
+};
+
+/**
+ * Records the time from its construction to its destruction as a phase of the calling thread, if tracing was on when it was constructed
+ */
+class ScopedPhase {
+   public:
+    /**
+     * @param name must be a string literal (see PhaseTracer::recordPhase())
+     */
+    explicit ScopedPhase(const char *name) : name(name), startNanos(PhaseTracer::isEnabled() ? PhaseTracer::getNowNanos() : 0) {}
+
+    ~ScopedPhase() {
+        if (startNanos != 0) {
+            PhaseTracer::recordPhase(name, startNanos, PhaseTracer::getNowNanos());
+        }
+    }
+
+    ScopedPhase(const ScopedPhase &) = delete;
+    ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+   private:
+    const char *name;
+    uint64_t startNanos;
+};
+}
+
+#endif  // CHIP_8_PHASETRACER_H
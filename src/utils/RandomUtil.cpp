@@ -1,12 +1,19 @@
 #include "RandomUtil.h"
+#include <chrono>
 
 namespace Chip8 {
-bool RandomUtil::isSeeded = false;
+uint32_t RandomUtil::getTimeSeed() {
+    uint64_t ticks = (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    return (uint32_t)(ticks ^ (ticks >> 32));
+}
+
+uint32_t RandomUtil::getInitialState(uint32_t seed) { return seed == 0 ? ZERO_SEED_REPLACEMENT : seed; }
 
-uint8_t RandomUtil::getRandomNumber() {
-    if (!isSeeded) {
-        srand((unsigned int)time(0));
-    }
-    return (uint8_t)(rand() % Constants::VALUES_IN_BYTE);
+uint8_t RandomUtil::getRandomNumber(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    // the high bits of xorshift are better mixed than the low ones
+    return (uint8_t)(state >> 24);
+}
 }
-}
\ No newline at end of file
@@ -2,21 +2,33 @@
 #define CHIP_8_RANDOMUTIL_H
 
 #include <cstdint>
-#include <cstdlib>
-#include <ctime>
-
-#include "../constants/Constants.h"
 
+/**
+ * A small xorshift random number generator. The generator's whole state is a single integer that the caller owns,
+ * so a seeded cpu produces the same numbers on every machine, and its state can be saved and restored along with the cpu's registers.
+ */
 namespace Chip8 {
 class RandomUtil {
    public:
     /**
+     * @return a seed based on the current time, that differs between runs
+     */
+    static uint32_t getTimeSeed();
+
+    /**
+     * @return the state that a generator seeded with seed starts in
+     */
+    static uint32_t getInitialState(uint32_t seed);
+
+    /**
+     * Advances the generator's state
      * @return a random number between 0 and 255
      */
-    static uint8_t getRandomNumber();
+    static uint8_t getRandomNumber(uint32_t &state);
 
    private:
-    static bool isSeeded;
+    // xorshift never leaves a state of 0, so a seed of 0 is replaced with this
+    static const uint32_t ZERO_SEED_REPLACEMENT = 0x9E3779B9;
 };
 }
 
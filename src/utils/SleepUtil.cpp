@@ -1,7 +1,12 @@
 #include "SleepUtil.h"
 #include <chrono>
 #include <thread>
+#include "PhaseTracer.h"
 
 namespace Chip8 {
-void SleepUtil::sleepMillis(int millis) { std::this_thread::sleep_for(std::chrono::milliseconds(millis)); }
+void SleepUtil::sleepMillis(int millis) {
+    // recorded as a phase so that oversleeping shows up in the timeline
+    ScopedPhase phase("sleep");
+    std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+}
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#ifndef CHIP_8_SPSCRINGBUFFER_H
+#define CHIP_8_SPSCRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * A fixed capacity, lock-free queue for exactly one producer thread and one consumer thread.
+ * It holds no pointers, so it can also be constructed in memory shared between processes.
+ * The read and write indexes count up forever (wrapping at 2^32) and are only reduced to a slot when an item is accessed, which is why
+ * the capacity must be a power of two.
+ */
+namespace Chip8 {
+template <typename T, uint32_t CAPACITY>
+class SpscRingBuffer {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "The capacity of a ring buffer must be a power of two");
+    static_assert(ATOMIC_INT_LOCK_FREE == 2, "Ring buffer indexes must be lock-free to be shared between processes");
+
+   public:
+    /**
+     * Producer only.
+     * @return false if the buffer is full, in which case nothing is written
+     */
+    bool tryPush(const T &item) {
+        uint32_t writeIndex = this->writeIndex.load(std::memory_order_relaxed);
+        if (writeIndex - readIndex.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+        items[writeIndex & (CAPACITY - 1)] = item;
+        this->writeIndex.store(writeIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only.
+     * @return false if the buffer is empty, in which case item is left untouched
+     */
+    bool tryPop(T &item) {
+        uint32_t readIndex = this->readIndex.load(std::memory_order_relaxed);
+        if (readIndex == writeIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[readIndex & (CAPACITY - 1)];
+        this->readIndex.store(readIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Producer only. Pushes as many of the items as there is room for, with a single update of the write index.
+     * @return the number of items that were pushed
+     */
+    uint32_t tryPushMany(const T *items, uint32_t numItems) {
+        uint32_t writeIndex = this->writeIndex.load(std::memory_order_relaxed);
+        uint32_t numFree = CAPACITY - (writeIndex - readIndex.load(std::memory_order_acquire));
+        uint32_t numToPush = numItems < numFree ? numItems : numFree;
+        for (uint32_t i = 0; i < numToPush; i++) {
+            this->items[(writeIndex + i) & (CAPACITY - 1)] = items[i];
+        }
+        this->writeIndex.store(writeIndex + numToPush, std::memory_order_release);
+        return numToPush;
+    }
+
+    /**
+     * Consumer only. Pops as many items as are available, up to numItems, with a single update of the read index.
+     * @return the number of items that were popped
+     */
+    uint32_t tryPopMany(T *items, uint32_t numItems) {
+        uint32_t readIndex = this->readIndex.load(std::memory_order_relaxed);
+        uint32_t numAvailable = writeIndex.load(std::memory_order_acquire) - readIndex;
+        uint32_t numToPop = numItems < numAvailable ? numItems : numAvailable;
+        for (uint32_t i = 0; i < numToPop; i++) {
+            items[i] = this->items[(readIndex + i) & (CAPACITY - 1)];
+        }
+        this->readIndex.store(readIndex + numToPop, std::memory_order_release);
+        return numToPop;
+    }
+
+    /**
+     * Can be called from either side, but is only a snapshot: the other side may change it at any time
+     */
+    uint32_t size() const { return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire); }
+
+    /**
+     * The index the next item will be written at. The consumer can wait for this to change when the buffer is empty (ex: with a futex)
+     */
+    std::atomic<uint32_t> &getWriteIndex() { return writeIndex; }
+
+    /**
+     * The index the next item will be read from. The producer can wait for this to change when the buffer is full
+     */
+    std::atomic<uint32_t> &getReadIndex() { return readIndex; }
+
+    static uint32_t capacity() { return CAPACITY; }
+
+   private:
+    static const int CACHE_LINE_SIZE = 64;
+
+    // the indexes are kept on separate cache lines, so the producer and consumer don't slow each other down by writing to the same line
+    // (see TripleBuffer for why this is done with padding)
+    std::atomic<uint32_t> writeIndex{0};
+    uint8_t writeIndexPadding[CACHE_LINE_SIZE];
+    std::atomic<uint32_t> readIndex{0};
+    uint8_t readIndexPadding[CACHE_LINE_SIZE];
+    T items[CAPACITY];
+};
+}
+
+#endif  // CHIP_8_SPSCRINGBUFFER_H
@@ -0,0 +1,68 @@
+#ifndef CHIP_8_TRIPLEBUFFER_H
+#define CHIP_8_TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Hands the latest value of something (ex: a frame) from one writer thread to one reader thread without locking, and without either
+ * thread ever waiting for the other.
+ * The writer fills its back buffer and publishes it by swapping it with the middle buffer. The reader takes the middle buffer by swapping
+ * it with its front buffer, but only if something new was published since it last did. If the writer publishes several times before the
+ * reader looks, the reader simply gets the newest value: intermediate values are dropped, never torn.
+ */
+namespace Chip8 {
+template <typename T>
+class TripleBuffer {
+   public:
+    /**
+     * Writer only. The buffer to fill before calling publish(). Its contents are whatever was published a couple of swaps ago, so it
+     * must be fully overwritten.
+     */
+    T &getWriteBuffer() { return buffers[writeIndex]; }
+
+    /**
+     * Writer only. Makes the write buffer the newest value, and gives the writer a new buffer to write to
+     */
+    void publish() {
+        uint8_t previousMiddle = middle.exchange(writeIndex | HAS_NEW_VALUE, std::memory_order_acq_rel);
+        writeIndex = previousMiddle & INDEX_MASK;
+    }
+
+    /**
+     * Reader only. Makes the newest published value the read buffer, if there is one the reader hasn't seen.
+     * @return true if the read buffer changed
+     */
+    bool update() {
+        if ((middle.load(std::memory_order_relaxed) & HAS_NEW_VALUE) == 0) {
+            return false;
+        }
+        uint8_t previousMiddle = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previousMiddle & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * Reader only
+     */
+    const T &getReadBuffer() const { return buffers[readIndex]; }
+
+   private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t HAS_NEW_VALUE = 0x4;
+
+    static const int CACHE_LINE_SIZE = 64;
+
+    T buffers[3] = {};
+    uint8_t writeIndex = 0;
+    // padding keeps each thread's index off the cache line the other thread writes to. Padding is used rather than alignas, since C++11
+    // doesn't support over-aligned types on the heap
+    uint8_t writerPadding[CACHE_LINE_SIZE];
+    // the index of the middle buffer, and whether it holds a value the reader hasn't taken yet
+    std::atomic<uint8_t> middle{1};
+    uint8_t middlePadding[CACHE_LINE_SIZE];
+    uint8_t readIndex = 2;
+};
+}
+
+#endif  // CHIP_8_TRIPLEBUFFER_H
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/subsystems/audio/AudioSampleQueue.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for generating the tone and handing it to the audio callback
+ */
+TEST(AudioSampleQueueTest, GeneratesSquareWave) {
+    // a 1000Hz tone at 8000 samples per second has 4 high samples followed by 4 low samples
+    AudioSampleQueue queue(8000, 64, 1000);
+    queue.queueTone(true, 16);
+    queue.queueTone(false, 4);
+    EXPECT_EQ(queue.getNumQueuedSamples(), 20u);
+
+    std::vector<int16_t> samples(20);
+    queue.readSamples(samples.data(), samples.size());
+    for (int i = 0; i < 16; i++) {
+        int16_t expectedSample = (i / 4) % 2 == 0 ? AudioSampleQueue::TONE_AMPLITUDE : -AudioSampleQueue::TONE_AMPLITUDE;
+        EXPECT_EQ(samples[i], expectedSample);
+    }
+    for (int i = 16; i < 20; i++) {
+        EXPECT_EQ(samples[i], 0);
+    }
+    EXPECT_EQ(queue.getNumSamplesPlayed(), 20u);
+    EXPECT_EQ(queue.getNumUnderruns(), 0u);
+}
+
+TEST(AudioSampleQueueTest, CountsUnderrunsAndDrops) {
+    AudioSampleQueue queue(8000, 8);
+    // only 8 samples fit, which bounds the latency to 1ms
+    queue.queueTone(true, 10);
+    EXPECT_EQ(queue.getNumSamplesDropped(), 2u);
+    EXPECT_DOUBLE_EQ(queue.getQueuedLatencyMillis(), 1.0);
+
+    std::vector<int16_t> samples(6, 1);
+    queue.readSamples(samples.data(), samples.size());
+    EXPECT_EQ(queue.getNumUnderruns(), 0u);
+    // running out part way through a read is an underrun, but staying out of samples afterwards isn't counted again
+    queue.readSamples(samples.data(), samples.size());
+    EXPECT_EQ(samples[2], 0);
+    EXPECT_EQ(queue.getNumUnderruns(), 1u);
+    queue.readSamples(samples.data(), samples.size());
+    EXPECT_EQ(queue.getNumUnderruns(), 1u);
+}
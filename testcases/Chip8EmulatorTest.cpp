@@ -0,0 +1,327 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "../src/Chip8.h"
+#include "../src/exceptions/IndexOutOfBoundsException.h"
+#include "../src/exceptions/InstructionUnimplementedException.h"
+#include "../src/subsystems/HeadlessSubsystemManager.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for the batched run API of Chip8Emulator
+ */
+class Chip8EmulatorTest : public ::testing::Test {
+   protected:
+    HeadlessSubsystemManager subsystemManager;
+    Chip8Emulator emulator{subsystemManager};
+
+    void loadProgram(std::initializer_list<uint8_t> program) {
+        std::vector<uint8_t> data(program);
+        emulator.loadGameData(data.data(), data.size());
+    }
+
+    /**
+     * @return false if the condition didn't become true within a couple of seconds
+     */
+    static bool waitFor(std::function<bool()> condition) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+};
+
+TEST_F(Chip8EmulatorTest, RunCyclesStopsAtCycleLimit) {
+    // 0x200: add 1 to V0, jump back to 0x200
+    loadProgram({0x70, 0x01, 0x12, 0x00});
+    RunResult result = emulator.runCycles(10);
+    EXPECT_EQ(result.stopReason, StopReason::CYCLE_LIMIT_REACHED);
+    EXPECT_EQ(result.numCyclesExecuted, 10u);
+    EXPECT_EQ(result.programCounter, 0x200);
+    EXPECT_EQ(emulator.getCpu().getRegisterValue(0), 5);
+
+    result = emulator.runFrames(2);
+    EXPECT_EQ(result.numCyclesExecuted, 2 * Chip8Emulator::CYCLES_PER_FRAME);
+    EXPECT_EQ(emulator.getCpu().getRegisterValue(0), 5 + Chip8Emulator::CYCLES_PER_FRAME);
+}
+
+TEST_F(Chip8EmulatorTest, RunStopsAtFramesAndKeyWaits) {
+    // 0x200: clear the screen, 0x202: set V0, 0x204: wait for a key, 0x206: clear the screen
+    loadProgram({0x00, 0xE0, 0x60, 0x01, 0xF1, 0x0A, 0x00, 0xE0});
+    unsigned int stopEvents = EmulationEvent::FRAME_PRESENTED | EmulationEvent::WAITING_FOR_KEY;
+
+    RunResult result = emulator.runCycles(100, stopEvents);
+    EXPECT_EQ(result.stopReason, StopReason::FRAME_PRESENTED);
+    EXPECT_EQ(result.numCyclesExecuted, 1u);
+
+    result = emulator.runCycles(100, stopEvents);
+    EXPECT_EQ(result.stopReason, StopReason::WAITING_FOR_KEY);
+    EXPECT_EQ(result.programCounter, 0x204);
+
+    // the key wait the run starts at doesn't stop it again
+    result = emulator.runCycles(100, stopEvents);
+    EXPECT_EQ(result.stopReason, StopReason::FRAME_PRESENTED);
+    EXPECT_EQ(result.numCyclesExecuted, 2u);
+    EXPECT_EQ(result.programCounter, 0x208);
+}
+
+TEST_F(Chip8EmulatorTest, RunUntilProgramCounterOrPredicate) {
+    // 0x200: add 1 to V0, 0x202: call 0x206, 0x204: jump to 0x200, 0x206: return
+    loadProgram({0x70, 0x01, 0x22, 0x06, 0x12, 0x00, 0x00, 0xEE});
+
+    RunResult result = emulator.runUntil(EmulationEvent::PROGRAM_COUNTER_REACHED, 0x206, 100);
+    EXPECT_EQ(result.stopReason, StopReason::PROGRAM_COUNTER_REACHED);
+    EXPECT_EQ(result.numCyclesExecuted, 2u);
+
+    result = emulator.runUntil([](const Cpu& cpu) { return cpu.getRegisterValue(0) == 10; }, 1000);
+    EXPECT_EQ(result.stopReason, StopReason::PREDICATE_MATCHED);
+    EXPECT_EQ(emulator.getCpu().getRegisterValue(0), 10);
+    EXPECT_EQ(result.programCounter, 0x202);
+}
+
+TEST_F(Chip8EmulatorTest, RunReportsFaults) {
+    // 0x200: set V0, 0x202: an invalid opcode
+    loadProgram({0x60, 0x01, 0x80, 0x08});
+    RunResult result = emulator.runCycles(10, EmulationEvent::FAULT);
+    EXPECT_EQ(result.stopReason, StopReason::FAULT);
+    EXPECT_EQ(result.numCyclesExecuted, 1u);
+    EXPECT_FALSE(emulator.getLastFaultMessage().empty());
+
+    // faults are thrown out of runs that don't ask to stop at them
+    EXPECT_THROW(emulator.runCycles(10), InstructionUnimplementedException);
+}
+
+TEST_F(Chip8EmulatorTest, TraceRecordsTheInstructionThatFaulted) {
+    // 0x200: set I, 0x202: an invalid opcode
+    loadProgram({0xA1, 0x23, 0x80, 0x08});
+    emulator.setInstructionTracing(true);
+    RunResult result = emulator.runCycles(10, EmulationEvent::FAULT);
+    EXPECT_EQ(result.stopReason, StopReason::FAULT);
+
+    std::vector<TraceRecord> records = emulator.getInstructionTrace().getRecords();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1].programCounter, 0x202);
+    EXPECT_EQ(records[1].opcode, 0x8008);
+    EXPECT_EQ(records[1].indexRegister, 0x123);
+    EXPECT_EQ(records[1].changedRegisters, 0);
+}
+
+TEST_F(Chip8EmulatorTest, EmulationThreadFollowsCommands) {
+    // 0x200: add 1 to V0, jump back to 0x200
+    loadProgram({0x70, 0x01, 0x12, 0x00});
+    emulator.setEmulationSpeed(Chip8Emulator::UNTHROTTLED);
+    emulator.startEmulationThread();
+    EXPECT_TRUE(waitFor([this] { return emulator.getNumCyclesExecuted() > 1000; }));
+
+    emulator.pauseEmulation();
+    EXPECT_TRUE(waitFor([this] { return emulator.getEmulationStatus() == EmulationStatus::PAUSED; }));
+    uint64_t numCyclesWhenPaused = emulator.getNumCyclesExecuted();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(emulator.getNumCyclesExecuted(), numCyclesWhenPaused);
+
+    emulator.stepEmulation(10);
+    EXPECT_TRUE(waitFor([&] { return emulator.getNumCyclesExecuted() == numCyclesWhenPaused + 10; }));
+    emulator.saveStateToSlot(0);
+    EXPECT_TRUE(waitFor([this] { return emulator.getNumStatesSaved() == 1; }));
+    EXPECT_THROW(emulator.saveStateToSlot(Chip8Emulator::NUM_SAVE_STATE_SLOTS), IndexOutOfBoundsException);
+
+    emulator.stopEmulation();
+    emulator.waitForEmulationThread();
+    EXPECT_EQ(emulator.getEmulationStatus(), EmulationStatus::STOPPED);
+    EXPECT_EQ(emulator.getEmulationSpeed(), (uint32_t)Chip8Emulator::UNTHROTTLED);
+}
+
+TEST_F(Chip8EmulatorTest, EmulationThreadStopsWhileWaitingForKey) {
+    // 0x200: wait for a key into V0
+    loadProgram({0xF0, 0x0A});
+    emulator.startEmulationThread();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(emulator.getNumCyclesExecuted(), 0u);
+    emulator.stopEmulation();
+    emulator.waitForEmulationThread();
+}
+
+TEST_F(Chip8EmulatorTest, KeyEventsLandAtExactCycles) {
+    // 0x200: add 1 to V0, 0x202: skip the next instruction if key 0 is pressed, 0x204: jump to 0x200, 0x206: jump to itself
+    loadProgram({0x70, 0x01, 0xE1, 0x9E, 0x12, 0x00, 0x12, 0x06});
+    // cycle 99 adds 1 to V0 for the 34th time, and cycle 100 checks the key after it
+    emulator.scheduleKeyEvent({100, 0, true});
+    emulator.runCycles(99);
+    EXPECT_EQ(emulator.getCpu().getProgramCounter(), 0x200);
+    emulator.runCycles(100);
+    EXPECT_EQ(emulator.getCpu().getRegisterValue(0), 34);
+    EXPECT_EQ(emulator.getCpu().getProgramCounter(), 0x206);
+
+    HeadlessSubsystemManager otherSubsystemManager;
+    Chip8Emulator otherEmulator{otherSubsystemManager};
+    std::vector<uint8_t> program = {0x70, 0x01, 0xE1, 0x9E, 0x12, 0x00, 0x12, 0x06};
+    otherEmulator.loadGameData(program.data(), program.size());
+    otherEmulator.scheduleKeyEvent({101, 0, true});
+    otherEmulator.runCycles(200);
+    EXPECT_EQ(otherEmulator.getCpu().getRegisterValue(0), 35);
+}
+
+TEST_F(Chip8EmulatorTest, HostKeyChangesApplyAtTheStartOfARun) {
+    // 0x200: skip the next instruction if the key in V0 (0) is pressed, 0x202: jump to 0x200, 0x204: jump to itself
+    loadProgram({0xE0, 0x9E, 0x12, 0x00, 0x12, 0x04});
+    emulator.runCycles(10);
+    EXPECT_EQ(emulator.getNumCyclesExecuted(), 10u);
+
+    subsystemManager.getScriptedInputController().setKeyPressed(0, true);
+    emulator.runCycles(1);
+    EXPECT_EQ(emulator.getCpu().getProgramCounter(), 0x204);
+}
+
+TEST_F(Chip8EmulatorTest, EmulationThreadAppliesQueuedKeyEvents) {
+    // 0x200: wait for a key into V0, 0x202: jump to itself
+    loadProgram({0xF0, 0x0A, 0x12, 0x02});
+    emulator.startEmulationThread();
+    EXPECT_TRUE(emulator.queueKeyEvent({0, 5, true}));
+    EXPECT_TRUE(waitFor([this] { return emulator.getNumCyclesExecuted() > 0; }));
+    emulator.stopEmulation();
+    emulator.waitForEmulationThread();
+    EXPECT_EQ(emulator.getCpu().getRegisterValue(0), 5);
+}
+
+TEST_F(Chip8EmulatorTest, RunAheadPresentsFramesWithoutChangingState) {
+    // 0x200: clear the screen, 0x202: point I at the font sprite for V0, 0x204: draw it at V1,V1, 0x206: add 1 to V0, 0x208: jump to 0x200
+    std::vector<uint8_t> program = {0x00, 0xE0, 0xF0, 0x29, 0xD1, 0x15, 0x70, 0x01, 0x12, 0x00};
+    emulator.loadGameData(program.data(), program.size());
+    emulator.setEmulationSpeed(Chip8Emulator::DEFAULT_CYCLES_PER_SECOND * 4);
+    emulator.setRunAheadFrames(3);
+    emulator.setRandomSeed(1);
+    emulator.startEmulationThread();
+    EXPECT_TRUE(waitFor([this] { return emulator.getNumCyclesExecuted() > 100; }));
+    emulator.pauseEmulation();
+    EXPECT_TRUE(waitFor([this] { return emulator.getEmulationStatus() == EmulationStatus::PAUSED; }));
+    emulator.stopEmulation();
+    emulator.waitForEmulationThread();
+    EXPECT_EQ(emulator.getRunAheadFrames(), 3u);
+    EXPECT_THROW(emulator.setRunAheadFrames(Chip8Emulator::MAX_RUN_AHEAD_FRAMES + 1), IndexOutOfBoundsException);
+
+    // running ahead left no trace: the state is the same as if the cycles had been run without it
+    HeadlessSubsystemManager referenceSubsystemManager;
+    Chip8Emulator referenceEmulator{referenceSubsystemManager};
+    referenceEmulator.loadGameData(program.data(), program.size());
+    referenceEmulator.setRandomSeed(1);
+    referenceEmulator.runCycles((uint32_t)emulator.getNumCyclesExecuted());
+    EXPECT_EQ(emulator.saveState().getHash(), referenceEmulator.saveState().getHash());
+    // only frames from run-ahead were presented, so far fewer than one per draw
+    EXPECT_GT(subsystemManager.getHeadlessDisplay().getNumScreenUpdates(), 0u);
+    EXPECT_LT(subsystemManager.getHeadlessDisplay().getNumScreenUpdates(), referenceSubsystemManager.getHeadlessDisplay().getNumScreenUpdates());
+}
+
+TEST_F(Chip8EmulatorTest, TurboRunsFasterAndHandsOverFewerFrames) {
+    // 0x200: clear the screen, 0x202: point I at the font sprite for V0, 0x204: draw it at V1,V1, 0x206: add 1 to V0, 0x208: jump to 0x200
+    loadProgram({0x00, 0xE0, 0xF0, 0x29, 0xD1, 0x15, 0x70, 0x01, 0x12, 0x00});
+    emulator.setTurbo(Chip8Emulator::UNTHROTTLED);
+    emulator.startEmulationThread();
+    EXPECT_TRUE(waitFor([this] { return emulator.getNumCyclesExecuted() > 100000; }));
+    emulator.setTurbo(Chip8Emulator::TURBO_OFF);
+    EXPECT_TRUE(waitFor([this] { return emulator.getTurboMultiplier() == Chip8Emulator::TURBO_OFF; }));
+    emulator.pauseEmulation();
+    EXPECT_TRUE(waitFor([this] { return emulator.getEmulationStatus() == EmulationStatus::PAUSED; }));
+    uint64_t numCycles = emulator.getNumCyclesExecuted();
+    emulator.stopEmulation();
+    emulator.waitForEmulationThread();
+
+    // every draw and clear updates the screen, but turbo handed the screen over at most once per display refresh
+    EXPECT_GT(subsystemManager.getHeadlessDisplay().getNumScreenUpdates(), 0u);
+    EXPECT_LT(subsystemManager.getHeadlessDisplay().getNumScreenUpdates(), numCycles / 100);
+}
+
+TEST_F(Chip8EmulatorTest, EmulationThreadRethrowsFaults) {
+    // 0x200: an invalid opcode
+    loadProgram({0x80, 0x08});
+    emulator.startEmulationThread();
+    EXPECT_THROW(emulator.waitForEmulationThread(), InstructionUnimplementedException);
+}
+
+TEST_F(Chip8EmulatorTest, SaveAndLoadState) {
+    // 0x200: point I at the font sprite for 0, 0x202: draw it at 0,0, 0x204: add 1 to V0, 0x206: jump back to 0x204
+    loadProgram({0xF1, 0x29, 0xD1, 0x15, 0x70, 0x01, 0x12, 0x04});
+    emulator.runCycles(3);
+    EmulatorState state = emulator.saveState();
+    emulator.runCycles(30);
+
+    emulator.loadState(state);
+    EXPECT_EQ(emulator.getCpu().getRegisterValue(0), 1);
+    EXPECT_EQ(emulator.getCpu().getProgramCounter(), 0x206);
+    EXPECT_EQ(subsystemManager.getHeadlessDisplay().getFrameBuffer(), state.frameBuffer);
+    EXPECT_TRUE(state.frameBuffer.getPixel(0, 0));
+}
+
+TEST_F(Chip8EmulatorTest, ResetRestoresThePowerOnState) {
+    // 0x200: point I at the font sprite for 0, 0x202: draw it at 0,0, 0x204: overwrite it with V0, 0x206: call 0x208,
+    // 0x208: add 1 to V0, 0x20A: jump back to 0x208
+    loadProgram({0xF1, 0x29, 0xD1, 0x15, 0xF0, 0x55, 0x22, 0x08, 0x70, 0x01, 0x12, 0x0A});
+    emulator.setRandomSeed(7);
+    EmulatorState powerOnState = emulator.saveState();
+    emulator.runCycles(20);
+    EXPECT_NE(emulator.saveState().getHash(), powerOnState.getHash());
+
+    emulator.reset();
+    emulator.setRandomSeed(7);
+    EXPECT_EQ(emulator.saveState().getHash(), powerOnState.getHash());
+    EXPECT_EQ(emulator.runCycles(20).numCyclesExecuted, 20u);
+}
+
+TEST_F(Chip8EmulatorTest, ResetStartsANewEpisode) {
+    // 0x200: skip the next instruction if the key in V0 (0) isn't pressed, 0x202: add 1 to V1, 0x204: jump back to 0x200
+    loadProgram({0xE0, 0xA1, 0x71, 0x01, 0x12, 0x00});
+    emulator.scheduleKeyEvent({5, 0, true});
+    emulator.scheduleKeyEvent({50, 0, true});
+    emulator.runCycles(20);
+    EXPECT_GT(emulator.getCpu().getRegisterValue(1), 0);
+
+    // the key held before the reset and the key press still scheduled after it are both gone
+    emulator.reset();
+    EXPECT_EQ(emulator.getNumCyclesExecuted(), 0u);
+    InputMovie movie;
+    emulator.startRecording(movie);
+    emulator.runCycles(100);
+    emulator.stopRecording();
+    EXPECT_EQ(emulator.getCpu().getRegisterValue(1), 0);
+    EXPECT_EQ(movie.numCycles, 100u);
+    EXPECT_TRUE(movie.events.empty());
+}
+
+TEST(MpscQueueTest, MultipleProducers) {
+    static const int NUM_PRODUCERS = 4;
+    static const int NUM_ITEMS_PER_PRODUCER = 1000;
+    MpscQueue<int, 64> queue;
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < NUM_PRODUCERS; producer++) {
+        producers.emplace_back([&queue, producer] {
+            for (int i = 0; i < NUM_ITEMS_PER_PRODUCER; i++) {
+                while (!queue.tryPush(producer * NUM_ITEMS_PER_PRODUCER + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // every producer's items must come out in the order that producer pushed them
+    int nextItems[NUM_PRODUCERS];
+    for (int producer = 0; producer < NUM_PRODUCERS; producer++) {
+        nextItems[producer] = producer * NUM_ITEMS_PER_PRODUCER;
+    }
+    for (int numItemsPopped = 0; numItemsPopped < NUM_PRODUCERS * NUM_ITEMS_PER_PRODUCER;) {
+        int item;
+        if (queue.tryPop(item)) {
+            int producer = item / NUM_ITEMS_PER_PRODUCER;
+            EXPECT_EQ(item, nextItems[producer]);
+            nextItems[producer]++;
+            numItemsPopped++;
+        }
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "../src/analysis/ControlFlowGraph.h"
+#include "../src/constants/Constants.h"
+#include "../src/constants/OpcodeBitmasks.h"
+#include "../src/constants/OpcodeBitshifts.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for recovering basic blocks from programs in memory
+ */
+static void clearMemory(Memory& memory) {
+    for (unsigned int address = 0; address < Memory::NUM_BYTES_OF_MEMORY; address++) {
+        memory.setDataAtAddress(address, 0);
+    }
+}
+
+static void loadProgram(Memory& memory, std::vector<uint16_t> opcodes) {
+    clearMemory(memory);
+    uint16_t address = Constants::MEMORY_PROGRAM_START_LOCATION;
+    for (uint16_t opcode : opcodes) {
+        memory.setDataAtAddress(address, (uint8_t)((opcode & OpcodeBitmasks::FIRST_BYTE) >> OpcodeBitshifts::NIBBLE_TWO));
+        memory.setDataAtAddress(address + 1, (uint8_t)(opcode & OpcodeBitmasks::LAST_BYTE));
+        address += Instruction::SIZE_IN_BYTES;
+    }
+}
+
+TEST(ControlFlowGraphTest, JumpTargetSplitsBlock) {
+    Memory memory;
+    // set V0, then increment it forever
+    loadProgram(memory, {0x6001, 0x7001, 0x1202});
+    ControlFlowGraph graph(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+
+    ASSERT_EQ(graph.getBasicBlocks().size(), 2u);
+    const BasicBlock* entryBlock = graph.findBasicBlock(0x200);
+    ASSERT_NE(entryBlock, nullptr);
+    EXPECT_EQ(entryBlock->getInstructions().size(), 1u);
+    EXPECT_EQ(entryBlock->getSuccessors(), std::vector<uint16_t>({0x202}));
+
+    const BasicBlock* loopBlock = graph.findBasicBlock(0x202);
+    ASSERT_NE(loopBlock, nullptr);
+    EXPECT_EQ(loopBlock->getEndAddress(), 0x206);
+    EXPECT_EQ(loopBlock->getSuccessors(), std::vector<uint16_t>({0x202}));
+}
+
+TEST(ControlFlowGraphTest, SkipHasTwoSuccessors) {
+    Memory memory;
+    loadProgram(memory, {0x3000, 0x1200, 0x00EE});
+    ControlFlowGraph graph(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+
+    const BasicBlock* skipBlock = graph.findBasicBlock(0x200);
+    ASSERT_NE(skipBlock, nullptr);
+    EXPECT_EQ(skipBlock->getSuccessors(), std::vector<uint16_t>({0x202, 0x204}));
+    EXPECT_NE(graph.findBasicBlock(0x202), nullptr);
+    ASSERT_NE(graph.findBasicBlock(0x204), nullptr);
+    EXPECT_TRUE(graph.findBasicBlock(0x204)->getSuccessors().empty());
+}
+
+TEST(ControlFlowGraphTest, CallReachesSubroutineAndReturnSite) {
+    Memory memory;
+    loadProgram(memory, {0x2206, 0xB000, 0x0000, 0x00EE});
+    ControlFlowGraph graph(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+
+    EXPECT_EQ(graph.findBasicBlock(0x200)->getSuccessors(), std::vector<uint16_t>({0x206, 0x202}));
+    // the indirect jump can't be followed, so the invalid opcode after it is never reached
+    ASSERT_NE(graph.findBasicBlock(0x202), nullptr);
+    EXPECT_EQ(graph.findBasicBlock(0x202)->getLastInstruction().getControlFlow(), ControlFlow::INDIRECT_JUMP);
+    EXPECT_EQ(graph.findBasicBlock(0x204), nullptr);
+    EXPECT_EQ(graph.findBasicBlock(0x206)->getLastInstruction().getControlFlow(), ControlFlow::RETURN);
+}
+
+TEST(ControlFlowGraphTest, MemoryStoreEndsBlock) {
+    Memory memory;
+    loadProgram(memory, {0xA300, 0xF355, 0x6001, 0x1206});
+    ControlFlowGraph graph(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+
+    const BasicBlock* storeBlock = graph.findBasicBlock(0x200);
+    ASSERT_NE(storeBlock, nullptr);
+    EXPECT_TRUE(storeBlock->getLastInstruction().isMemoryStore());
+    EXPECT_EQ(storeBlock->getSuccessors(), std::vector<uint16_t>({0x204}));
+}
+
+TEST(ControlFlowGraphTest, KeyWaitStartsBlock) {
+    Memory memory;
+    // set V0, wait for a key into V1, then loop back to the start
+    loadProgram(memory, {0x6001, 0xF10A, 0x7001, 0x1200});
+    ControlFlowGraph graph(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+
+    ASSERT_EQ(graph.getBasicBlocks().size(), 2u);
+    EXPECT_EQ(graph.findBasicBlock(0x200)->getInstructions().size(), 1u);
+    const BasicBlock* keyWaitBlock = graph.findBasicBlock(0x202);
+    ASSERT_NE(keyWaitBlock, nullptr);
+    EXPECT_EQ(keyWaitBlock->getInstructions().size(), 3u);
+}
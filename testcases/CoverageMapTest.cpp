@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "../src/analysis/Disassembler.h"
+#include "../src/analysis/RomAnalysis.h"
+#include "../src/constants/Constants.h"
+#include "../src/cpu/CoverageMap.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for recording guest code coverage, and rendering it against the disassembly
+ */
+TEST(CoverageMapTest, RecordsAddressesAndEdges) {
+    CoverageMap coverage;
+    EXPECT_EQ(coverage.getNumCoveredAddresses(), 0u);
+    EXPECT_EQ(coverage.getNumCoveredEdges(), 0u);
+
+    // a loop between two instructions takes the edges 0x200 -> 0x202 and 0x202 -> 0x200 over and over
+    coverage.recordExecution(0x200);
+    for (int i = 0; i < 10; i++) {
+        coverage.recordExecution(0x202);
+        coverage.recordExecution(0x200);
+    }
+    EXPECT_TRUE(coverage.isAddressCovered(0x200));
+    EXPECT_TRUE(coverage.isAddressCovered(0x202));
+    EXPECT_FALSE(coverage.isAddressCovered(0x204));
+    EXPECT_FALSE(coverage.isAddressCovered(CoverageMap::NUM_ADDRESSES));
+    EXPECT_EQ(coverage.getNumCoveredAddresses(), 2u);
+    // the entry into 0x200, plus the two directions of the loop
+    EXPECT_EQ(coverage.getNumCoveredEdges(), 3u);
+
+    coverage.reset();
+    EXPECT_FALSE(coverage.isAddressCovered(0x200));
+    EXPECT_EQ(coverage.getNumCoveredAddresses(), 0u);
+    EXPECT_EQ(coverage.getNumCoveredEdges(), 0u);
+}
+
+TEST(CoverageMapTest, DisassemblyMarksExecutedInstructions) {
+    Memory memory;
+    uint8_t program[Memory::NUM_BYTES_OF_MEMORY] = {};
+    // 0x200: skip the next instruction if V0 == 0, 0x202: clear the screen, 0x204: loop forever
+    const uint8_t instructions[] = {0x30, 0x00, 0x00, 0xE0, 0x12, 0x04};
+    std::copy(instructions, instructions + sizeof(instructions), program + Constants::MEMORY_PROGRAM_START_LOCATION);
+    memory.copyFrom(program);
+    RomAnalysis analysis(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+    CoverageMap coverage;
+    coverage.recordExecution(0x200);
+    coverage.recordExecution(0x204);
+
+    std::ostringstream listing;
+    Disassembler(memory, analysis).writeListing(listing, 0x200, 0x206, &coverage);
+    EXPECT_NE(listing.str().find("  + 0x200  3000  SE V0, 0x00"), std::string::npos);
+    EXPECT_NE(listing.str().find("  - 0x202  00E0  CLS"), std::string::npos);
+    EXPECT_NE(listing.str().find("  + 0x204  1204  JP 0x204"), std::string::npos);
+}
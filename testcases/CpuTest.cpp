@@ -27,6 +27,29 @@ TEST_F(CpuTestFixture, ClearScreen) {
     cpu.emulateCycle();
 }
 
+// 0x00CN, 0x00FB and 0x00FC
+TEST_F(CpuTestFixture, ScrollScreen) {
+    EXPECT_CALL(display, scrollDown(3));
+    EXPECT_CALL(display, scrollRight(4));
+    EXPECT_CALL(display, scrollLeft(4));
+    EXPECT_CALL(display, updateScreen()).Times(3);
+    for (uint16_t scrollOpcode : {0x00C3, 0x00FB, 0x00FC}) {
+        setOpcode(memory, cpu.getProgramCounter(), scrollOpcode);
+        cpu.emulateCycle();
+    }
+}
+
+// 0x00FE and 0x00FF
+TEST_F(CpuTestFixture, SwitchResolution) {
+    EXPECT_CALL(display, setHighResolution(true));
+    EXPECT_CALL(display, setHighResolution(false));
+    EXPECT_CALL(display, updateScreen()).Times(2);
+    setOpcode(memory, Constants::MEMORY_PROGRAM_START_LOCATION, 0x00FF);
+    setOpcode(memory, Constants::MEMORY_PROGRAM_START_LOCATION + 2, 0x00FE);
+    cpu.emulateCycle();
+    cpu.emulateCycle();
+}
+
 // 0x00EE and 0x2NNN
 TEST_F(CpuTestFixture, Subroutine) {
     // test jumping to a subroutine. Address was chosen randomly and is not significant in any way
@@ -390,8 +413,23 @@ TEST_F(CpuTestFixture, jumpToAddressPlusRegisterZero) {
 
 // 0xCXNN
 TEST_F(CpuTestFixture, randomNumber) {
-    // TODO: research a good way to test functions with random numbers
-    EXPECT_EQ(true, true);
+    // random numbers can't be predicted, but the same seed must always give the same numbers, masked by NN
+    uint16_t randomNumberOpcode = 0xC10F;
+    uint8_t randomNumbers[8];
+    cpu.setRandomSeed(1234);
+    CpuState state = cpu.getState();
+    for (uint8_t& randomNumber : randomNumbers) {
+        setOpcode(memory, cpu.getProgramCounter(), randomNumberOpcode);
+        cpu.emulateCycle();
+        randomNumber = cpu.getRegisterValue(1);
+        EXPECT_EQ(randomNumber & 0xF0, 0);
+    }
+
+    cpu.setState(state);
+    for (uint8_t randomNumber : randomNumbers) {
+        cpu.emulateCycle();
+        EXPECT_EQ(cpu.getRegisterValue(1), randomNumber);
+    }
 }
 
 // 0xDXYN
@@ -419,6 +457,26 @@ TEST_F(CpuTestFixture, DrawSprite) {
     EXPECT_EQ(0, cpu.getRegisterValue(Cpu::INDEX_CARRY_REGISTER));
 }
 
+// 0xDXY0
+TEST_F(CpuTestFixture, DrawBigSprite) {
+    // a 16x16 sprite is 2 bytes a row
+    uint16_t spriteLocation = 0x300;
+    int numSpriteBytes = 32;
+    for (int i = 0; i < numSpriteBytes; i++) {
+        memory.setDataAtAddress(spriteLocation + i, 0xFF);
+    }
+    executeOpcode(memory, cpu, (uint16_t)((0xA << OpcodeBitshifts::NIBBLE_THREE) | spriteLocation));
+
+    // every pixel of the sprite is drawn over a pixel that is on, so every one of them is toggled off
+    EXPECT_CALL(display, getPixel(_, _)).WillRepeatedly(Return(true));
+    EXPECT_CALL(display, setPixel(_, _, false)).Times(16 * 16 - 1);
+    // the bottom right pixel of the sprite
+    EXPECT_CALL(display, setPixel(15, 15, false));
+    EXPECT_CALL(display, updateScreen());
+    executeOpcode(memory, cpu, 0xD010);
+    EXPECT_EQ(1, cpu.getRegisterValue(Cpu::INDEX_CARRY_REGISTER));
+}
+
 // 0xEX9E
 TEST_F(CpuTestFixture, skipOnKeyPressed) {
     unsigned int registerNumberX = 0;
@@ -546,6 +604,18 @@ TEST_F(CpuTestFixture, setIndexToSpriteLocation) {
     }
 }
 
+// 0xFX30
+TEST_F(CpuTestFixture, setIndexToBigSpriteLocation) {
+    int registerNumberX = 3;
+    for (uint8_t i = 0; i < 16; i++) {
+        uint16_t setIndexToBigSpriteLocationOpcode =
+            (uint16_t)((0xF << OpcodeBitshifts::NIBBLE_THREE) | (registerNumberX << OpcodeBitshifts::NIBBLE_TWO) | 0x30);
+        setRegister(memory, cpu, registerNumberX, i);
+        executeOpcode(memory, cpu, setIndexToBigSpriteLocationOpcode);
+        EXPECT_EQ(Constants::MEMORY_BIG_FONT_START_LOCATION + i * Constants::BIG_FONT_NUM_BYTES_PER_CHARACTER, cpu.getIndexRegisterValue());
+    }
+}
+
 // 0xFX33
 TEST_F(CpuTestFixture, convertToBcd) {
     int registerNumberX = 0;
@@ -627,4 +697,26 @@ TEST_F(CpuTestFixture, registerLoad) {
     for (unsigned int numRegisters = 1; numRegisters < Cpu::NUM_GENERAL_PURPOSE_REGISTERS; numRegisters++) {
         testRegisterLoad(memory, cpu, numRegisters);
     }
-}
\ No newline at end of file
+}
+
+// 0xFX75 and 0xFX85
+TEST_F(CpuTestFixture, flagRegisters) {
+    for (uint8_t registerNumber = 0; registerNumber < Cpu::NUM_FLAG_REGISTERS; registerNumber++) {
+        setRegister(memory, cpu, registerNumber, (uint8_t)(registerNumber + 10));
+    }
+    executeOpcode(memory, cpu, 0xF775);
+    for (uint8_t registerNumber = 0; registerNumber < Cpu::NUM_FLAG_REGISTERS; registerNumber++) {
+        setRegister(memory, cpu, registerNumber, 0);
+    }
+
+    // only V0 to V3 are loaded back
+    executeOpcode(memory, cpu, 0xF385);
+    for (unsigned int registerNumber = 0; registerNumber < Cpu::NUM_FLAG_REGISTERS; registerNumber++) {
+        EXPECT_EQ(registerNumber <= 3 ? registerNumber + 10 : 0, cpu.getRegisterValue(registerNumber));
+    }
+    EXPECT_EQ(13, cpu.getState().flagRegisters[3]);
+
+    // there are only 8 flag registers
+    EXPECT_THROW(executeOpcode(memory, cpu, 0xF875), IndexOutOfBoundsException);
+    EXPECT_THROW(executeOpcode(memory, cpu, 0xFF85), IndexOutOfBoundsException);
+}
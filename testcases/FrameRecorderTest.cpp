@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../src/Chip8.h"
+#include "../src/io/BinaryStream.h"
+#include "../src/io/FrameRecorder.h"
+#include "../src/subsystems/HeadlessSubsystemManager.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for recording frames into videos on a background thread
+ */
+static std::vector<uint8_t> readFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static std::vector<FrameBuffer> getTestFrames() {
+    std::vector<FrameBuffer> frames(3, FrameBuffer());
+    frames[1].setPixel(0, 0, true);
+    frames[1].setPixel(63, 31, true);
+    frames[2].setHighResolution(true);
+    frames[2].rows[5] = 0xF0F0F0F0F0F0F0F0ULL;
+    frames[2].setPixel(127, 63, true);
+    return frames;
+}
+
+TEST(FrameRecorderTest, RunLengthEncodedVideosLoadBackTheRecordedFrames) {
+    const std::string path = "FrameRecorderTest.c8f";
+    std::vector<FrameBuffer> frames = getTestFrames();
+    {
+        FrameRecorder recorder(path, FrameRecorder::getFormatForPath(path), 125, 2);
+        for (const FrameBuffer &frame : frames) {
+            EXPECT_TRUE(recorder.recordFrame(frame));
+        }
+        recorder.finish();
+        EXPECT_EQ(recorder.getNumFramesWritten(), 3u);
+        EXPECT_EQ(recorder.getNumFramesDropped(), 0u);
+    }
+    std::ifstream file(path, std::ios::binary);
+    EXPECT_EQ(FrameRecorder::load(file), frames);
+    std::remove(path.c_str());
+}
+
+TEST(FrameRecorderTest, WritesY4mAndApngVideos) {
+    const std::string y4mPath = "FrameRecorderTest.y4m";
+    const std::string apngPath = "FrameRecorderTest.png";
+    std::vector<FrameBuffer> frames = getTestFrames();
+    {
+        FrameRecorder y4mRecorder(y4mPath, FrameRecorder::getFormatForPath(y4mPath), 125, 2);
+        FrameRecorder apngRecorder(apngPath, FrameRecorder::getFormatForPath(apngPath), 125, 2);
+        for (const FrameBuffer &frame : frames) {
+            y4mRecorder.recordFrame(frame);
+            apngRecorder.recordFrame(frame);
+        }
+    }
+
+    std::vector<uint8_t> y4m = readFile(y4mPath);
+    std::string y4mHeader = "YUV4MPEG2 W128 H64 F125:2 Ip A1:1 Cmono\n";
+    const size_t y4mFrameSize = 6 + 128 * 64;
+    ASSERT_EQ(y4m.size(), y4mHeader.size() + 3 * y4mFrameSize);
+    EXPECT_EQ(std::string(y4m.begin(), y4m.begin() + y4mHeader.size()), y4mHeader);
+    // the second frame's top left pixel, after its "FRAME\n", which is low resolution, so it covers 2x2 pixels
+    size_t secondFrameStart = y4mHeader.size() + y4mFrameSize + 6;
+    EXPECT_EQ(y4m[secondFrameStart], 0xFF);
+    EXPECT_EQ(y4m[secondFrameStart + 129], 0xFF);
+    EXPECT_EQ(y4m[secondFrameStart + 2], 0);
+    // the third frame's bottom right pixel, which is high resolution
+    EXPECT_EQ(y4m.back(), 0xFF);
+
+    std::vector<uint8_t> apng = readFile(apngPath);
+    ASSERT_GT(apng.size(), 8u + 25 + 20);
+    EXPECT_EQ(std::string(apng.begin() + 1, apng.begin() + 4), "PNG");
+    // the animation control chunk follows the 8 byte signature and 25 byte header chunk, and holds the number of frames
+    EXPECT_EQ(std::string(apng.begin() + 37, apng.begin() + 41), "acTL");
+    EXPECT_EQ(apng[44], 3);
+    EXPECT_EQ(std::string(apng.end() - 8, apng.end() - 4), "IEND");
+    std::remove(y4mPath.c_str());
+    std::remove(apngPath.c_str());
+}
+
+TEST(FrameRecorderTest, LoadsVideosRecordedBeforeHighResolution) {
+    // a version 1 video, with a single 64x32 frame that only has its top left pixel on
+    std::stringstream video;
+    BinaryStream::writeInteger(video, 0x31463843, sizeof(uint32_t));
+    BinaryStream::writeInteger(video, 1, sizeof(uint16_t));
+    BinaryStream::writeVariableLengthInteger(video, 125);
+    BinaryStream::writeVariableLengthInteger(video, 2);
+    BinaryStream::writeVariableLengthInteger(video, 1);
+    video.put((char)0x80);
+    BinaryStream::writeVariableLengthInteger(video, 255);
+    video.put(0);
+
+    std::vector<FrameBuffer> frames = FrameRecorder::load(video);
+    FrameBuffer expectedFrame = FrameBuffer();
+    expectedFrame.setPixel(0, 0, true);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], expectedFrame);
+}
+
+TEST(FrameRecorderTest, EmulatorRecordsTheScreenAtTheEndOfEveryFrame) {
+    const std::string path = "FrameRecorderTest.c8f";
+    HeadlessSubsystemManager subsystemManager;
+    Chip8Emulator emulator{subsystemManager};
+    // draws the font's 0 at the top left and loops forever
+    const uint8_t program[] = {0x60, 0x00, 0xF0, 0x29, 0xD0, 0x05, 0x12, 0x06};
+    emulator.loadGameData(program, sizeof(program));
+    {
+        FrameRecorder recorder(path, FrameRecorder::Format::RUN_LENGTH_ENCODED, 125, 2);
+        emulator.setFrameRecorder(&recorder);
+        emulator.runCycles(Chip8Emulator::CYCLES_PER_FRAME * 3 + 5);
+        emulator.setFrameRecorder(nullptr);
+        recorder.finish();
+    }
+    std::ifstream file(path, std::ios::binary);
+    std::vector<FrameBuffer> frames = FrameRecorder::load(file);
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[2], subsystemManager.getHeadlessDisplay().getFrameBuffer());
+    EXPECT_TRUE(frames[0].getPixel(0, 0));
+    std::remove(path.c_str());
+}
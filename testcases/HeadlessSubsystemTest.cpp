@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "../src/constants/Constants.h"
+#include "../src/cpu/Cpu.h"
+#include "../src/exceptions/IOException.h"
+#include "../src/subsystems/HeadlessSubsystemManager.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for the subsystems used to run the emulator without SDL
+ */
+TEST(HeadlessSubsystemTest, DisplayPixels) {
+    HeadlessDisplay display;
+    display.setPixel(0, 0, true);
+    display.setPixel(63, 31, true);
+    // out of bounds pixels are ignored
+    display.setPixel(64, 0, true);
+
+    EXPECT_TRUE(display.getPixel(0, 0));
+    EXPECT_TRUE(display.getPixel(63, 31));
+    EXPECT_FALSE(display.getPixel(64, 0));
+    // low resolution rows are the high 64 bits of each row
+    EXPECT_EQ((uint64_t)(display.getFrameBuffer().rows[0] >> 64), 0x8000000000000000ULL);
+    EXPECT_EQ((uint64_t)(display.getFrameBuffer().rows[31] >> 64), 1ULL);
+
+    display.clearScreen();
+    EXPECT_FALSE(display.getPixel(0, 0));
+}
+
+TEST(HeadlessSubsystemTest, CpuDrawsToHeadlessDisplay) {
+    HeadlessSubsystemManager subsystemManager;
+    Memory memory;
+    Cpu cpu(memory, subsystemManager.getDisplay(), subsystemManager.getInputController());
+    // draw the 1 byte sprite at 0x300 (10100000) at 0,0
+    memory.setDataAtAddress(Constants::MEMORY_PROGRAM_START_LOCATION, 0xA3);
+    memory.setDataAtAddress(Constants::MEMORY_PROGRAM_START_LOCATION + 1, 0x00);
+    memory.setDataAtAddress(Constants::MEMORY_PROGRAM_START_LOCATION + 2, 0xD0);
+    memory.setDataAtAddress(Constants::MEMORY_PROGRAM_START_LOCATION + 3, 0x01);
+    memory.setDataAtAddress(0x300, 0xA0);
+    cpu.emulateCycle();
+    cpu.emulateCycle();
+
+    HeadlessDisplay& display = subsystemManager.getHeadlessDisplay();
+    EXPECT_EQ((uint64_t)(display.getFrameBuffer().rows[0] >> 64), 0xA000000000000000ULL);
+    EXPECT_EQ(display.getNumScreenUpdates(), 1u);
+}
+
+TEST(HeadlessSubsystemTest, HighResolutionDisplayScrolls) {
+    HeadlessDisplay display;
+    display.setPixel(1, 0, true);
+    display.setHighResolution(true);
+    // switching resolutions clears the screen
+    EXPECT_FALSE(display.getPixel(1, 0));
+    display.setPixel(0, 0, true);
+    display.setPixel(127, 63, true);
+    display.setPixel(125, 10, true);
+
+    display.scrollDown(2);
+    EXPECT_TRUE(display.getPixel(0, 2));
+    EXPECT_TRUE(display.getPixel(125, 12));
+    // the bottom row was scrolled off, and the top rows were cleared
+    EXPECT_FALSE(display.getPixel(127, 63));
+    EXPECT_FALSE(display.getPixel(0, 0));
+
+    display.scrollRight(4);
+    EXPECT_TRUE(display.getPixel(4, 2));
+    EXPECT_FALSE(display.getPixel(0, 2));
+    EXPECT_FALSE(display.getPixel(125, 12));
+
+    display.scrollLeft(4);
+    EXPECT_TRUE(display.getPixel(0, 2));
+    EXPECT_FALSE(display.getPixel(4, 2));
+}
+
+TEST(HeadlessSubsystemTest, LowResolutionScrollsStayOnScreen) {
+    HeadlessDisplay display;
+    display.setPixel(2, 5, true);
+    display.setPixel(62, 0, true);
+    display.setPixel(40, 31, true);
+
+    // every pixel ends up scrolled off one of the edges
+    display.scrollLeft(4);
+    display.scrollRight(8);
+    display.scrollDown(1);
+    // pixels scrolled past the edges of the low resolution screen are gone, rather than kept in the unused part of the rows
+    const FrameBuffer& frameBuffer = display.getFrameBuffer();
+    EXPECT_TRUE(frameBuffer.rows[0] == 0);
+    EXPECT_TRUE(frameBuffer.rows[5] == 0);
+    EXPECT_TRUE(frameBuffer.rows[FrameBuffer::LOW_RESOLUTION_HEIGHT] == 0);
+    EXPECT_EQ(frameBuffer.getHash(), FrameBuffer().getHash());
+}
+
+TEST(HeadlessSubsystemTest, ScriptedInput) {
+    std::istringstream script("# press key A on the second poll, release it on the fourth\n1 a down\n\n3 a up\n5 2 down\n");
+    ScriptedInputController inputController(ScriptedInputController::parseScript(script), 4);
+
+    inputController.checkForKeyPresses();
+    EXPECT_FALSE(inputController.isKeyPressed(0xA));
+    inputController.checkForKeyPresses();
+    EXPECT_TRUE(inputController.isKeyPressed(0xA));
+    inputController.checkForKeyPresses();
+    inputController.checkForKeyPresses();
+    EXPECT_FALSE(inputController.isKeyPressed(0xA));
+    EXPECT_FALSE(inputController.isExitButtonPressed());
+    inputController.checkForKeyPresses();
+    EXPECT_TRUE(inputController.isExitButtonPressed());
+
+    // waiting for a key skips ahead to the next scripted key press
+    EXPECT_EQ(inputController.waitForKeyPress(), 2);
+    EXPECT_TRUE(inputController.isKeyPressed(2));
+}
+
+TEST(HeadlessSubsystemTest, InvalidScript) {
+    std::istringstream script("1 10 down\n");
+    EXPECT_THROW(ScriptedInputController::parseScript(script), IOException);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "../src/exceptions/InitializationException.h"
+#include "../src/fuzz/InputFuzzer.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for fuzzing small ROMs, and for reading and writing the fuzzer's inputs as input scripts
+ */
+static void expectSameInput(const std::vector<KeyPress> &expected, const std::vector<KeyPress> &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(expected[i].startFrame, actual[i].startFrame);
+        EXPECT_EQ(expected[i].numFrames, actual[i].numFrames);
+        EXPECT_EQ(expected[i].keyNumber, actual[i].keyNumber);
+    }
+}
+
+TEST(InputFuzzerTest, UnreleasedKeyIsHeldUntilTheLastFrame) {
+    std::istringstream script("2 3 down\n4 3 up\n5 a down\n");
+    std::vector<KeyPress> input = InputFuzzer::parseInput(script, 600);
+    expectSameInput({{2, 2, 0x3}, {5, 595, 0xA}}, input);
+
+    std::ostringstream writtenScript;
+    InputFuzzer::writeInput(writtenScript, input);
+    EXPECT_EQ("2 3 down\n4 3 up\n5 a down\n600 a up\n", writtenScript.str());
+    std::istringstream rereadScript(writtenScript.str());
+    expectSameInput(input, InputFuzzer::parseInput(rereadScript, 600));
+}
+
+TEST(InputFuzzerTest, UnreleasedKeyPressedAfterTheLastFrameIsDropped) {
+    std::istringstream script("5 a down\n");
+    EXPECT_TRUE(InputFuzzer::parseInput(script, 5).empty());
+}
+
+TEST(InputFuzzerTest, WriteOverlappingPresses) {
+    // the second press of key 1 starts while the first is held, and the press of key 2 starts as the first press of key 1 ends
+    std::vector<KeyPress> input = {{0, 10, 0x1}, {5, 10, 0x1}, {10, 1, 0x2}};
+    std::ostringstream script;
+    InputFuzzer::writeInput(script, input);
+    EXPECT_EQ("0 1 down\n10 2 down\n11 2 up\n15 1 up\n", script.str());
+}
+
+TEST(InputFuzzerTest, WriteLongPress) {
+    // only the frames a press starts and ends on are visited, so a press that lasts for billions of frames is written right away
+    std::ostringstream script;
+    InputFuzzer::writeInput(script, {{1, UINT32_MAX - 1, 0xF}});
+    EXPECT_EQ("1 f down\n4294967295 f up\n", script.str());
+}
+
+TEST(InputFuzzerTest, FuzzRomThatFaultsAtPowerOn) {
+    // 0x200: return with nothing on the stack
+    InputFuzzer fuzzer({0x00, 0xEE}, 30);
+    fuzzer.fuzz(2, 0.2);
+    ASSERT_EQ(fuzzer.getFaults().size(), 1u);
+    EXPECT_EQ(fuzzer.getFaults()[0].kind, FaultKind::STACK_UNDERFLOW);
+    EXPECT_EQ(fuzzer.getFaults()[0].frameNumber, 0u);
+    EXPECT_GT(fuzzer.getCorpusSize(), 0u);
+    EXPECT_GT(fuzzer.getNumExecutions(), 1u);
+}
+
+TEST(InputFuzzerTest, FuzzRomThatFaultsAfterAKeyPress) {
+    // 0x200: wait for a key, 0x202: return with nothing on the stack
+    InputFuzzer fuzzer({0xF0, 0x0A, 0x00, 0xEE}, 30);
+    fuzzer.fuzz(2, 0.2);
+    ASSERT_EQ(fuzzer.getFaults().size(), 1u);
+    const FuzzerFault &fault = fuzzer.getFaults()[0];
+    EXPECT_EQ(fault.kind, FaultKind::STACK_UNDERFLOW);
+    EXPECT_FALSE(fault.input.empty());
+    EXPECT_GT(fuzzer.getCorpusSize(), 0u);
+
+    // the input that found the fault faults again when it is replayed
+    FuzzerFault replayedFault;
+    EXPECT_TRUE(fuzzer.replay(fault.input, replayedFault));
+    EXPECT_EQ(replayedFault.kind, fault.kind);
+    EXPECT_EQ(replayedFault.programCounter, fault.programCounter);
+}
+
+TEST(InputFuzzerTest, InputsMustPlayForAFrame) { EXPECT_THROW(InputFuzzer({0x12, 0x00}, 0), InitializationException); }
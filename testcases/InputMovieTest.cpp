@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "../src/Chip8.h"
+#include "../src/exceptions/IOException.h"
+#include "../src/exceptions/InitializationException.h"
+#include "../src/io/InputMovie.h"
+#include "../src/subsystems/HeadlessSubsystemManager.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for recording input movies and replaying them to the same state
+ */
+// 0x200: set V2 to a random number, 0x202: add V2 to V3, 0x204: skip the next instruction if the key in V1 (0) isn't pressed,
+// 0x206: add 1 to V4, 0x208: jump to 0x200
+static const std::vector<uint8_t> PROGRAM = {0xC2, 0xFF, 0x83, 0x24, 0xE1, 0xA1, 0x74, 0x01, 0x12, 0x00};
+
+static void waitForCycles(const Chip8Emulator& emulator, uint64_t numCycles) {
+    uint64_t targetNumCycles = emulator.getNumCyclesExecuted() + numCycles;
+    while (emulator.getNumCyclesExecuted() < targetNumCycles) {
+        std::this_thread::yield();
+    }
+}
+
+TEST(InputMovieTest, SaveAndLoad) {
+    InputMovie movie;
+    movie.romHash = 0x0123456789ABCDEFULL;
+    movie.randomSeed = 42;
+    movie.numCycles = 1ULL << 40;
+    movie.finalStateHash = 7;
+    movie.events = {{0, 0x0, true}, {5, 0xF, true}, {300, 0x0, false}, {(1ULL << 40) - 1, 0xF, false}};
+    std::stringstream file;
+    movie.save(file);
+
+    InputMovie loadedMovie = InputMovie::load(file);
+    EXPECT_EQ(loadedMovie.romHash, movie.romHash);
+    EXPECT_EQ(loadedMovie.randomSeed, movie.randomSeed);
+    EXPECT_EQ(loadedMovie.numCycles, movie.numCycles);
+    EXPECT_EQ(loadedMovie.finalStateHash, movie.finalStateHash);
+    ASSERT_EQ(loadedMovie.events.size(), movie.events.size());
+    for (size_t i = 0; i < movie.events.size(); i++) {
+        EXPECT_EQ(loadedMovie.events[i].cycleNumber, movie.events[i].cycleNumber);
+        EXPECT_EQ(loadedMovie.events[i].keyNumber, movie.events[i].keyNumber);
+        EXPECT_EQ(loadedMovie.events[i].isPressed, movie.events[i].isPressed);
+    }
+
+    std::stringstream truncatedFile(file.str().substr(0, file.str().size() - 1));
+    EXPECT_THROW(InputMovie::load(truncatedFile), IOException);
+}
+
+TEST(InputMovieTest, MoviesFromOlderVersionsAreRejected) {
+    std::stringstream file;
+    InputMovie().save(file);
+    // the version follows the 4 byte magic number, and version 1 movies hash states without the SUPER-CHIP's additions
+    std::string oldFile = file.str();
+    oldFile[4] = 1;
+    oldFile[5] = 0;
+    std::stringstream oldMovie(oldFile);
+    EXPECT_THROW(InputMovie::load(oldMovie), IOException);
+}
+
+TEST(InputMovieTest, ReplayEndsInTheRecordedState) {
+    InputMovie movie;
+    HeadlessSubsystemManager recordingSubsystemManager;
+    Chip8Emulator recordingEmulator{recordingSubsystemManager};
+    recordingEmulator.loadGameData(PROGRAM.data(), PROGRAM.size());
+    recordingEmulator.setEmulationSpeed(Chip8Emulator::UNTHROTTLED);
+    recordingEmulator.startRecording(movie);
+    // the emulation thread picks the cycle each key lands at, so the recording can't be predicted
+    recordingEmulator.startEmulationThread();
+    for (int i = 0; i < 3; i++) {
+        waitForCycles(recordingEmulator, 1000);
+        recordingEmulator.queueKeyEvent({0, 0, true});
+        waitForCycles(recordingEmulator, 1000);
+        recordingEmulator.queueKeyEvent({0, 0, false});
+    }
+    waitForCycles(recordingEmulator, 1000);
+    recordingEmulator.stopEmulation();
+    recordingEmulator.waitForEmulationThread();
+    recordingEmulator.stopRecording();
+    EXPECT_EQ(movie.events.size(), 6u);
+
+    std::stringstream file;
+    movie.save(file);
+    InputMovie loadedMovie = InputMovie::load(file);
+    HeadlessSubsystemManager replayingSubsystemManager;
+    Chip8Emulator replayingEmulator{replayingSubsystemManager};
+    replayingEmulator.loadGameData(PROGRAM.data(), PROGRAM.size());
+    replayingEmulator.startReplay(loadedMovie);
+    replayingEmulator.runCycles((uint32_t)loadedMovie.numCycles);
+    EXPECT_EQ(replayingEmulator.saveState().getHash(), movie.finalStateHash);
+    EXPECT_EQ(replayingEmulator.getCpu().getRegisterValue(3), recordingEmulator.getCpu().getRegisterValue(3));
+    EXPECT_EQ(replayingEmulator.getCpu().getRegisterValue(4), recordingEmulator.getCpu().getRegisterValue(4));
+
+    // holding the key runs an extra instruction per loop, so without the key events fewer random numbers are drawn
+    loadedMovie.events.clear();
+    HeadlessSubsystemManager keylessSubsystemManager;
+    Chip8Emulator keylessEmulator{keylessSubsystemManager};
+    keylessEmulator.loadGameData(PROGRAM.data(), PROGRAM.size());
+    keylessEmulator.startReplay(loadedMovie);
+    keylessEmulator.runCycles((uint32_t)loadedMovie.numCycles);
+    EXPECT_NE(keylessEmulator.saveState().getHash(), movie.finalStateHash);
+}
+
+TEST(InputMovieTest, MoviesOnlyStartAtTheFirstCycleOfTheSameGame) {
+    HeadlessSubsystemManager subsystemManager;
+    Chip8Emulator emulator{subsystemManager};
+    emulator.loadGameData(PROGRAM.data(), PROGRAM.size());
+    InputMovie movie;
+    movie.romHash = 1;
+    EXPECT_THROW(emulator.startReplay(movie), InitializationException);
+
+    emulator.runCycles(1);
+    EXPECT_THROW(emulator.startRecording(movie), InitializationException);
+}
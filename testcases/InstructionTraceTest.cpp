@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "../src/Chip8.h"
+#include "../src/cpu/InstructionTrace.h"
+#include "../src/exceptions/IOException.h"
+#include "../src/subsystems/HeadlessSubsystemManager.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for tracing executed instructions, and saving traces to be decoded and diffed
+ */
+TEST(InstructionTraceTest, RingKeepsTheMostRecentInstructions) {
+    // rounded up to 4
+    InstructionTrace trace(3);
+    for (uint64_t cycleNumber = 0; cycleNumber < 6; cycleNumber++) {
+        trace.record({cycleNumber, 0x200, 0x00E0, 0, 0, 0});
+    }
+    std::vector<TraceRecord> records = trace.getRecords();
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records.front().cycleNumber, 2u);
+    EXPECT_EQ(records.back().cycleNumber, 5u);
+    EXPECT_EQ(trace.getNumRecorded(), 6u);
+
+    trace.clear();
+    EXPECT_TRUE(trace.getRecords().empty());
+}
+
+TEST(InstructionTraceTest, SaveAndLoad) {
+    InstructionTrace trace;
+    trace.record({7, 0x200, 0x6A05, 0, 1 << 0xA, 0x05});
+    trace.record({8, 0x202, 0xA2F0, 0x2F0, 0, 0});
+    trace.record({1000, 0x204, 0x8AB4, 0x2F0, (1 << 0xA) | (1 << 0xF), 0x10});
+    std::stringstream file;
+    trace.save(file);
+
+    std::vector<TraceRecord> loaded = InstructionTrace::load(file);
+    EXPECT_EQ(loaded, trace.getRecords());
+    EXPECT_EQ(loaded[2].getChangedRegisterNumber(), 0xA);
+    EXPECT_EQ(loaded[1].getChangedRegisterNumber(), (uint8_t)TraceRecord::NO_REGISTER_CHANGED);
+
+    std::stringstream notATrace("C8M1");
+    EXPECT_THROW(InstructionTrace::load(notATrace), IOException);
+}
+
+TEST(InstructionTraceTest, EmulatorTracesOnlyWhileEnabled) {
+    // 0x200: set VA to 5, 0x202: set I to 0x2F0, 0x204: add 1 to VA, 0x206: jump to 0x204
+    const std::vector<uint8_t> program = {0x6A, 0x05, 0xA2, 0xF0, 0x7A, 0x01, 0x12, 0x04};
+    HeadlessSubsystemManager headlessSubsystemManager;
+    Chip8Emulator emulator{headlessSubsystemManager};
+    emulator.loadGameData(program.data(), program.size());
+    emulator.runCycles(1);
+    emulator.setInstructionTracing(true);
+    emulator.runCycles(3);
+    emulator.setInstructionTracing(false);
+    emulator.runCycles(10);
+
+    std::vector<TraceRecord> records = emulator.getInstructionTrace().getRecords();
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0], (TraceRecord{1, 0x202, 0xA2F0, 0x2F0, 0, 0}));
+    EXPECT_EQ(records[1], (TraceRecord{2, 0x204, 0x7A01, 0x2F0, 1 << 0xA, 6}));
+    EXPECT_EQ(records[2], (TraceRecord{3, 0x206, 0x1204, 0x2F0, 0, 0}));
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "../src/exceptions/IndexOutOfBoundsException.h"
+#include "../src/subsystems/input/KeyMap.h"
+#include "../src/subsystems/input/ScriptedInputController.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for mapping keyboard keycodes to chip-8 keys
+ */
+static const int32_t SCANCODE_KEYCODE_BIT = 1 << 30;
+
+TEST(KeyMapTest, MapsCharacterAndScancodeKeycodes) {
+    KeyMap keyMap;
+    EXPECT_EQ(keyMap.getKeyNumber('q'), (int)KeyMap::NO_KEY);
+
+    keyMap.setMapping('q', 0x4);
+    keyMap.setMapping(SCANCODE_KEYCODE_BIT | 82, 0xA);  // the up arrow key in SDL
+    keyMap.setMapping('w', 0xA);
+    EXPECT_EQ(keyMap.getKeyNumber('q'), 0x4);
+    EXPECT_EQ(keyMap.getKeyNumber(SCANCODE_KEYCODE_BIT | 82), 0xA);
+    EXPECT_EQ(keyMap.getKeyNumber('w'), 0xA);
+    EXPECT_EQ(keyMap.getKeyNumber(82), (int)KeyMap::NO_KEY);
+
+    keyMap.setMapping('q', 0x5);
+    EXPECT_EQ(keyMap.getKeyNumber('q'), 0x5);
+    keyMap.removeMapping('q');
+    EXPECT_EQ(keyMap.getKeyNumber('q'), (int)KeyMap::NO_KEY);
+}
+
+TEST(KeyMapTest, RejectsUnmappableKeys) {
+    KeyMap keyMap;
+    EXPECT_THROW(keyMap.setMapping('q', IInputController::NUM_KEYS), IndexOutOfBoundsException);
+    EXPECT_THROW(keyMap.setMapping(-1, 0), IndexOutOfBoundsException);
+    EXPECT_THROW(keyMap.setMapping(SCANCODE_KEYCODE_BIT | 4096, 0), IndexOutOfBoundsException);
+    EXPECT_EQ(keyMap.getKeyNumber(SCANCODE_KEYCODE_BIT | 4096), (int)KeyMap::NO_KEY);
+}
+
+TEST(KeyMapTest, PressedKeysFormABitmask) {
+    ScriptedInputController inputController;
+    inputController.setKeyPressed(0x1, true);
+    inputController.setKeyPressed(0xF, true);
+    EXPECT_EQ(inputController.getPressedKeys(), (1 << 0x1) | (1 << 0xF));
+    inputController.setKeyPressed(0x1, false);
+    EXPECT_EQ(inputController.getPressedKeys(), 1 << 0xF);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "../src/utils/MetricsRegistry.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for the emulator's metrics and their Prometheus text format
+ */
+TEST(MetricsRegistryTest, HistogramBucketsHoldTheirValuesWithinASixteenthOfThem) {
+    const uint64_t values[] = {0, 1, 31, 32, 33, 1000, 16666667, 123456789012, UINT64_MAX};
+    for (uint64_t value : values) {
+        int bucketIndex = Histogram::getBucketIndex(value);
+        ASSERT_LT(bucketIndex, (int)Histogram::NUM_BUCKETS);
+        uint64_t upperBound = Histogram::getBucketUpperBound(bucketIndex);
+        EXPECT_GE(upperBound, value);
+        EXPECT_LE(upperBound - value, value / 16);
+        if (bucketIndex > 0) {
+            EXPECT_LT(Histogram::getBucketUpperBound(bucketIndex - 1), value);
+        }
+    }
+}
+
+TEST(MetricsRegistryTest, HistogramPercentiles) {
+    Histogram histogram;
+    EXPECT_EQ(histogram.getValueAtPercentile(50), 0u);
+    for (uint64_t value = 1; value <= 100; value++) {
+        histogram.record(value * 1000);
+    }
+    EXPECT_EQ(histogram.getCount(), 100u);
+    EXPECT_EQ(histogram.getSumNanos(), 5050000u);
+    EXPECT_NEAR((double)histogram.getValueAtPercentile(50), 50000, 50000 / 16);
+    EXPECT_NEAR((double)histogram.getValueAtPercentile(99), 99000, 99000 / 16);
+    EXPECT_EQ(histogram.getValueAtPercentile(100), Histogram::getBucketUpperBound(Histogram::getBucketIndex(100000)));
+    histogram.reset();
+    EXPECT_EQ(histogram.getCount(), 0u);
+}
+
+TEST(MetricsRegistryTest, WritesPrometheusTextFormat) {
+    MetricsRegistry metrics;
+    Counter &counter = metrics.addCounter("test_cycles_total", "Cycles run");
+    Gauge &gauge = metrics.addGauge("test_speed", "Speed");
+    Histogram &histogram = metrics.addHistogram("test_duration_seconds", "Durations");
+    counter.increment(5);
+    counter.increment();
+    gauge.set(0.5);
+    histogram.record(2);
+    histogram.record(2);
+    histogram.record(3);
+
+    std::ostringstream output;
+    metrics.writePrometheus(output);
+    EXPECT_EQ(output.str(),
+              "# HELP test_cycles_total Cycles run\n"
+              "# TYPE test_cycles_total counter\n"
+              "test_cycles_total 6\n"
+              "# HELP test_speed Speed\n"
+              "# TYPE test_speed gauge\n"
+              "test_speed 0.5\n"
+              "# HELP test_duration_seconds Durations\n"
+              "# TYPE test_duration_seconds histogram\n"
+              "test_duration_seconds_bucket{le=\"2e-09\"} 2\n"
+              "test_duration_seconds_bucket{le=\"3e-09\"} 3\n"
+              "test_duration_seconds_bucket{le=\"+Inf\"} 3\n"
+              "test_duration_seconds_sum 7e-09\n"
+              "test_duration_seconds_count 3\n");
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include "../src/utils/OptionUtil.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for parsing the numeric values of command line options
+ */
+TEST(OptionUtilTest, WholeNumbers) {
+    uint32_t number = 42;
+    EXPECT_TRUE(OptionUtil::parseNumber("8", 0, 8, number));
+    EXPECT_EQ(number, 8u);
+    EXPECT_TRUE(OptionUtil::parseNumber("ff", 0, UINT32_MAX, number, 16));
+    EXPECT_EQ(number, 0xFFu);
+
+    // bad values leave the number unchanged
+    for (const char *value : {"", "x", "9", "-1", " 3", "3 ", "+3", "0x10", "99999999999999999999999"}) {
+        EXPECT_FALSE(OptionUtil::parseNumber(value, 0, 8, number)) << value;
+        EXPECT_EQ(number, 0xFFu);
+    }
+    uint64_t bigNumber = 0;
+    EXPECT_TRUE(OptionUtil::parseNumber("FFFFFFFFFFFFFFFF", 0, UINT64_MAX, bigNumber, 16));
+    EXPECT_EQ(bigNumber, UINT64_MAX);
+}
+
+TEST(OptionUtilTest, DecimalNumbers) {
+    double number = 0;
+    EXPECT_TRUE(OptionUtil::parseNumber("2.5", 0, 10, number));
+    EXPECT_EQ(number, 2.5);
+    for (const char *value : {"", "x", "2.5s", " 1", "-1", "11", "nan", "inf"}) {
+        EXPECT_FALSE(OptionUtil::parseNumber(value, 0, 10, number)) << value;
+        EXPECT_EQ(number, 2.5);
+    }
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include "../src/utils/PhaseTracer.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for recording the phases of the frame loop into a Chrome trace
+ */
+TEST(PhaseTracerTest, RecordsPhasesOfEveryThreadOnlyWhileTracing) {
+    PhaseTracer::clear();
+    { ScopedPhase phase("before start"); }
+    PhaseTracer::start();
+    {
+        ScopedPhase phase("outer");
+        { ScopedPhase innerPhase("inner"); }
+    }
+    std::thread otherThread([] {
+        PhaseTracer::setThreadName("other \"thread\"");
+        ScopedPhase phase("on other thread");
+    });
+    otherThread.join();
+    PhaseTracer::stop();
+    { ScopedPhase phase("after stop"); }
+
+    std::ostringstream trace;
+    PhaseTracer::writeChromeTrace(trace);
+    std::string json = trace.str();
+    EXPECT_EQ(json.find("before start"), std::string::npos);
+    EXPECT_EQ(json.find("after stop"), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"outer\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"inner\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"on other thread\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"other \\\"thread\\\"\"}"), std::string::npos);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+    EXPECT_EQ(PhaseTracer::getNumDroppedPhases(), 0u);
+    PhaseTracer::clear();
+}
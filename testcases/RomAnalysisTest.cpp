@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include "../src/analysis/AnalysisCache.h"
+#include "../src/analysis/BlockMap.h"
+#include "../src/analysis/Disassembler.h"
+#include "../src/analysis/RomAnalysis.h"
+#include "../src/constants/Constants.h"
+#include "../src/constants/OpcodeBitmasks.h"
+#include "../src/constants/OpcodeBitshifts.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for the analyses built on top of the control flow graph, and for persisting their results
+ */
+static void loadAnalyzedProgram(Memory& memory, std::vector<uint16_t> opcodes) {
+    for (unsigned int address = 0; address < Memory::NUM_BYTES_OF_MEMORY; address++) {
+        memory.setDataAtAddress(address, 0);
+    }
+    uint16_t address = Constants::MEMORY_PROGRAM_START_LOCATION;
+    for (uint16_t opcode : opcodes) {
+        memory.setDataAtAddress(address, (uint8_t)((opcode & OpcodeBitmasks::FIRST_BYTE) >> OpcodeBitshifts::NIBBLE_TWO));
+        memory.setDataAtAddress(address + 1, (uint8_t)(opcode & OpcodeBitmasks::LAST_BYTE));
+        address += Instruction::SIZE_IN_BYTES;
+    }
+}
+
+TEST(RomAnalysisTest, CallGraph) {
+    Memory memory;
+    // main calls 0x206, which calls 0x20A
+    loadAnalyzedProgram(memory, {0x2206, 0x1202, 0x0000, 0x220A, 0x00EE, 0x00EE});
+    RomAnalysis analysis(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+
+    ASSERT_EQ(analysis.getCallGraph().size(), 3u);
+    EXPECT_EQ(analysis.getCallGraph().at(0x200), std::set<uint16_t>({0x206}));
+    EXPECT_EQ(analysis.getCallGraph().at(0x206), std::set<uint16_t>({0x20A}));
+    EXPECT_TRUE(analysis.getCallGraph().at(0x20A).empty());
+    EXPECT_FALSE(analysis.isCodeAddress(0x204));
+}
+
+TEST(RomAnalysisTest, SpriteRegionsAndSelfModifyingStores) {
+    Memory memory;
+    // draw two overlapping sprites from 0x20C, then overwrite the jump at 0x20A
+    loadAnalyzedProgram(memory, {0xA20C, 0xD015, 0xD013, 0xA20A, 0xF155, 0x120A, 0xF090});
+    RomAnalysis analysis(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+
+    ASSERT_EQ(analysis.getSpriteRegions().size(), 1u);
+    EXPECT_EQ(analysis.getSpriteRegions()[0].startAddress, 0x20C);
+    EXPECT_EQ(analysis.getSpriteRegions()[0].length, 5);
+
+    ASSERT_EQ(analysis.getSelfModifyingStores().size(), 1u);
+    EXPECT_EQ(analysis.getSelfModifyingStores()[0].instructionAddress, 0x208);
+    EXPECT_EQ(analysis.getSelfModifyingStores()[0].target.length, 2);
+}
+
+TEST(RomAnalysisTest, BlockMapRoundTrip) {
+    Memory memory;
+    loadAnalyzedProgram(memory, {0x6001, 0x3001, 0x1200, 0x1206});
+    RomAnalysis analysis(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+    BlockMap blockMap(analysis);
+    const uint64_t romHash = 0x1234;
+
+    std::stringstream sidecar;
+    blockMap.save(sidecar, romHash);
+    BlockMap loadedBlockMap;
+    ASSERT_TRUE(loadedBlockMap.load(sidecar, romHash));
+    ASSERT_EQ(loadedBlockMap.getBlocks().size(), blockMap.getBlocks().size());
+    EXPECT_TRUE(loadedBlockMap.isBlockStart(0x204));
+    EXPECT_TRUE(loadedBlockMap.isCodeAddress(0x207));
+    EXPECT_FALSE(loadedBlockMap.isCodeAddress(0x208));
+
+    // a block map for a different ROM must not be used
+    std::stringstream staleSidecar;
+    blockMap.save(staleSidecar, romHash);
+    EXPECT_FALSE(BlockMap().load(staleSidecar, romHash + 1));
+}
+
+TEST(RomAnalysisTest, LoadOrAnalyzeReusesTheSidecar) {
+    const std::string romPath = "RomAnalysisTest.ch8";
+    const uint64_t romHash = 0x1234;
+    Memory memory;
+    loadAnalyzedProgram(memory, {0xA20C, 0x3001, 0x1200, 0xD015, 0x2200, 0x00EE, 0xF090});
+    RomAnalysis analysis(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+    std::remove(AnalysisCache::getSidecarPath(romPath).c_str());
+    BlockMap blockMap = AnalysisCache::loadOrAnalyze(romPath, romHash, memory);
+    ASSERT_EQ(blockMap.getBlocks().size(), analysis.getControlFlowGraph().getBasicBlocks().size());
+
+    // the second time the block map comes from the sidecar, so the ROM isn't analyzed again
+    Memory otherMemory;
+    loadAnalyzedProgram(otherMemory, {0x1200});
+    BlockMap cachedBlockMap = AnalysisCache::loadOrAnalyze(romPath, romHash, otherMemory);
+    std::remove(AnalysisCache::getSidecarPath(romPath).c_str());
+    EXPECT_EQ(cachedBlockMap.getBlockStartAddresses(), blockMap.getBlockStartAddresses());
+
+    // rebuilding the analysis from the cached block starts gives the same blocks, successors and sprites as discovering them
+    RomAnalysis cachedAnalysis(memory, Constants::MEMORY_PROGRAM_START_LOCATION, cachedBlockMap.getBlockStartAddresses());
+    const auto &blocks = analysis.getControlFlowGraph().getBasicBlocks();
+    const auto &cachedBlocks = cachedAnalysis.getControlFlowGraph().getBasicBlocks();
+    ASSERT_EQ(cachedBlocks.size(), blocks.size());
+    for (const auto &block : blocks) {
+        const BasicBlock *cachedBlock = cachedAnalysis.getControlFlowGraph().findBasicBlock(block.first);
+        ASSERT_NE(cachedBlock, nullptr);
+        EXPECT_EQ(cachedBlock->getEndAddress(), block.second.getEndAddress());
+        EXPECT_EQ(cachedBlock->getSuccessors(), block.second.getSuccessors());
+    }
+    EXPECT_EQ(cachedAnalysis.getCodeBitmap(), analysis.getCodeBitmap());
+    EXPECT_EQ(cachedAnalysis.getCallGraph(), analysis.getCallGraph());
+    ASSERT_EQ(cachedAnalysis.getSpriteRegions().size(), analysis.getSpriteRegions().size());
+}
+
+TEST(RomAnalysisTest, Mnemonics) {
+    EXPECT_EQ(Disassembler::getMnemonic(Instruction::decode(0x200, 0xD01F)), "DRW V0, V1, 15");
+    EXPECT_EQ(Disassembler::getMnemonic(Instruction::decode(0x200, 0x8AB4)), "ADD VA, VB");
+    EXPECT_EQ(Disassembler::getMnemonic(Instruction::decode(0x200, 0xF265)), "LD V2, [I]");
+    EXPECT_EQ(Disassembler::getMnemonic(Instruction::decode(0x200, 0x8008)), "DW 0x8008");
+}
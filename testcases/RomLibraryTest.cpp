@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../src/Chip8.h"
+#include "../src/exceptions/IOException.h"
+#include "../src/io/RomFile.h"
+#include "../src/io/RomLibrary.h"
+#include "../src/subsystems/HeadlessSubsystemManager.h"
+#include "../src/utils/HashUtil.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for mapping ROMs into memory and indexing collections of them
+ */
+static void writeFile(const std::string &path, const std::vector<uint8_t> &data) {
+    std::ofstream file(path, std::ios::binary);
+    file.write((const char *)data.data(), data.size());
+}
+
+TEST(RomLibraryTest, LoadingAGameFileCopiesOnlyItsBytesAndRejectsOversizedFiles) {
+    const std::string path = "RomLibraryTest.ch8";
+    const std::vector<uint8_t> game = {0x12, 0x00, 0xAB};
+    writeFile(path, game);
+    HeadlessSubsystemManager headlessSubsystemManager;
+    Chip8Emulator emulator{headlessSubsystemManager};
+    emulator.loadGameData(std::vector<uint8_t>(RomFile::MAX_ROM_SIZE, 0xFF).data(), RomFile::MAX_ROM_SIZE);
+    emulator.loadGameFile(path);
+    EmulatorState state = emulator.saveState();
+    EXPECT_EQ(state.memory[Constants::MEMORY_PROGRAM_START_LOCATION + 2], 0xAB);
+    EXPECT_EQ(state.memory[Constants::MEMORY_PROGRAM_START_LOCATION + 3], 0);
+    EXPECT_EQ(state.memory[Memory::NUM_BYTES_OF_MEMORY - 1], 0);
+
+    writeFile(path, std::vector<uint8_t>(RomFile::MAX_ROM_SIZE + 1, 0));
+    EXPECT_THROW(emulator.loadGameFile(path), IOException);
+    writeFile(path, {});
+    EXPECT_THROW(emulator.loadGameFile(path), IOException);
+    std::remove(path.c_str());
+}
+
+TEST(RomLibraryTest, FindsIndexedRomsByHashAndFlagsOnesTooLargeToLoad) {
+    const std::vector<std::string> romPaths = {"RomLibraryTest_pong.ch8", "roms_copy_of_pong", "RomLibraryTest_huge.ch8"};
+    const std::vector<uint8_t> pong = {0x6A, 0x02, 0x12, 0x00};
+    writeFile(romPaths[0], pong);
+    writeFile(romPaths[1], pong);
+    const std::vector<uint8_t> huge(RomFile::MAX_ROM_SIZE + 1, 0x12);
+    writeFile(romPaths[2], huge);
+    const std::string indexPath = "RomLibraryTest.c8l";
+    RomLibrary::build(romPaths, indexPath);
+
+    RomLibrary library(indexPath);
+    EXPECT_EQ(library.getNumRoms(), 2u);
+    EXPECT_LT(library.getRom(0).hash, library.getRom(1).hash);
+    RomLibraryEntry entry;
+    ASSERT_TRUE(library.findRom(HashUtil::fnv1a(pong.data(), pong.size()), entry));
+    EXPECT_EQ(entry.path, romPaths[0]);
+    EXPECT_EQ(entry.title, "RomLibraryTest_pong");
+    EXPECT_EQ(entry.size, pong.size());
+    EXPECT_TRUE(entry.isLoadable());
+    EXPECT_EQ(entry.hash, RomFile(romPaths[0]).getHash());
+    EXPECT_GT(entry.modifiedTime, 0);
+    ASSERT_TRUE(library.findRom(HashUtil::fnv1a(huge.data(), huge.size()), entry));
+    EXPECT_EQ(entry.title, "RomLibraryTest_huge");
+    EXPECT_FALSE(entry.isLoadable());
+    EXPECT_FALSE(library.findRom(0, entry));
+
+    for (const std::string &romPath : romPaths) {
+        std::remove(romPath.c_str());
+    }
+    std::remove(indexPath.c_str());
+}
+
+TEST(RomLibraryTest, RejectsFilesThatAreNotIndexes) {
+    const std::string path = "RomLibraryTest.bin";
+    writeFile(path, {'C', '8', 'F', '1', 1, 0, 0, 0, 0, 0, 0, 0, 16, 0, 0, 0});
+    EXPECT_THROW(RomLibrary library(path), IOException);
+    EXPECT_THROW(RomLibrary library("RomLibraryTest_missing.c8l"), IOException);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/Chip8.h"
+#include "../src/env/EnvironmentClient.h"
+#include "../src/env/EnvironmentServer.h"
+#include "../src/exceptions/InitializationException.h"
+#include "../src/subsystems/HeadlessSubsystemManager.h"
+#include "../src/utils/SpscRingBuffer.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for the shared memory environment. The server and client run on separate threads of this process, but communicate only
+ * through the shared memory segment, exactly as they would from separate processes.
+ */
+class SharedMemoryEnvironmentTest : public ::testing::Test {
+   protected:
+    std::string segmentName = "/chip8_env_test_" + std::to_string(getpid());
+    HeadlessSubsystemManager subsystemManager;
+    Chip8Emulator emulator{subsystemManager};
+
+    void loadProgram(std::initializer_list<uint8_t> program) {
+        std::vector<uint8_t> data(program);
+        emulator.loadGameData(data.data(), data.size());
+    }
+};
+
+TEST(SpscRingBufferTest, PushAndPopInOrder) {
+    SpscRingBuffer<int, 4> ring;
+    int item = 0;
+    EXPECT_FALSE(ring.tryPop(item));
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(ring.tryPush(i));
+    }
+    EXPECT_FALSE(ring.tryPush(4));
+    EXPECT_EQ(ring.size(), 4u);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(ring.tryPop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(ring.tryPop(item));
+}
+
+TEST_F(SharedMemoryEnvironmentTest, StepsPublishObservations) {
+    // 0x200: wait for a key into V0, 0x202: add 1 to V1, 0x204: jump to 0x202
+    loadProgram({0xF0, 0x0A, 0x71, 0x01, 0x12, 0x02});
+    EnvironmentServer server(emulator, subsystemManager, segmentName, 0x200, 4);
+    std::thread serverThread(&EnvironmentServer::serve, &server);
+
+    EnvironmentClient client(segmentName);
+    EXPECT_EQ(client.getObservation().stepNumber, 0u);
+    EXPECT_EQ(client.getObservation().rewardRegion[0], 0xF0);
+
+    // no key is held, so the program can't get past the key wait
+    const EnvironmentObservation &observation = client.step(0);
+    EXPECT_EQ(observation.stepNumber, 1u);
+    EXPECT_EQ(observation.flags, (uint8_t)EnvironmentObservation::FLAG_WAITING_FOR_KEY);
+    EXPECT_EQ(observation.programCounter, 0x200);
+
+    client.step(1 << 5, 2);
+    EXPECT_EQ(observation.stepNumber, 2u);
+    EXPECT_EQ(observation.flags, 0);
+    EXPECT_EQ(observation.numCyclesExecuted, 2 * Chip8Emulator::CYCLES_PER_FRAME);
+    EXPECT_EQ(observation.registers[0], 5);
+    EXPECT_EQ(observation.rewardRegionLength, 4);
+    EXPECT_EQ(observation.rewardRegion[2], 0x71);
+
+    client.stopServer();
+    serverThread.join();
+}
+
+TEST_F(SharedMemoryEnvironmentTest, ResetStartsANewEpisodeFromPowerOn) {
+    // 0x200: point I at the font, 0x202: add 1 to V1, 0x204: store V0-V1 over the font, 0x206: jump to 0x202
+    loadProgram({0xA0, 0x50, 0x71, 0x01, 0xF1, 0x55, 0x12, 0x02});
+    EnvironmentServer server(emulator, subsystemManager, segmentName, Constants::MEMORY_FONT_START_LOCATION, 2);
+    std::thread serverThread(&EnvironmentServer::serve, &server);
+
+    EnvironmentClient client(segmentName);
+    const EnvironmentObservation &observation = client.step(0, 1);
+    EXPECT_NE(observation.registers[1], 0);
+    EXPECT_EQ(observation.rewardRegion[0], 0);
+
+    client.reset();
+    EXPECT_EQ(observation.stepNumber, 2u);
+    EXPECT_EQ(observation.programCounter, 0x200);
+    EXPECT_EQ(observation.registers[1], 0);
+    EXPECT_EQ(observation.numCyclesExecuted, 0u);
+    // the font the program overwrote is back
+    EXPECT_EQ(observation.rewardRegion[0], 0xF0);
+    EXPECT_EQ(observation.rewardRegion[1], 0x90);
+
+    client.reset(0, 1);
+    EXPECT_EQ(observation.numCyclesExecuted, 1 * Chip8Emulator::CYCLES_PER_FRAME);
+
+    client.stopServer();
+    serverThread.join();
+}
+
+TEST_F(SharedMemoryEnvironmentTest, ClientRequiresServer) {
+    EXPECT_THROW(EnvironmentClient client(segmentName), InitializationException);
+}
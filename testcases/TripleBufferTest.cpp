@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "../src/subsystems/display/FrameBuffer.h"
+#include "../src/utils/TripleBuffer.h"
+
+using namespace Chip8;
+
+/**
+ * Testcases for handing frames between threads with a TripleBuffer
+ */
+TEST(TripleBufferTest, ReaderGetsNewestValue) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.update());
+
+    buffer.getWriteBuffer() = 1;
+    buffer.publish();
+    buffer.getWriteBuffer() = 2;
+    buffer.publish();
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.getReadBuffer(), 2);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.getReadBuffer(), 2);
+
+    buffer.getWriteBuffer() = 3;
+    buffer.publish();
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.getReadBuffer(), 3);
+}
+
+TEST(TripleBufferTest, FramesAreNeverTorn) {
+    static const uint64_t NUM_FRAMES = 20000;
+    TripleBuffer<FrameBuffer> frames;
+    std::thread writer([&frames] {
+        for (uint64_t frameNumber = 1; frameNumber <= NUM_FRAMES; frameNumber++) {
+            FrameBuffer& frameBuffer = frames.getWriteBuffer();
+            for (int y = 0; y < FrameBuffer::MAX_HEIGHT; y++) {
+                frameBuffer.rows[y] = frameNumber;
+            }
+            frames.publish();
+        }
+    });
+
+    // every row of a frame is written with the same frame number, so a frame mixing two writes would have rows that differ
+    uint64_t lastFrameNumber = 0;
+    while (lastFrameNumber < NUM_FRAMES) {
+        if (frames.update()) {
+            const FrameBuffer& frameBuffer = frames.getReadBuffer();
+            uint64_t frameNumber = (uint64_t)frameBuffer.rows[0];
+            for (int y = 1; y < FrameBuffer::MAX_HEIGHT; y++) {
+                ASSERT_EQ((uint64_t)frameBuffer.rows[y], frameNumber);
+            }
+            ASSERT_GT(frameNumber, lastFrameNumber);
+            lastFrameNumber = frameNumber;
+        }
+    }
+    writer.join();
+}
@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+#include "../../src/constants/Constants.h"
+#include "../../src/cpu/Cpu.h"
+#include "../../src/storage/Memory.h"
+#include "../../src/subsystems/display/HeadlessDisplay.h"
+#include "../../src/subsystems/input/ScriptedInputController.h"
+
+using namespace Chip8;
+
+/**
+ * Microbenchmarks of the cpu: one per opcode handler, plus fetching and the memory accesses every handler is built on.
+ * Handlers are private, so each one is reached through executeOpcodeAt(), which decodes the opcode and calls the handler exactly as
+ * emulateCycle() does after fetching it. Every benchmark of a handler therefore includes the cost of decoding, which is the same for all
+ * of them; BM_DecodeOnly measures it on its own (an unconditional skip that does nothing else).
+ */
+
+const uint16_t PROGRAM_START = Constants::MEMORY_PROGRAM_START_LOCATION;
+// somewhere well away from the program, for opcodes that read or write memory at I
+const uint16_t DATA_ADDRESS = 0x800;
+
+class CpuBenchmarkSetup {
+   public:
+    Memory memory;
+    HeadlessDisplay display;
+    ScriptedInputController inputController;
+    Cpu cpu{memory, display, inputController};
+
+    CpuBenchmarkSetup() {
+        uint8_t zeros[Memory::NUM_BYTES_OF_MEMORY] = {};
+        memory.copyFrom(zeros);
+        CpuState state = cpu.getState();
+        for (int i = 0; i < Cpu::NUM_GENERAL_PURPOSE_REGISTERS; i++) {
+            state.registers[i] = (uint8_t)(0x11 * i);
+        }
+        state.indexRegister = DATA_ADDRESS;
+        cpu.setState(state);
+        cpu.setRandomSeed(1);
+        inputController.setKeyPressed(0x5, true);
+    }
+};
+
+static void BM_ExecuteOpcode(benchmark::State &state, uint16_t opcode) {
+    CpuBenchmarkSetup setup;
+    for (auto _ : state) {
+        setup.cpu.executeOpcodeAt(PROGRAM_START, opcode);
+    }
+    benchmark::DoNotOptimize(setup.cpu.getProgramCounter());
+}
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 00E0_clear_screen, 0x00E0);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 1NNN_jump, 0x1200);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 3XNN_skip_if_equal, 0x3111);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 4XNN_skip_if_not_equal, 0x4111);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 5XY0_skip_if_registers_equal, 0x5120);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 6XNN_assign, 0x6142);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 7XNN_add, 0x7101);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 8XY0_set, 0x8120);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 8XY1_or, 0x8121);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 8XY2_and, 0x8122);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 8XY3_xor, 0x8123);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 8XY4_add, 0x8124);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 8XY5_subtract, 0x8125);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 8XY6_shift_right, 0x8126);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 8XY7_subtract_difference, 0x8127);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 8XYE_shift_left, 0x812E);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, 9XY0_skip_if_registers_not_equal, 0x9120);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, ANNN_assign_index, 0xA800);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, BNNN_jump_plus_v0, 0xB200);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, CXNN_random, 0xC1FF);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, EX9E_skip_if_key_pressed, 0xE59E);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, EXA1_skip_if_key_not_pressed, 0xE5A1);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, FX07_read_delay_timer, 0xF107);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, FX0A_wait_for_held_key, 0xF10A);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, FX15_set_delay_timer, 0xF115);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, FX18_set_sound_timer, 0xF118);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, FX29_font_character, 0xF129);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, FX33_bcd, 0xFE33);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, FX55_dump_all_registers, 0xFF55);
+BENCHMARK_CAPTURE(BM_ExecuteOpcode, FX65_load_all_registers, 0xFE65);
+
+static void BM_DecodeOnly(benchmark::State &state) {
+    CpuBenchmarkSetup setup;
+    // V0 is 0, so 0x4000 (skip if V0 != 0) never skips and does no work beyond being decoded
+    for (auto _ : state) {
+        setup.cpu.executeOpcodeAt(PROGRAM_START, 0x4000);
+    }
+}
+BENCHMARK(BM_DecodeOnly);
+
+// FX1E changes I every time, so it is undone each iteration to keep I near the data instead of wrapping around memory
+static void BM_ExecuteOpcode_FX1E_add_to_index(benchmark::State &state) {
+    CpuBenchmarkSetup setup;
+    for (auto _ : state) {
+        setup.cpu.executeOpcodeAt(PROGRAM_START, 0xF11E);
+        setup.cpu.executeOpcodeAt(PROGRAM_START, 0xA800);
+    }
+}
+BENCHMARK(BM_ExecuteOpcode_FX1E_add_to_index);
+
+// 00EE needs something to return from, so calls and returns are measured in pairs
+static void BM_ExecuteOpcode_2NNN_00EE_call_and_return(benchmark::State &state) {
+    CpuBenchmarkSetup setup;
+    for (auto _ : state) {
+        setup.cpu.executeOpcodeAt(PROGRAM_START, 0x2300);
+        setup.cpu.executeOpcodeAt(0x300, 0x00EE);
+    }
+}
+BENCHMARK(BM_ExecuteOpcode_2NNN_00EE_call_and_return);
+
+/**
+ * DXYN with args {sprite height, x, y}: byte aligned, unaligned (so each sprite row straddles two bytes of the screen), and clipped at the
+ * bottom right corner
+ */
+static void BM_DrawSprite(benchmark::State &state) {
+    CpuBenchmarkSetup setup;
+    CpuState cpuState = setup.cpu.getState();
+    cpuState.registers[0x1] = (uint8_t)state.range(1);
+    cpuState.registers[0x2] = (uint8_t)state.range(2);
+    setup.cpu.setState(cpuState);
+    for (unsigned int address = DATA_ADDRESS; address < DATA_ADDRESS + 15; address++) {
+        setup.memory.setDataAtAddress(address, 0xA5);
+    }
+    uint16_t opcode = (uint16_t)(0xD120 | state.range(0));
+    for (auto _ : state) {
+        setup.cpu.executeOpcodeAt(PROGRAM_START, opcode);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DrawSprite)
+    ->ArgNames({"height", "x", "y"})
+    ->Args({1, 0, 0})
+    ->Args({5, 0, 0})
+    ->Args({15, 0, 0})
+    ->Args({1, 3, 7})
+    ->Args({5, 3, 7})
+    ->Args({15, 3, 7})
+    ->Args({15, 60, 28});
+
+// the whole cycle: fetching, decoding, ticking the timers and executing (here, an add)
+static void BM_EmulateCycle(benchmark::State &state) {
+    CpuBenchmarkSetup setup;
+    setup.memory.setDataAtAddress(PROGRAM_START, 0x71);
+    setup.memory.setDataAtAddress(PROGRAM_START + 1, 0x01);
+    setup.memory.setDataAtAddress(PROGRAM_START + 2, 0x12);
+    setup.memory.setDataAtAddress(PROGRAM_START + 3, 0x00);
+    for (auto _ : state) {
+        setup.cpu.emulateCycle();
+    }
+}
+BENCHMARK(BM_EmulateCycle);
+
+// fetching on its own: isNextInstructionWaitForKeyPress() is a fetch followed by one comparison
+static void BM_FetchOpcode(benchmark::State &state) {
+    CpuBenchmarkSetup setup;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(setup.cpu.isNextInstructionWaitForKeyPress());
+    }
+}
+BENCHMARK(BM_FetchOpcode);
+
+static void BM_MemoryRead(benchmark::State &state) {
+    CpuBenchmarkSetup setup;
+    unsigned int address = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(setup.memory.getDataAtAddress(address));
+        address = (address + 1) & (Memory::NUM_BYTES_OF_MEMORY - 1);
+    }
+}
+BENCHMARK(BM_MemoryRead);
+
+static void BM_MemoryWrite(benchmark::State &state) {
+    CpuBenchmarkSetup setup;
+    unsigned int address = 0;
+    for (auto _ : state) {
+        setup.memory.setDataAtAddress(address, (uint8_t)address);
+        address = (address + 1) & (Memory::NUM_BYTES_OF_MEMORY - 1);
+    }
+    benchmark::ClobberMemory();
+}
+BENCHMARK(BM_MemoryWrite);
+
+static void BM_MemoryCopy(benchmark::State &state) {
+    CpuBenchmarkSetup setup;
+    uint8_t bytes[Memory::NUM_BYTES_OF_MEMORY];
+    for (auto _ : state) {
+        setup.memory.copyTo(bytes);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * Memory::NUM_BYTES_OF_MEMORY);
+}
+BENCHMARK(BM_MemoryCopy);
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include "../../src/subsystems/display/HeadlessDisplay.h"
+#include "../../src/subsystems/input/CycleInputController.h"
+#include "../../src/subsystems/input/KeyEvent.h"
+#include "../../src/subsystems/input/KeyMap.h"
+#include "../../src/subsystems/input/ScriptedInputController.h"
+#include "../../src/utils/SpscRingBuffer.h"
+
+using namespace Chip8;
+
+/**
+ * Microbenchmarks of the subsystem calls the cpu and the emulation loop make.
+ * The SDL Display and InputController can't be created without a window, so these measure the parts of them that don't need one: the
+ * FrameBuffer they draw into (through HeadlessDisplay, which is a thin wrapper around it), and the key mapping and event queues that
+ * carry a key event from the UI thread to the cycle it lands at.
+ */
+
+static void BM_DisplaySetPixel(benchmark::State &state) {
+    HeadlessDisplay display;
+    int x = 0;
+    int y = 0;
+    for (auto _ : state) {
+        display.setPixel(x, y, !display.getPixel(x, y));
+        x = (x + 1) & (FrameBuffer::LOW_RESOLUTION_WIDTH - 1);
+        y = (y + (x == 0)) & (FrameBuffer::LOW_RESOLUTION_HEIGHT - 1);
+    }
+    benchmark::DoNotOptimize(display.getFrameBuffer().rows[0]);
+}
+BENCHMARK(BM_DisplaySetPixel);
+
+static void BM_DisplayClearScreen(benchmark::State &state) {
+    HeadlessDisplay display;
+    for (auto _ : state) {
+        display.clearScreen();
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_DisplayClearScreen);
+
+// what a SUPER-CHIP game pays to scroll the high resolution screen (0x00C1, 0x00FB and 0x00FC)
+static void BM_DisplayScrollHighResolution(benchmark::State &state) {
+    HeadlessDisplay display;
+    display.setHighResolution(true);
+    for (auto _ : state) {
+        display.scrollDown(1);
+        display.scrollRight(4);
+        display.scrollLeft(4);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_DisplayScrollHighResolution);
+
+static void BM_DisplayCopyFrameBuffer(benchmark::State &state) {
+    HeadlessDisplay display;
+    FrameBuffer frameBuffer;
+    for (auto _ : state) {
+        display.copyFrameBufferTo(frameBuffer);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_DisplayCopyFrameBuffer);
+
+// what InputController does with each key event: map the keycode to a chip-8 key, then update the shared key mask
+static void BM_InputKeyEventMapping(benchmark::State &state) {
+    KeyMap keyMap;
+    const char keycodes[] = "1234qwerasdfzxcv";
+    for (unsigned int keyNumber = 0; keyNumber < IInputController::NUM_KEYS; keyNumber++) {
+        keyMap.setMapping(keycodes[keyNumber], keyNumber);
+    }
+    std::atomic<uint16_t> pressedKeys{0};
+    unsigned int i = 0;
+    for (auto _ : state) {
+        int keyNumber = keyMap.getKeyNumber(keycodes[i & 0xF]);
+        if (keyNumber != KeyMap::NO_KEY) {
+            pressedKeys.fetch_xor((uint16_t)(1 << keyNumber), std::memory_order_relaxed);
+        }
+        i++;
+    }
+    benchmark::DoNotOptimize(pressedKeys.load());
+}
+BENCHMARK(BM_InputKeyEventMapping);
+
+// handing a key event from the UI thread to the emulation thread
+static void BM_InputKeyEventQueue(benchmark::State &state) {
+    SpscRingBuffer<TimedKeyEvent, 256> keyEvents;
+    TimedKeyEvent event{0, 0x5, true};
+    for (auto _ : state) {
+        keyEvents.tryPush(event);
+        keyEvents.tryPop(event);
+        event.hostTimeNanos++;
+    }
+    benchmark::DoNotOptimize(event);
+}
+BENCHMARK(BM_InputKeyEventQueue);
+
+// scheduling a key event at a cycle, then applying it when that cycle comes, as the emulation loop does
+static void BM_InputScheduleAndApplyKeyEvent(benchmark::State &state) {
+    ScriptedInputController hostInputController;
+    CycleInputController inputController(hostInputController);
+    uint64_t cycleNumber = 0;
+    bool isPressed = true;
+    for (auto _ : state) {
+        inputController.scheduleEvent({cycleNumber, 0x5, isPressed});
+        inputController.applyEventsUpTo(cycleNumber);
+        cycleNumber++;
+        isPressed = !isPressed;
+    }
+    benchmark::DoNotOptimize(inputController.getPressedKeys());
+}
+BENCHMARK(BM_InputScheduleAndApplyKeyEvent);
+
+// what the cpu pays for EX9E and EXA1 when no event is due
+static void BM_InputIsKeyPressed(benchmark::State &state) {
+    ScriptedInputController hostInputController;
+    CycleInputController inputController(hostInputController);
+    unsigned int keyNumber = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(inputController.isKeyPressed(keyNumber));
+        keyNumber = (keyNumber + 1) & 0xF;
+    }
+}
+BENCHMARK(BM_InputIsKeyPressed);
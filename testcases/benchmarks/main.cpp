@@ -0,0 +1,28 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+/**
+ * Runs every microbenchmark. Results are printed as JSON unless another --benchmark_format is given, so runs can be saved and compared
+ * over time (ex: with compare.py from Google Benchmark's tools). Every other Google Benchmark flag works as usual
+ * (ex: --benchmark_filter=DrawSprite, --benchmark_out=results.json).
+ */
+int main(int argc, char **argv) {
+    const char *JSON_FORMAT_OPTION = "--benchmark_format=json";
+    std::vector<char *> args(argv, argv + argc);
+    bool isFormatGiven = false;
+    for (char *arg : args) {
+        isFormatGiven = isFormatGiven || std::strncmp(arg, "--benchmark_format=", std::strlen("--benchmark_format=")) == 0;
+    }
+    if (!isFormatGiven) {
+        args.push_back(const_cast<char *>(JSON_FORMAT_OPTION));
+    }
+    int numArgs = (int)args.size();
+    benchmark::Initialize(&numArgs, args.data());
+    if (benchmark::ReportUnrecognizedArguments(numArgs, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
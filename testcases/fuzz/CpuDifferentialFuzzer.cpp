@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../src/constants/Constants.h"
+#include "../../src/cpu/Cpu.h"
+#include "../../src/exceptions/BaseException.h"
+#include "../../src/storage/Memory.h"
+#include "../../src/subsystems/display/HeadlessDisplay.h"
+#include "../../src/subsystems/input/ScriptedInputController.h"
+#include "../../src/utils/OptionUtil.h"
+#include "../../src/utils/RandomUtil.h"
+#include "ReferenceCpu.h"
+
+using namespace Chip8;
+
+/**
+ * A differential fuzzer: it runs the same program from the same starting state through the production Cpu and through ReferenceCpu,
+ * and stops the process as soon as the registers, flag registers, stack, memory or screen of the two differ after a step, or only one
+ * of them faults.
+ *
+ * An input is a header holding the starting state, followed by the program, which is loaded at 0x200:
+ *   16 registers, the index register (2 bytes, big endian), the delay and sound timers, the held keys (2 bytes, one bit per key) and
+ *   the random seed (4 bytes)
+ *
+ * Built with -DCHIP8_LIBFUZZER and -fsanitize=fuzzer, this is a libFuzzer target. Otherwise it has its own driver:
+ *   cpu_fuzz [num_inputs] [seed]    runs randomly generated programs (mostly valid opcodes, so runs get past the first few steps)
+ *   cpu_fuzz <input_file>...        reruns inputs (ex: a crash reproducer saved by libFuzzer)
+ */
+
+const size_t NUM_HEADER_BYTES = 26;
+const size_t MAX_PROGRAM_SIZE = Memory::NUM_BYTES_OF_MEMORY - Constants::MEMORY_PROGRAM_START_LOCATION;
+const int MAX_STEPS = 1000;
+
+uint16_t readBigEndian16(const uint8_t *data) { return (uint16_t)(data[0] << 8 | data[1]); }
+
+[[noreturn]] void reportDifference(int stepNumber, uint16_t address, const std::string &difference) {
+    std::cerr << "Cpu and ReferenceCpu differ after step " << stepNumber << " (the instruction at 0x" << std::hex << address << std::dec
+              << "): " << difference << std::endl;
+    std::abort();
+}
+
+std::string findDifference(Cpu &cpu, const Memory &memory, const HeadlessDisplay &display, const ReferenceCpu &reference) {
+    CpuState state = cpu.getState();
+    std::ostringstream difference;
+    for (int i = 0; i < Cpu::NUM_GENERAL_PURPOSE_REGISTERS; i++) {
+        if (state.registers[i] != reference.registers[i]) {
+            difference << "V" << std::hex << i << " is " << (int)state.registers[i] << " instead of " << (int)reference.registers[i];
+            return difference.str();
+        }
+    }
+    if (state.indexRegister != reference.indexRegister || state.programCounter != reference.programCounter ||
+        state.delayTimer != reference.delayTimer || state.soundTimer != reference.soundTimer ||
+        state.randomNumberState != reference.randomNumberState) {
+        difference << std::hex << "I=" << state.indexRegister << " PC=" << state.programCounter << " DT=" << (int)state.delayTimer
+                   << " ST=" << (int)state.soundTimer << " RNG=" << state.randomNumberState << " instead of I=" << reference.indexRegister
+                   << " PC=" << reference.programCounter << " DT=" << (int)reference.delayTimer << " ST=" << (int)reference.soundTimer
+                   << " RNG=" << reference.randomNumberState;
+        return difference.str();
+    }
+    if (state.stackLevel != reference.stackLevel ||
+        !std::equal(state.stack, state.stack + state.stackLevel, reference.stack)) {
+        return "the stack differs";
+    }
+    if (!std::equal(state.flagRegisters, state.flagRegisters + Cpu::NUM_FLAG_REGISTERS, reference.flagRegisters)) {
+        return "the flag registers differ";
+    }
+    uint8_t memoryBytes[Memory::NUM_BYTES_OF_MEMORY];
+    memory.copyTo(memoryBytes);
+    for (int address = 0; address < Memory::NUM_BYTES_OF_MEMORY; address++) {
+        if (memoryBytes[address] != reference.memory[address]) {
+            difference << "memory at 0x" << std::hex << address << " is " << (int)memoryBytes[address] << " instead of "
+                       << (int)reference.memory[address];
+            return difference.str();
+        }
+    }
+    const FrameBuffer &frameBuffer = display.getFrameBuffer();
+    if (frameBuffer.isHighResolution != reference.isHighResolution) {
+        return "the screen resolution differs";
+    }
+    for (int y = 0; y < FrameBuffer::MAX_HEIGHT; y++) {
+        for (int x = 0; x < FrameBuffer::MAX_WIDTH; x++) {
+            if (frameBuffer.getPixel(x, y) != reference.pixels[y][x]) {
+                difference << "the pixel at (" << x << ", " << y << ") differs";
+                return difference.str();
+            }
+        }
+    }
+    if (cpu.getNumScreenUpdates() != reference.numScreenUpdates) {
+        return "the number of screen updates differs";
+    }
+    return "";
+}
+
+void runInput(const uint8_t *data, size_t size) {
+    if (size < NUM_HEADER_BYTES + 2) {
+        return;
+    }
+    const uint8_t *program = data + NUM_HEADER_BYTES;
+    size_t programSize = std::min(size - NUM_HEADER_BYTES, MAX_PROGRAM_SIZE);
+
+    ReferenceCpu reference;
+    std::copy(program, program + programSize, reference.memory + Constants::MEMORY_PROGRAM_START_LOCATION);
+    std::copy(data, data + Cpu::NUM_GENERAL_PURPOSE_REGISTERS, reference.registers);
+    reference.indexRegister = readBigEndian16(data + 16) & Constants::MAX_INDEX_REGISTER_VALUE;
+    reference.delayTimer = data[18];
+    reference.soundTimer = data[19];
+    uint16_t heldKeys = readBigEndian16(data + 20);
+    uint32_t seed = (uint32_t)data[22] << 24 | (uint32_t)data[23] << 16 | (uint32_t)data[24] << 8 | data[25];
+    reference.randomNumberState = RandomUtil::getInitialState(seed);
+
+    Memory memory;
+    memory.copyFrom(reference.memory);
+    HeadlessDisplay display;
+    ScriptedInputController inputController;
+    for (int key = 0; key < ReferenceCpu::NUM_KEYS; key++) {
+        reference.keys[key] = ((heldKeys >> key) & 1) != 0;
+        inputController.setKeyPressed(key, reference.keys[key]);
+    }
+    Cpu cpu(memory, display, inputController);
+    CpuState state = cpu.getState();
+    std::copy(reference.registers, reference.registers + Cpu::NUM_GENERAL_PURPOSE_REGISTERS, state.registers);
+    state.indexRegister = reference.indexRegister;
+    state.delayTimer = reference.delayTimer;
+    state.soundTimer = reference.soundTimer;
+    state.randomNumberState = reference.randomNumberState;
+    cpu.setState(state);
+
+    for (int stepNumber = 1; stepNumber <= MAX_STEPS; stepNumber++) {
+        uint16_t address = reference.programCounter;
+        bool isCpuFaulted = false;
+        try {
+            cpu.emulateCycle();
+        } catch (const BaseException &) {
+            isCpuFaulted = true;
+        }
+        bool isReferenceFaulted = !reference.step();
+        if (isCpuFaulted != isReferenceFaulted) {
+            reportDifference(stepNumber, address, isCpuFaulted ? "only the Cpu faulted" : "only ReferenceCpu faulted");
+        }
+        if (isCpuFaulted) {
+            return;
+        }
+        std::string difference = findDifference(cpu, memory, display, reference);
+        if (!difference.empty()) {
+            reportDifference(stepNumber, address, difference);
+        }
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    runInput(data, size);
+    return 0;
+}
+
+#ifndef CHIP8_LIBFUZZER
+const uint64_t DEFAULT_NUM_INPUTS = 20000;
+const size_t MAX_GENERATED_INSTRUCTIONS = 256;
+
+/**
+ * @return an opcode that is valid most of the time. Operands are random, and small addresses near the program are preferred so jumps and
+ * calls land on the generated code
+ */
+uint16_t generateOpcode(std::mt19937 &random) {
+    static const uint16_t TEMPLATES[] = {0x00E0, 0x00EE, 0x00C0, 0x00FB, 0x00FC, 0x00FE, 0x00FF, 0x1000, 0x2000, 0x3000, 0x4000,
+                                         0x5000, 0x6000, 0x7000, 0x8000, 0x8001, 0x8002, 0x8003, 0x8004, 0x8005, 0x8006, 0x8007,
+                                         0x800E, 0x9000, 0xA000, 0xB000, 0xC000, 0xD000, 0xE09E, 0xE0A1, 0xF007, 0xF00A, 0xF015,
+                                         0xF018, 0xF01E, 0xF029, 0xF030, 0xF033, 0xF055, 0xF065, 0xF075, 0xF085};
+    const size_t NUM_TEMPLATES = sizeof(TEMPLATES) / sizeof(TEMPLATES[0]);
+    uint16_t operands = (uint16_t)random();
+    if (random() % 32 == 0) {
+        return operands;
+    }
+    uint16_t opcode = TEMPLATES[random() % NUM_TEMPLATES];
+    switch (opcode >> 12) {
+        case 0x0:
+            return opcode == 0x00C0 ? opcode | (operands & 0x000F) : opcode;
+        case 0x1:
+        case 0x2:
+        case 0xB:
+            return opcode | (Constants::MEMORY_PROGRAM_START_LOCATION + (operands % MAX_GENERATED_INSTRUCTIONS) * 2);
+        case 0x3:
+        case 0x4:
+        case 0x6:
+        case 0x7:
+        case 0xA:
+        case 0xC:
+        case 0xD:
+            return opcode | (operands & 0x0FFF);
+        case 0x5:
+        case 0x8:
+        case 0x9:
+            return opcode | (operands & 0x0FF0);
+        default:
+            return opcode | (operands & 0x0F00);
+    }
+}
+
+std::vector<uint8_t> generateInput(std::mt19937 &random) {
+    std::vector<uint8_t> input(NUM_HEADER_BYTES);
+    for (uint8_t &byte : input) {
+        byte = (uint8_t)random();
+    }
+    size_t numInstructions = 1 + random() % MAX_GENERATED_INSTRUCTIONS;
+    for (size_t i = 0; i < numInstructions; i++) {
+        uint16_t opcode = generateOpcode(random);
+        input.push_back((uint8_t)(opcode >> 8));
+        input.push_back((uint8_t)opcode);
+    }
+    return input;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && !std::isdigit(argv[1][0])) {
+        for (int i = 1; i < argc; i++) {
+            std::ifstream inputFile(argv[i], std::ios::binary);
+            if (!inputFile.is_open()) {
+                std::cout << "Unable to open " << argv[i] << std::endl;
+                return 1;
+            }
+            std::vector<uint8_t> input((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+            runInput(input.data(), input.size());
+        }
+        std::cout << "Cpu and ReferenceCpu agree on " << argc - 1 << " inputs" << std::endl;
+        return 0;
+    }
+    uint64_t numInputs = DEFAULT_NUM_INPUTS;
+    uint32_t seed = std::random_device()();
+    if (argc > 3 || (argc > 1 && !OptionUtil::parseNumber(argv[1], 0, UINT64_MAX, numInputs)) ||
+        (argc > 2 && !OptionUtil::parseNumber(argv[2], 0, UINT32_MAX, seed))) {
+        std::cout << "Incorrect usage. Expected: cpu_fuzz [num_inputs] [seed]\n"
+                  << "                           cpu_fuzz <input_file>..." << std::endl;
+        return 1;
+    }
+    std::cout << "Fuzzing with seed " << seed << std::endl;
+    std::mt19937 random(seed);
+    for (uint64_t i = 0; i < numInputs; i++) {
+        std::vector<uint8_t> input = generateInput(random);
+        runInput(input.data(), input.size());
+    }
+    std::cout << "Cpu and ReferenceCpu agree on " << numInputs << " generated programs" << std::endl;
+    return 0;
+}
+#endif
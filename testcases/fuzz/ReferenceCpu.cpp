@@ -0,0 +1,303 @@
+#include "ReferenceCpu.h"
+#include "../../src/utils/RandomUtil.h"
+
+const uint16_t FONT_START_ADDRESS = 0x050;
+const uint16_t FONT_BYTES_PER_CHARACTER = 5;
+const uint16_t BIG_FONT_START_ADDRESS = 0x0A0;
+const uint16_t BIG_FONT_BYTES_PER_CHARACTER = 10;
+
+bool ReferenceCpu::read(unsigned int address, uint8_t &data) const {
+    if (address >= NUM_BYTES_OF_MEMORY) {
+        return false;
+    }
+    data = memory[address];
+    return true;
+}
+
+bool ReferenceCpu::write(unsigned int address, uint8_t data) {
+    if (address >= NUM_BYTES_OF_MEMORY) {
+        return false;
+    }
+    memory[address] = data;
+    return true;
+}
+
+void ReferenceCpu::clearScreen() {
+    for (int row = 0; row < SCREEN_HEIGHT; row++) {
+        for (int column = 0; column < SCREEN_WIDTH; column++) {
+            pixels[row][column] = false;
+        }
+    }
+}
+
+bool ReferenceCpu::step() {
+    uint8_t high, low;
+    if (!read(programCounter, high) || !read(programCounter + 1, low)) {
+        return false;
+    }
+    uint16_t opcode = (uint16_t)(high << 8 | low);
+    int x = (opcode >> 8) & 0xF;
+    int y = (opcode >> 4) & 0xF;
+    int n = opcode & 0xF;
+    uint8_t nn = opcode & 0xFF;
+    uint16_t nnn = opcode & 0xFFF;
+    uint8_t *v = registers;
+    int width = isHighResolution ? SCREEN_WIDTH : SCREEN_WIDTH / 2;
+    int height = isHighResolution ? SCREEN_HEIGHT : SCREEN_HEIGHT / 2;
+
+    // the timers count down once per instruction, before it executes
+    if (delayTimer > 0) {
+        delayTimer--;
+    }
+    if (soundTimer > 0) {
+        soundTimer--;
+    }
+    programCounter += 2;
+
+    // Like the Cpu, VF is written before the result of 8XY4, 8XY5, 8XY6, 8XY7, 8XYE and FX1E, so when X or Y is F the result is computed
+    // from the flag. 5XYN and 9XYN ignore N, and BNNN may jump past the end of memory (which faults on the next fetch).
+    // The SUPER-CHIP's scrolls move pixels of the current resolution, and DXY0 draws a 16x16 sprite in either resolution.
+    switch (opcode >> 12) {
+        case 0x0:
+            if (opcode == 0x00E0) {
+                clearScreen();
+                numScreenUpdates++;
+            } else if ((opcode & 0xFFF0) == 0x00C0) {
+                for (int row = height - 1; row >= 0; row--) {
+                    for (int column = 0; column < width; column++) {
+                        pixels[row][column] = row >= n && pixels[row - n][column];
+                    }
+                }
+                numScreenUpdates++;
+            } else if (opcode == 0x00FB) {
+                for (int row = 0; row < height; row++) {
+                    for (int column = width - 1; column >= 0; column--) {
+                        pixels[row][column] = column >= 4 && pixels[row][column - 4];
+                    }
+                }
+                numScreenUpdates++;
+            } else if (opcode == 0x00FC) {
+                for (int row = 0; row < height; row++) {
+                    for (int column = 0; column < width; column++) {
+                        pixels[row][column] = column + 4 < width && pixels[row][column + 4];
+                    }
+                }
+                numScreenUpdates++;
+            } else if (opcode == 0x00FE || opcode == 0x00FF) {
+                isHighResolution = opcode == 0x00FF;
+                clearScreen();
+                numScreenUpdates++;
+            } else if (opcode == 0x00EE) {
+                if (stackLevel == 0) {
+                    return false;
+                }
+                stackLevel--;
+                programCounter = stack[stackLevel] + 2;
+            } else {
+                return false;
+            }
+            break;
+        case 0x1:
+            programCounter = nnn;
+            break;
+        case 0x2:
+            if (stackLevel == NUM_STACK_LEVELS) {
+                return false;
+            }
+            stack[stackLevel] = programCounter - 2;
+            stackLevel++;
+            programCounter = nnn;
+            break;
+        case 0x3:
+            if (v[x] == nn) {
+                programCounter += 2;
+            }
+            break;
+        case 0x4:
+            if (v[x] != nn) {
+                programCounter += 2;
+            }
+            break;
+        case 0x5:
+            if (v[x] == v[y]) {
+                programCounter += 2;
+            }
+            break;
+        case 0x6:
+            v[x] = nn;
+            break;
+        case 0x7:
+            v[x] += nn;
+            break;
+        case 0x8:
+            switch (n) {
+                case 0x0:
+                    v[x] = v[y];
+                    break;
+                case 0x1:
+                    v[x] |= v[y];
+                    break;
+                case 0x2:
+                    v[x] &= v[y];
+                    break;
+                case 0x3:
+                    v[x] ^= v[y];
+                    break;
+                case 0x4:
+                    v[0xF] = v[x] + v[y] > 0xFF ? 1 : 0;
+                    v[x] += v[y];
+                    break;
+                case 0x5:
+                    v[0xF] = v[x] >= v[y] ? 1 : 0;
+                    v[x] -= v[y];
+                    break;
+                case 0x6:
+                    v[0xF] = v[x] & 1;
+                    v[x] >>= 1;
+                    break;
+                case 0x7:
+                    v[0xF] = v[y] >= v[x] ? 1 : 0;
+                    v[x] = v[y] - v[x];
+                    break;
+                case 0xE:
+                    v[0xF] = v[x] >> 7;
+                    v[x] <<= 1;
+                    break;
+                default:
+                    return false;
+            }
+            break;
+        case 0x9:
+            if (v[x] != v[y]) {
+                programCounter += 2;
+            }
+            break;
+        case 0xA:
+            indexRegister = nnn;
+            break;
+        case 0xB:
+            programCounter = nnn + v[0];
+            break;
+        case 0xC:
+            v[x] = nn & Chip8::RandomUtil::getRandomNumber(randomNumberState);
+            break;
+        case 0xD: {
+            // sprites are clipped at the edges of the screen, not wrapped
+            int left = v[x];
+            int top = v[y];
+            int spriteSize = n == 0 ? 16 : n;
+            int spriteWidth = n == 0 ? 16 : 8;
+            v[0xF] = 0;
+            for (int row = 0; row < spriteSize; row++) {
+                uint8_t spriteRowLeft;
+                uint8_t spriteRowRight = 0;
+                if (spriteWidth == 16) {
+                    if (!read(indexRegister + row * 2, spriteRowLeft) || !read(indexRegister + row * 2 + 1, spriteRowRight)) {
+                        return false;
+                    }
+                } else if (!read(indexRegister + row, spriteRowLeft)) {
+                    return false;
+                }
+                for (int column = 0; column < spriteWidth; column++) {
+                    int screenX = left + column;
+                    int screenY = top + row;
+                    bool isSpritePixelSet = column < 8 ? (spriteRowLeft >> (7 - column)) & 1 : (spriteRowRight >> (15 - column)) & 1;
+                    if (isSpritePixelSet && screenX < width && screenY < height) {
+                        if (pixels[screenY][screenX]) {
+                            v[0xF] = 1;
+                        }
+                        pixels[screenY][screenX] = !pixels[screenY][screenX];
+                    }
+                }
+            }
+            numScreenUpdates++;
+            break;
+        }
+        case 0xE: {
+            bool isPressed = v[x] < NUM_KEYS && keys[v[x]];
+            if (nn == 0x9E) {
+                if (isPressed) {
+                    programCounter += 2;
+                }
+            } else if (nn == 0xA1) {
+                if (!isPressed) {
+                    programCounter += 2;
+                }
+            } else {
+                return false;
+            }
+            break;
+        }
+        case 0xF:
+            switch (nn) {
+                case 0x07:
+                    v[x] = delayTimer;
+                    break;
+                case 0x0A: {
+                    // there is nobody to wait for: the lowest held key is taken, or 0 if no key is held
+                    uint8_t key = 0;
+                    while (key < NUM_KEYS && !keys[key]) {
+                        key++;
+                    }
+                    v[x] = key < NUM_KEYS ? key : 0;
+                    break;
+                }
+                case 0x15:
+                    delayTimer = v[x];
+                    break;
+                case 0x18:
+                    soundTimer = v[x];
+                    break;
+                case 0x1E:
+                    v[0xF] = indexRegister + v[x] > 0xFFF ? 1 : 0;
+                    indexRegister = (indexRegister + v[x]) & 0xFFF;
+                    break;
+                case 0x29:
+                    indexRegister = FONT_START_ADDRESS + v[x] * FONT_BYTES_PER_CHARACTER;
+                    break;
+                case 0x30:
+                    indexRegister = BIG_FONT_START_ADDRESS + v[x] * BIG_FONT_BYTES_PER_CHARACTER;
+                    break;
+                case 0x33:
+                    if (!write(indexRegister + 2, v[x] % 10) || !write(indexRegister + 1, v[x] / 10 % 10) ||
+                        !write(indexRegister, v[x] / 100)) {
+                        return false;
+                    }
+                    break;
+                case 0x55:
+                    for (int i = 0; i <= x; i++) {
+                        if (!write(indexRegister + i, v[i])) {
+                            return false;
+                        }
+                    }
+                    break;
+                case 0x65:
+                    for (int i = 0; i <= x; i++) {
+                        if (!read(indexRegister + i, v[i])) {
+                            return false;
+                        }
+                    }
+                    break;
+                case 0x75:
+                    if (x >= NUM_FLAG_REGISTERS) {
+                        return false;
+                    }
+                    for (int i = 0; i <= x; i++) {
+                        flagRegisters[i] = v[i];
+                    }
+                    break;
+                case 0x85:
+                    if (x >= NUM_FLAG_REGISTERS) {
+                        return false;
+                    }
+                    for (int i = 0; i <= x; i++) {
+                        v[i] = flagRegisters[i];
+                    }
+                    break;
+                default:
+                    return false;
+            }
+            break;
+    }
+    return true;
+}
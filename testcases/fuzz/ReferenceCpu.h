@@ -0,0 +1,53 @@
+#ifndef CHIP_8_REFERENCECPU_H
+#define CHIP_8_REFERENCECPU_H
+
+#include <cstdint>
+
+/**
+ * A deliberately plain chip-8 interpreter that the differential fuzzer compares the production Cpu against.
+ * It is written for obviousness, not speed: one switch over the opcode, a bool per pixel, and no shared code with the Cpu except the
+ * random number generator (whose numbers are part of the state being compared).
+ * It follows the same quirks the Cpu documents, so any difference the fuzzer finds is a bug in one of the two.
+ */
+class ReferenceCpu {
+   public:
+    static const int NUM_BYTES_OF_MEMORY = 4096;
+    static const int NUM_REGISTERS = 16;
+    static const int NUM_STACK_LEVELS = 16;
+    static const int NUM_KEYS = 16;
+    static const int NUM_FLAG_REGISTERS = 8;
+    // the SUPER-CHIP's high resolution. The low resolution screen is the top left quarter of it
+    static const int SCREEN_WIDTH = 128;
+    static const int SCREEN_HEIGHT = 64;
+
+    uint8_t memory[NUM_BYTES_OF_MEMORY] = {};
+    uint8_t registers[NUM_REGISTERS] = {};
+    uint16_t indexRegister = 0;
+    uint16_t programCounter = 0x200;
+    uint8_t delayTimer = 0;
+    uint8_t soundTimer = 0;
+    uint16_t stack[NUM_STACK_LEVELS] = {};
+    int stackLevel = 0;
+    uint32_t randomNumberState = 0;
+    bool pixels[SCREEN_HEIGHT][SCREEN_WIDTH] = {};
+    bool isHighResolution = false;
+    uint8_t flagRegisters[NUM_FLAG_REGISTERS] = {};
+    bool keys[NUM_KEYS] = {};
+    unsigned long numScreenUpdates = 0;
+
+    /**
+     * Executes the instruction at the program counter.
+     * @return false if the instruction faulted (ex: an unknown opcode, a stack overflow, or an access past the end of memory), in which
+     * case the state is left wherever the fault happened and shouldn't be compared
+     */
+    bool step();
+
+   private:
+    bool read(unsigned int address, uint8_t &data) const;
+
+    void clearScreen();
+
+    bool write(unsigned int address, uint8_t data);
+};
+
+#endif  // CHIP_8_REFERENCECPU_H
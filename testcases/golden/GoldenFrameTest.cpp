@@ -0,0 +1,341 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../src/Chip8.h"
+#include "../../src/analysis/ControlFlowGraph.h"
+#include "../../src/exceptions/IOException.h"
+#include "../../src/recompiler/CppCodeGenerator.h"
+#include "../../src/recompiler/RecompiledProgram.h"
+#include "../../src/subsystems/HeadlessSubsystemManager.h"
+#include "../../src/utils/OptionUtil.h"
+
+using namespace Chip8;
+
+/**
+ * Whole-program regression tests: every ROM in a corpus is run headlessly for a number of frames with a scripted input, and the hashes
+ * of the screen and of the whole emulator state at regular checkpoints are compared against hashes stored when the ROM was known to run
+ * correctly (its "golden" frames). ROMs are run in parallel on every core, and each one has a time limit.
+ *
+ * Usage: golden_tests <corpus_file> [--update] [--time-limit=<seconds>] [--recompile=<directory>]
+ * --update stores the hashes of this run as the new golden hashes, after a change that is meant to change what ROMs do.
+ * --recompile also recompiles every ROM into the directory (as chip_8_recompile does), and checks that the recompiled program does the
+ * same as the interpreter.
+ */
+
+const std::string UPDATE_OPTION = "--update";
+const std::string TIME_LIMIT_OPTION = "--time-limit=";
+const std::string RECOMPILE_OPTION = "--recompile=";
+const double DEFAULT_TIME_LIMIT_SECONDS = 10;
+
+class GoldenCase {
+   public:
+    std::string name;
+    std::string romPath;
+    unsigned long numFrames;
+    unsigned long framesPerCheckpoint;
+    uint32_t randomSeed;
+    std::string inputScriptPath;
+    std::string goldenPath;
+};
+
+class Checkpoint {
+   public:
+    unsigned long frameNumber;
+    uint64_t frameBufferHash;
+    uint64_t stateHash;
+
+    bool operator==(const Checkpoint &other) const {
+        return frameNumber == other.frameNumber && frameBufferHash == other.frameBufferHash && stateHash == other.stateHash;
+    }
+};
+
+/**
+ * A cpu with its own memory, screen and input, so a program can be run twice side by side
+ */
+class StandaloneCpu {
+   public:
+    Memory memory;
+    HeadlessDisplay display;
+    ScriptedInputController inputController;
+    Cpu cpu{memory, display, inputController};
+
+    explicit StandaloneCpu(const EmulatorState &state) {
+        memory.copyFrom(state.memory);
+        cpu.setState(state.cpu);
+    }
+
+    uint64_t getStateHash() const {
+        EmulatorState state;
+        state.cpu = cpu.getState();
+        memory.copyTo(state.memory);
+        state.frameBuffer = display.getFrameBuffer();
+        return state.getHash();
+    }
+};
+
+class CaseResult {
+   public:
+    bool isPassed = false;
+    std::string message;
+    double numSeconds = 0;
+};
+
+std::string getDirectory(const std::string &path) {
+    size_t separatorIndex = path.find_last_of('/');
+    return separatorIndex == std::string::npos ? "" : path.substr(0, separatorIndex + 1);
+}
+
+std::vector<GoldenCase> parseCorpus(const std::string &corpusPath) {
+    std::ifstream corpus(corpusPath);
+    if (!corpus.is_open()) {
+        throw IOException("Unable to open the corpus " + corpusPath);
+    }
+    std::string directory = getDirectory(corpusPath);
+    std::vector<GoldenCase> cases;
+    std::string line;
+    while (std::getline(corpus, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream lineStream(line);
+        GoldenCase goldenCase;
+        if (!(lineStream >> goldenCase.name >> goldenCase.romPath >> goldenCase.numFrames >> goldenCase.framesPerCheckpoint >>
+              goldenCase.randomSeed) ||
+            goldenCase.framesPerCheckpoint == 0) {
+            throw IOException("Invalid corpus line: " + line);
+        }
+        goldenCase.romPath = directory + goldenCase.romPath;
+        if (lineStream >> goldenCase.inputScriptPath) {
+            goldenCase.inputScriptPath = directory + goldenCase.inputScriptPath;
+        }
+        goldenCase.goldenPath = directory + goldenCase.name + ".golden";
+        cases.push_back(goldenCase);
+    }
+    return cases;
+}
+
+std::vector<Checkpoint> readCheckpoints(const std::string &goldenPath) {
+    std::ifstream golden(goldenPath);
+    if (!golden.is_open()) {
+        throw IOException("No golden hashes at " + goldenPath + " (run with " + UPDATE_OPTION + " to create them)");
+    }
+    std::vector<Checkpoint> checkpoints;
+    Checkpoint checkpoint;
+    while (golden >> std::dec >> checkpoint.frameNumber >> std::hex >> checkpoint.frameBufferHash >> checkpoint.stateHash) {
+        checkpoints.push_back(checkpoint);
+    }
+    return checkpoints;
+}
+
+void writeCheckpoints(const std::string &goldenPath, const std::vector<Checkpoint> &checkpoints) {
+    std::ofstream golden(goldenPath);
+    for (const Checkpoint &checkpoint : checkpoints) {
+        golden << std::dec << checkpoint.frameNumber << std::hex << std::setfill('0') << " " << std::setw(16) << checkpoint.frameBufferHash
+               << " " << std::setw(16) << checkpoint.stateHash << "\n";
+    }
+    if (!golden) {
+        throw IOException("Unable to write the golden hashes to " + goldenPath);
+    }
+}
+
+/**
+ * Runs the case one frame at a time. Script events are keyed by frame, and a key wait with no key pressed idles until the frame a key
+ * is pressed in, the way it would with a person playing.
+ * @return the checkpoints that were reached before the time limit
+ */
+std::vector<Checkpoint> runCase(const GoldenCase &goldenCase, std::chrono::steady_clock::time_point deadline) {
+    std::vector<ScriptedKeyEvent> events;
+    if (!goldenCase.inputScriptPath.empty()) {
+        std::ifstream script(goldenCase.inputScriptPath);
+        if (!script.is_open()) {
+            throw IOException("Unable to open the input script " + goldenCase.inputScriptPath);
+        }
+        events = ScriptedInputController::parseScript(script);
+    }
+    HeadlessSubsystemManager subsystemManager{ScriptedInputController(events)};
+    ScriptedInputController &inputController = subsystemManager.getScriptedInputController();
+    Chip8Emulator emulator{subsystemManager};
+    emulator.loadGameFile(goldenCase.romPath);
+    emulator.setRandomSeed(goldenCase.randomSeed);
+
+    std::vector<Checkpoint> checkpoints;
+    for (unsigned long frameNumber = 1; frameNumber <= goldenCase.numFrames; frameNumber++) {
+        inputController.checkForKeyPresses();
+        if (!(emulator.getCpu().isNextInstructionWaitForKeyPress() && inputController.getPressedKeys() == 0)) {
+            emulator.runFrames(1, EmulationEvent::WAITING_FOR_KEY);
+        }
+        if (frameNumber % goldenCase.framesPerCheckpoint == 0) {
+            const FrameBuffer &frameBuffer = subsystemManager.getHeadlessDisplay().getFrameBuffer();
+            checkpoints.push_back({frameNumber, frameBuffer.getHash(), emulator.saveState().getHash()});
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            break;
+        }
+    }
+    return checkpoints;
+}
+
+/**
+ * Recompiles the case's ROM into directory, then runs the recompiled program and the interpreter side by side for as many cycles as
+ * the case's frames take, comparing the two after every recompiled block. No keys are pressed, so key waits get key 0 on both sides.
+ * @return where the two first differ, or an empty string if they never did
+ */
+std::string compareRecompiledCase(const GoldenCase &goldenCase, const std::string &directory,
+                                  std::chrono::steady_clock::time_point deadline) {
+    HeadlessSubsystemManager subsystemManager;
+    Chip8Emulator emulator{subsystemManager};
+    emulator.loadGameFile(goldenCase.romPath);
+    emulator.setRandomSeed(goldenCase.randomSeed);
+    EmulatorState powerOnState = emulator.saveState();
+
+    Memory memory;
+    memory.copyFrom(powerOnState.memory);
+    ControlFlowGraph controlFlowGraph(memory, Constants::MEMORY_PROGRAM_START_LOCATION);
+    std::string sourcePath = directory + "/" + goldenCase.name + ".recompiled.cpp";
+    std::string libraryPath = directory + "/" + goldenCase.name + ".recompiled.so";
+    std::ofstream sourceFile(sourcePath);
+    if (!sourceFile.is_open()) {
+        throw IOException("Unable to open " + sourcePath);
+    }
+    CppCodeGenerator(controlFlowGraph).generate(sourceFile, goldenCase.romPath);
+    sourceFile.close();
+    CppCodeGenerator::compileLibrary(sourcePath, libraryPath);
+    RecompiledProgram recompiledProgram(libraryPath);
+
+    StandaloneCpu interpreted(powerOnState);
+    StandaloneCpu recompiled(powerOnState);
+    RecompilerContext context(recompiled.cpu);
+    uint64_t numCycles = 0;
+    while (numCycles < (uint64_t)goldenCase.numFrames * Chip8Emulator::CYCLES_PER_FRAME) {
+        uint16_t blockAddress = recompiled.cpu.getProgramCounter();
+        unsigned int numBlockCycles = recompiledProgram.executeBlock(context);
+        if (numBlockCycles == 0) {
+            recompiled.cpu.emulateCycle();
+            numBlockCycles = 1;
+        }
+        for (unsigned int i = 0; i < numBlockCycles; i++) {
+            interpreted.cpu.emulateCycle();
+        }
+        numCycles += numBlockCycles;
+        if (recompiled.getStateHash() != interpreted.getStateHash()) {
+            std::ostringstream difference;
+            difference << "the recompiled program differs from the interpreter at cycle " << numCycles << ", after the block at 0x"
+                       << std::hex << blockAddress;
+            return difference.str();
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            return "the recompiled program timed out";
+        }
+    }
+    return "";
+}
+
+CaseResult checkCase(const GoldenCase &goldenCase, double timeLimitSeconds, bool isUpdating, const std::string &recompileDirectory) {
+    CaseResult result;
+    auto startTime = std::chrono::steady_clock::now();
+    auto deadline = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimitSeconds));
+    try {
+        std::vector<Checkpoint> checkpoints = runCase(goldenCase, deadline);
+        result.numSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        if (checkpoints.size() != goldenCase.numFrames / goldenCase.framesPerCheckpoint) {
+            result.message = "timed out after " + std::to_string(result.numSeconds) + " seconds";
+            return result;
+        }
+        if (isUpdating) {
+            writeCheckpoints(goldenCase.goldenPath, checkpoints);
+            result.isPassed = true;
+            result.message = "updated";
+            return result;
+        }
+        std::vector<Checkpoint> goldenCheckpoints = readCheckpoints(goldenCase.goldenPath);
+        if (goldenCheckpoints.size() != checkpoints.size()) {
+            result.message = "expected " + std::to_string(goldenCheckpoints.size()) + " checkpoints, but the corpus asks for " +
+                             std::to_string(checkpoints.size());
+            return result;
+        }
+        auto mismatch = std::mismatch(checkpoints.begin(), checkpoints.end(), goldenCheckpoints.begin());
+        if (mismatch.first != checkpoints.end()) {
+            bool isScreenDifferent = mismatch.first->frameBufferHash != mismatch.second->frameBufferHash;
+            result.message = std::string("the ") + (isScreenDifferent ? "screen" : "state") + " differs first at frame " +
+                             std::to_string(mismatch.first->frameNumber);
+        } else if (!recompileDirectory.empty()) {
+            result.message = compareRecompiledCase(goldenCase, recompileDirectory, deadline);
+            result.isPassed = result.message.empty();
+        } else {
+            result.isPassed = true;
+        }
+    } catch (const BaseException &e) {
+        result.message = std::string("exception: ") + e.what();
+    }
+    return result;
+}
+
+int main(int argc, char **argv) {
+    std::vector<std::string> args;
+    bool isUpdating = false;
+    bool areOptionsValid = true;
+    double timeLimitSeconds = DEFAULT_TIME_LIMIT_SECONDS;
+    std::string recompileDirectory;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == UPDATE_OPTION) {
+            isUpdating = true;
+        } else if (arg.compare(0, TIME_LIMIT_OPTION.size(), TIME_LIMIT_OPTION) == 0) {
+            areOptionsValid &=
+                OptionUtil::parseNumber(arg.substr(TIME_LIMIT_OPTION.size()), 0, HUGE_VAL, timeLimitSeconds) && timeLimitSeconds > 0;
+        } else if (arg.compare(0, RECOMPILE_OPTION.size(), RECOMPILE_OPTION) == 0) {
+            recompileDirectory = arg.substr(RECOMPILE_OPTION.size());
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (!areOptionsValid || args.size() != 1) {
+        std::cout << "Incorrect usage. Expected: golden_tests <corpus_file> [" << UPDATE_OPTION << "] [" << TIME_LIMIT_OPTION
+                  << "<seconds>] [" << RECOMPILE_OPTION << "<directory>]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<GoldenCase> cases;
+    try {
+        cases = parseCorpus(args[0]);
+    } catch (const BaseException &e) {
+        std::cout << "Exception Encountered: " << e.what() << std::endl;
+        return 1;
+    }
+    // every worker takes the next case that hasn't been taken yet, so a slow ROM doesn't hold up the others
+    std::vector<CaseResult> results(cases.size());
+    std::atomic<size_t> nextCaseIndex{0};
+    unsigned int numWorkers = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned int)cases.size()));
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < numWorkers; i++) {
+        workers.emplace_back([&] {
+            for (size_t caseIndex = nextCaseIndex++; caseIndex < cases.size(); caseIndex = nextCaseIndex++) {
+                results[caseIndex] = checkCase(cases[caseIndex], timeLimitSeconds, isUpdating, recompileDirectory);
+            }
+        });
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    size_t numFailed = 0;
+    for (size_t i = 0; i < cases.size(); i++) {
+        std::cout << (results[i].isPassed ? "[  PASSED  ] " : "[  FAILED  ] ") << cases[i].name << " (" << results[i].numSeconds << " s)";
+        if (!results[i].message.empty()) {
+            std::cout << ": " << results[i].message;
+        }
+        std::cout << std::endl;
+        numFailed += results[i].isPassed ? 0 : 1;
+    }
+    std::cout << cases.size() - numFailed << " of " << cases.size() << " ROMs match their golden frames" << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}
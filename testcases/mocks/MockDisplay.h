@@ -12,6 +12,11 @@ class MockDisplay : public Chip8::IDisplay {
     MOCK_METHOD3(setPixel, void(int x, int y, bool value));
     MOCK_METHOD2(getPixel, bool(int x, int y));
     MOCK_METHOD0(clearScreen, void());
+    MOCK_METHOD1(setHighResolution, void(bool isHighResolution));
+    MOCK_METHOD0(isHighResolution, bool());
+    MOCK_METHOD1(scrollDown, void(int numPixels));
+    MOCK_METHOD1(scrollRight, void(int numPixels));
+    MOCK_METHOD1(scrollLeft, void(int numPixels));
     MOCK_METHOD0(updateScreen, void());
 };
 